@@ -22,11 +22,13 @@ static_assert((CONFIG_BLUEPAD32_MAX_DEVICES == MAX_GAMEPADS), "Mismatch between
 namespace bluepad32 {
 
 static constexpr uint32_t FEEDBACK_TIME_MS = 250;
+static constexpr uint32_t FEEDBACK_MIN_INTERVAL_MS = 20; //Doorbell rate limit per controller
 static constexpr uint32_t LED_CHECK_TIME_MS = 500;
 
 struct BTDevice {
     bool connected{false};
     Gamepad* gamepad{nullptr};
+    uint32_t last_feedback_ms{0};
 };
 
 BTDevice bt_devices_[MAX_GAMEPADS];
@@ -35,6 +37,10 @@ btstack_timer_source_t led_timer_;
 bool led_timer_set_{false};
 bool feedback_timer_set_{false};
 
+//Rung by Gamepad::set_pad_out() from core0, serviced on the BTstack run loop
+btstack_data_source_t feedback_doorbell_;
+std::atomic<uint32_t> feedback_pending_{0};
+
 bool any_connected()
 {
     for (auto& device : bt_devices_)
@@ -111,6 +117,9 @@ static void send_feedback_cb(btstack_timer_source *ts)
 {
     uni_hid_device_t* bp_device = nullptr;
 
+    //Doorbells that were rate limited go out now, stops included
+    const uint32_t pending = feedback_pending_.exchange(0);
+
     for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
     {
         if (!bt_devices_[i].connected || 
@@ -120,9 +129,10 @@ static void send_feedback_cb(btstack_timer_source *ts)
         }
 
         Gamepad::PadOut gp_out = bt_devices_[i].gamepad->get_pad_out();
-        if (gp_out.rumble_l > 0 || gp_out.rumble_r > 0)
+        if (gp_out.rumble_l > 0 || gp_out.rumble_r > 0 || (pending & (1u << i)))
         {
             set_rumble(bp_device, static_cast<uint16_t>(FEEDBACK_TIME_MS), gp_out.rumble_l, gp_out.rumble_r);
+            bt_devices_[i].last_feedback_ms = btstack_run_loop_get_time_ms();
         }
     }
 
@@ -130,6 +140,45 @@ static void send_feedback_cb(btstack_timer_source *ts)
     btstack_run_loop_add_timer(ts);
 }
 
+//Safe from either core, the data source poll is scheduled on the BTstack async context
+static void ring_feedback_doorbell(uint8_t idx)
+{
+    feedback_pending_.fetch_or(1u << idx);
+    btstack_run_loop_poll_data_sources_from_irq();
+}
+
+static void feedback_doorbell_cb(btstack_data_source_t* ds, btstack_data_source_callback_type_t callback_type)
+{
+    uint32_t pending = feedback_pending_.exchange(0);
+    uint32_t deferred = 0;
+    uni_hid_device_t* bp_device = nullptr;
+    const uint32_t now_ms = btstack_run_loop_get_time_ms();
+
+    for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+    {
+        if (!(pending & (1u << i)) ||
+            !bt_devices_[i].connected || 
+            !(bp_device = uni_hid_device_get_instance_for_idx(i)))
+        {
+            continue;
+        }
+        //Too soon, send_feedback_cb() picks it up
+        if (now_ms - bt_devices_[i].last_feedback_ms < FEEDBACK_MIN_INTERVAL_MS)
+        {
+            deferred |= (1u << i);
+            continue;
+        }
+
+        Gamepad::PadOut gp_out = bt_devices_[i].gamepad->get_pad_out();
+        set_rumble(bp_device, static_cast<uint16_t>(FEEDBACK_TIME_MS), gp_out.rumble_l, gp_out.rumble_r);
+        bt_devices_[i].last_feedback_ms = now_ms;
+    }
+    if (deferred)
+    {
+        feedback_pending_.fetch_or(deferred);
+    }
+}
+
 static void check_led_cb(btstack_timer_source *ts)
 {
     static bool led_state = false;
@@ -251,58 +300,58 @@ static void controller_data_cb(uni_hid_device_t* device, uni_controller_t* contr
     switch (uni_gp->dpad) 
     {
         case DPAD_UP:
-            gp_in.dpad = gamepad->MAP_DPAD_UP;
+            gp_in.dpad = Gamepad::DPAD_UP;
             break;
         case DPAD_DOWN:
-            gp_in.dpad = gamepad->MAP_DPAD_DOWN;
+            gp_in.dpad = Gamepad::DPAD_DOWN;
             break;
         case DPAD_LEFT:
-            gp_in.dpad = gamepad->MAP_DPAD_LEFT;
+            gp_in.dpad = Gamepad::DPAD_LEFT;
             break;
         case DPAD_RIGHT:
-            gp_in.dpad = gamepad->MAP_DPAD_RIGHT;
+            gp_in.dpad = Gamepad::DPAD_RIGHT;
             break;
         case DPAD_UP | DPAD_RIGHT:
-            gp_in.dpad = gamepad->MAP_DPAD_UP_RIGHT;
+            gp_in.dpad = Gamepad::DPAD_UP_RIGHT;
             break;
         case DPAD_DOWN | DPAD_RIGHT:
-            gp_in.dpad = gamepad->MAP_DPAD_DOWN_RIGHT;
+            gp_in.dpad = Gamepad::DPAD_DOWN_RIGHT;
             break;
         case DPAD_DOWN | DPAD_LEFT:
-            gp_in.dpad = gamepad->MAP_DPAD_DOWN_LEFT;
+            gp_in.dpad = Gamepad::DPAD_DOWN_LEFT;
             break;
         case DPAD_UP | DPAD_LEFT:
-            gp_in.dpad = gamepad->MAP_DPAD_UP_LEFT;
+            gp_in.dpad = Gamepad::DPAD_UP_LEFT;
             break;
         default:
             break;
     }
 
     if (is_wii_controller_connected(idx)) {
-        if (uni_gp->buttons & BUTTON_A) gp_in.buttons |= gamepad->MAP_BUTTON_A;
-        if (uni_gp->buttons & BUTTON_B) gp_in.buttons |= gamepad->MAP_BUTTON_B;
-        if (uni_gp->buttons & BUTTON_X) gp_in.buttons |= gamepad->MAP_BUTTON_X;
-        if (uni_gp->buttons & BUTTON_Y) gp_in.buttons |= gamepad->MAP_BUTTON_Y;
-        if (uni_gp->buttons & BUTTON_SHOULDER_L) gp_in.buttons |= gamepad->MAP_BUTTON_LB;
-        if (uni_gp->buttons & BUTTON_SHOULDER_R) gp_in.buttons |= gamepad->MAP_BUTTON_RB;
-        //if (uni_gp->buttons & BUTTON_THUMB_L)    gp_in.buttons |= gamepad->MAP_BUTTON_L3;  
-        //if (uni_gp->buttons & BUTTON_THUMB_R)    gp_in.buttons |= gamepad->MAP_BUTTON_R3;
-        if (uni_gp->misc_buttons & MISC_BUTTON_BACK)    gp_in.buttons |= gamepad->MAP_BUTTON_BACK;
-        if (uni_gp->misc_buttons & MISC_BUTTON_START)   gp_in.buttons |= gamepad->MAP_BUTTON_START;
-        if (uni_gp->misc_buttons & MISC_BUTTON_SYSTEM)  gp_in.buttons |= gamepad->MAP_BUTTON_SYS;
+        if (uni_gp->buttons & BUTTON_A) gp_in.buttons |= Gamepad::BUTTON_A;
+        if (uni_gp->buttons & BUTTON_B) gp_in.buttons |= Gamepad::BUTTON_B;
+        if (uni_gp->buttons & BUTTON_X) gp_in.buttons |= Gamepad::BUTTON_X;
+        if (uni_gp->buttons & BUTTON_Y) gp_in.buttons |= Gamepad::BUTTON_Y;
+        if (uni_gp->buttons & BUTTON_SHOULDER_L) gp_in.buttons |= Gamepad::BUTTON_LB;
+        if (uni_gp->buttons & BUTTON_SHOULDER_R) gp_in.buttons |= Gamepad::BUTTON_RB;
+        //if (uni_gp->buttons & BUTTON_THUMB_L)    gp_in.buttons |= Gamepad::BUTTON_L3;  
+        //if (uni_gp->buttons & BUTTON_THUMB_R)    gp_in.buttons |= Gamepad::BUTTON_R3;
+        if (uni_gp->misc_buttons & MISC_BUTTON_BACK)    gp_in.buttons |= Gamepad::BUTTON_BACK;
+        if (uni_gp->misc_buttons & MISC_BUTTON_START)   gp_in.buttons |= Gamepad::BUTTON_START;
+        if (uni_gp->misc_buttons & MISC_BUTTON_SYSTEM)  gp_in.buttons |= Gamepad::BUTTON_SYS;
     }
     else {
-        if (uni_gp->buttons & BUTTON_A) gp_in.buttons |= gamepad->MAP_BUTTON_A;
-        if (uni_gp->buttons & BUTTON_B) gp_in.buttons |= gamepad->MAP_BUTTON_B;
-        if (uni_gp->buttons & BUTTON_X) gp_in.buttons |= gamepad->MAP_BUTTON_X;
-        if (uni_gp->buttons & BUTTON_Y) gp_in.buttons |= gamepad->MAP_BUTTON_Y;
-        if (uni_gp->buttons & BUTTON_SHOULDER_L) gp_in.buttons |= gamepad->MAP_BUTTON_LB;
-        if (uni_gp->buttons & BUTTON_SHOULDER_R) gp_in.buttons |= gamepad->MAP_BUTTON_RB;
-        if (uni_gp->buttons & BUTTON_THUMB_L)    gp_in.buttons |= gamepad->MAP_BUTTON_L3;  
-        if (uni_gp->buttons & BUTTON_THUMB_R)    gp_in.buttons |= gamepad->MAP_BUTTON_R3;
-        if (uni_gp->misc_buttons & MISC_BUTTON_BACK)    gp_in.buttons |= gamepad->MAP_BUTTON_BACK;
-        if (uni_gp->misc_buttons & MISC_BUTTON_START)   gp_in.buttons |= gamepad->MAP_BUTTON_START;
-        if (uni_gp->misc_buttons & MISC_BUTTON_SYSTEM)  gp_in.buttons |= gamepad->MAP_BUTTON_SYS; 
+        if (uni_gp->buttons & BUTTON_A) gp_in.buttons |= Gamepad::BUTTON_A;
+        if (uni_gp->buttons & BUTTON_B) gp_in.buttons |= Gamepad::BUTTON_B;
+        if (uni_gp->buttons & BUTTON_X) gp_in.buttons |= Gamepad::BUTTON_X;
+        if (uni_gp->buttons & BUTTON_Y) gp_in.buttons |= Gamepad::BUTTON_Y;
+        if (uni_gp->buttons & BUTTON_SHOULDER_L) gp_in.buttons |= Gamepad::BUTTON_LB;
+        if (uni_gp->buttons & BUTTON_SHOULDER_R) gp_in.buttons |= Gamepad::BUTTON_RB;
+        if (uni_gp->buttons & BUTTON_THUMB_L)    gp_in.buttons |= Gamepad::BUTTON_L3;  
+        if (uni_gp->buttons & BUTTON_THUMB_R)    gp_in.buttons |= Gamepad::BUTTON_R3;
+        if (uni_gp->misc_buttons & MISC_BUTTON_BACK)    gp_in.buttons |= Gamepad::BUTTON_BACK;
+        if (uni_gp->misc_buttons & MISC_BUTTON_START)   gp_in.buttons |= Gamepad::BUTTON_START;
+        if (uni_gp->misc_buttons & MISC_BUTTON_SYSTEM)  gp_in.buttons |= Gamepad::BUTTON_SYS; 
     }
 
     // Check for disconnect combo: Start+Select for most controllers, L3+R3 for OUYA (no Start/Select)
@@ -347,6 +396,9 @@ static void controller_data_cb(uni_hid_device_t* device, uni_controller_t* contr
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad->scale_joystick_l<10>(uni_gp->axis_x, uni_gp->axis_y);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad->scale_joystick_r<10>(uni_gp->axis_rx, uni_gp->axis_ry);
 
+    gp_in.dpad = gamepad->map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad->map_buttons(gp_in.buttons);
+
     gamepad->set_pad_in(gp_in);
 
 #if BLUEPAD32_UART_LOG_INPUT
@@ -386,11 +438,16 @@ void init(Gamepad(&gamepads)[MAX_GAMEPADS])
     for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
     {
         bt_devices_[i].gamepad = &gamepads[i];
+        bt_devices_[i].gamepad->set_pad_out_doorbell(ring_feedback_doorbell, i);
     }
 
     uni_platform_set_custom(get_driver());
     uni_init(0, nullptr);
 
+    btstack_run_loop_set_data_source_handler(&feedback_doorbell_, feedback_doorbell_cb);
+    btstack_run_loop_enable_data_source_callbacks(&feedback_doorbell_, DATA_SOURCE_CALLBACK_POLL);
+    btstack_run_loop_add_data_source(&feedback_doorbell_);
+
     led_timer_set_ = true;
     led_timer_.process = check_led_cb;
     led_timer_.context = nullptr;
@@ -14,6 +14,7 @@
 namespace board_api {
 
 mutex_t gpio_mutex_;
+void (*reboot_cb_)() = nullptr;
 
 bool usb::host_connected() {
     if (board_api_usbh::host_connected) {
@@ -57,10 +58,18 @@ void reboot() {
 
     OGXM_LOG("Rebooting\n");
 
+    if (reboot_cb_) {
+        reboot_cb_();
+    }
+
     AIRCR_REG = AIRCR_VECTKEY | AIRCR_SYSRESETREQ;
     while(1);
 }
 
+void set_reboot_cb(void (*reboot_cb)()) {
+    reboot_cb_ = reboot_cb;
+}
+
 uint32_t ms_since_boot() {
     return to_ms_since_boot(get_absolute_time());
 }
@@ -8,6 +8,8 @@ namespace board_api {
     void init_board();
     void init_bluetooth();
     void reboot();
+    //Called by reboot() right before the reset, on the core that called reboot()
+    void set_reboot_cb(void (*reboot_cb)());
     void set_led(bool state);
     uint32_t ms_since_boot();
 
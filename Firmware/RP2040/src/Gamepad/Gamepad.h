@@ -6,18 +6,32 @@
 #include <limits>
 #include <cstring>
 #include <array>
+#include <algorithm>
+#include <utility>
+#include <tuple>
+#include <type_traits>
 #include <cmath>
-#include <pico/mutex.h>
+#include <cstdlib>
+#include <bit>
+#include <hardware/timer.h>
 
 #include "libfixmath/fix16.hpp"
 
 #include "Gamepad/Range.h"
+#include "Gamepad/SeqLock.h"
+#include "Gamepad/LatencyHistogram.h"
 #include "Gamepad/fix16ext.h"
 #include "UserSettings/UserProfile.h"
 #include "UserSettings/JoystickSettings.h"
 #include "UserSettings/TriggerSettings.h"
 #include "Board/ogxm_log.h"
 
+#ifndef JOYSTICK_LUT_POOL_SIZE
+    //Both sticks of one gamepad plus one more table per extra gamepad, 
+    //sticks with the same settings share a table
+    #define JOYSTICK_LUT_POOL_SIZE (MAX_GAMEPADS + 1)
+#endif
+
 class Gamepad 
 {
 public:
@@ -125,19 +139,29 @@ public:
 
     using ChatpadIn = std::array<uint8_t, 3>;
 
+    struct PadInStats
+    {
+        uint32_t published;
+        uint32_t suppressed;
+    };
+
 #pragma pack(pop)
 
     Gamepad()
     {
-        mutex_init(&pad_in_mutex_);
-        mutex_init(&pad_out_mutex_);
-        mutex_init(&chatpad_in_mutex_);
+        build_mapping_tables();
+        build_trigger_lut(trig_lut_l_, trig_settings_l_, false);
+        build_trigger_lut(trig_lut_r_, trig_settings_r_, false);
         reset_pad_in();
         reset_pad_out();
         reset_chatpad_in();
     };
 
-    ~Gamepad() = default;
+    ~Gamepad()
+    {
+        JoystickLUTPool::release(joy_lut_l_);
+        JoystickLUTPool::release(joy_lut_r_);
+    }
 
     //Get
     inline bool new_pad_in() const { return new_pad_in_.load(); }
@@ -146,35 +170,40 @@ public:
     //True if both host and device have enabled analog
     inline bool analog_enabled() const { return analog_enabled_.load(std::memory_order_relaxed); }
 
+    //Flag is cleared before reading, a store landing in between just flags the next read as new
     inline PadIn get_pad_in()
     {
-        mutex_enter_blocking(&pad_in_mutex_);
-        PadIn pad_in = pad_in_;
         new_pad_in_.store(false);
-        mutex_exit(&pad_in_mutex_);
-
-        return pad_in;
+        const StampedPadIn stamped = pad_in_.load();
+        pad_in_capture_us_ = stamped.capture_us;
+        return stamped.pad_in;
     }
 
     inline PadOut get_pad_out()
     {
-        mutex_enter_blocking(&pad_out_mutex_);
-        PadOut pad_out = pad_out_;
         new_pad_out_.store(false);
-        mutex_exit(&pad_out_mutex_);
-
-        return pad_out;
+        return pad_out_.load();
     }
 
     inline ChatpadIn get_chatpad_in()
     {
-        mutex_enter_blocking(&chatpad_in_mutex_);
-        ChatpadIn chatpad_in = chatpad_in_;
-        mutex_exit(&chatpad_in_mutex_);
+        return chatpad_in_.load();
+    }
+
+    //For checks outside the device driver, leaves new_pad_in() and latency tracking alone
+    inline PadIn peek_pad_in() const
+    {
+        return pad_in_.load().pad_in;
+    }
 
-        return chatpad_in;
+    inline PadInStats get_pad_in_stats() const
+    {
+        return { pad_in_published_.load(std::memory_order_relaxed), pad_in_suppressed_.load(std::memory_order_relaxed) };
     }
 
+    //Capture to submit latency of reports sent by the device driver
+    inline const LatencyHistogram& get_latency() const { return latency_; }
+
     //Set
 
     void set_analog_device(bool value) 
@@ -201,27 +230,67 @@ public:
         set_profile_settings(user_profile);
     }
 
-    inline void set_pad_in(PadIn pad_in)
+    //Safe to call from IRQ context, reports identical to the current one are dropped
+    //so new_pad_in() only fires on a real state change
+    inline void set_pad_in(const PadIn& pad_in)
     {
-        mutex_enter_blocking(&pad_in_mutex_);
-        pad_in_ = pad_in;
+        const StampedPadIn stamped{ pad_in, time_us_64(), fingerprint(pad_in) };
+        if (!pad_in_.store_if(stamped, 
+            [](const StampedPadIn& current, const StampedPadIn& next) 
+            { 
+                return current.fingerprint != next.fingerprint; 
+            }))
+        {
+            pad_in_suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pad_in_published_.fetch_add(1, std::memory_order_relaxed);
         new_pad_in_.store(true);
-        mutex_exit(&pad_in_mutex_);
     }
 
-    inline void set_pad_out(const PadOut& pad_out)
+    //Rings the pad out doorbell if the rumble state changed, ring_doorbell = false leaves it
+    //for the host's periodic feedback pass (used by host drivers adjusting their own output)
+    inline void set_pad_out(const PadOut& pad_out, bool ring_doorbell = true)
     {
-        mutex_enter_blocking(&pad_out_mutex_);
-        pad_out_ = pad_out;
+        //Compared under the writer lock, a separate load could miss a change another core made in between
+        const bool changed = pad_out_.store_if(pad_out, 
+            [](const PadOut& current, const PadOut& next) 
+            { 
+                return std::memcmp(&current, &next, sizeof(PadOut)) != 0; 
+            });
         new_pad_out_.store(true);
-        mutex_exit(&pad_out_mutex_);
+
+        const PadOutDoorbell doorbell = pad_out_doorbell_.load(std::memory_order_acquire);
+        if (ring_doorbell && changed && doorbell)
+        {
+            doorbell(pad_out_doorbell_id_);
+        }
+    }
+
+    //Lets the host side forward rumble as soon as it's set instead of on its next poll,
+    //doorbell must be safe to call from either core.
+    using PadOutDoorbell = void (*)(uint8_t doorbell_id);
+
+    inline void set_pad_out_doorbell(PadOutDoorbell doorbell, uint8_t doorbell_id)
+    {
+        pad_out_doorbell_id_ = doorbell_id;
+        pad_out_doorbell_.store(doorbell, std::memory_order_release);
     }
 
     inline void set_chatpad_in(const ChatpadIn& chatpad_in)
     {
-        mutex_enter_blocking(&chatpad_in_mutex_);
-        chatpad_in_ = chatpad_in;
-        mutex_exit(&chatpad_in_mutex_);
+        chatpad_in_.store(chatpad_in);
+    }
+
+    //Host drivers fill buttons/dpad with the default BUTTON_*/DPAD_* bits, these apply the profile mapping
+    inline uint16_t map_buttons(uint16_t buttons) const
+    {
+        return button_map_lo_[buttons & 0xFF] | button_map_hi_[buttons >> 8];
+    }
+
+    inline uint8_t map_dpad(uint8_t dpad) const
+    {
+        return dpad_map_[dpad & 0x0F];
     }
 
     // Wii U GC adapter: set by host when controller uses positive Y for physical up (e.g. Xbox One/360)
@@ -230,25 +299,36 @@ public:
 
     inline void reset_pad_in() 
 	{ 
-        mutex_enter_blocking(&pad_in_mutex_);
-        pad_in_ = PadIn();
-        mutex_exit(&pad_in_mutex_);
+        pad_in_.store(StampedPadIn{ PadIn(), 0, fingerprint(PadIn()) });
         new_pad_in_.store(true);
     }
     
     inline void reset_pad_out()
     {
-        mutex_enter_blocking(&pad_out_mutex_);
-        pad_out_ = PadOut();
+        pad_out_.store(PadOut());
         new_pad_out_.store(true);
-        mutex_exit(&pad_out_mutex_);
     }
 
     inline void reset_chatpad_in()
     {
-        mutex_enter_blocking(&chatpad_in_mutex_);
-        chatpad_in_.fill(0);
-        mutex_exit(&chatpad_in_mutex_);
+        chatpad_in_.store(ChatpadIn{0});
+    }
+
+    //Device drivers call this once the IN report built from the last get_pad_in() was handed to TinyUSB,
+    //a capture is only counted the first time it's sent
+    inline void record_latency()
+    {
+        if (pad_in_capture_us_ == 0 || pad_in_capture_us_ == recorded_capture_us_)
+        {
+            return;
+        }
+        latency_.record(time_us_64() - pad_in_capture_us_);
+        recorded_capture_us_ = pad_in_capture_us_;
+    }
+
+    inline void reset_latency()
+    {
+        latency_.reset();
     }
 
     template <uint8_t bits = 0, typename T>
@@ -272,9 +352,13 @@ public:
             joy_y = y;
         }
 
-        return  joy_settings_r_en_ 
-                    ? apply_joystick_settings(joy_x, joy_y, joy_settings_r_, invert_y) 
-                    : std::make_pair(joy_x, invert_y ? Range::invert(joy_y) : joy_y);
+        if (!joy_settings_r_en_)
+        {
+            return std::make_pair(joy_x, invert_y ? Range::invert(joy_y) : joy_y);
+        }
+        return  joy_lut_r_ 
+                    ? joy_lut_r_->lookup(joy_x, joy_y, joy_settings_r_, invert_y) 
+                    : apply_joystick_settings(joy_x, joy_y, joy_settings_r_, invert_y);
     }
 
     template <uint8_t bits = 0, typename T>
@@ -298,9 +382,13 @@ public:
             joy_y = y;
         }
 
-        return  joy_settings_l_en_ 
-                    ? apply_joystick_settings(joy_x, joy_y, joy_settings_l_, invert_y) 
-                    : std::make_pair(joy_x, invert_y ? Range::invert(joy_y) : joy_y);
+        if (!joy_settings_l_en_)
+        {
+            return std::make_pair(joy_x, invert_y ? Range::invert(joy_y) : joy_y);
+        }
+        return  joy_lut_l_ 
+                    ? joy_lut_l_->lookup(joy_x, joy_y, joy_settings_l_, invert_y) 
+                    : apply_joystick_settings(joy_x, joy_y, joy_settings_l_, invert_y);
     }
 
     template <uint8_t bits = 0, typename T>
@@ -319,9 +407,7 @@ public:
         {
             trigger_value = value;
         }
-        return  trig_settings_l_en_ 
-                    ? apply_trigger_settings(trigger_value, trig_settings_l_) 
-                    : trigger_value;
+        return trig_lut_l_[trigger_value];
     }
 
     template <uint8_t bits = 0, typename T>
@@ -340,22 +426,231 @@ public:
         {
             trigger_value = value;
         }
-        return  trig_settings_r_en_ 
-                    ? apply_trigger_settings(trigger_value, trig_settings_r_) 
-                    : trigger_value;
+        return trig_lut_r_[trigger_value];
     }
 
 private:    
-    mutex_t pad_in_mutex_;
-    mutex_t pad_out_mutex_;
-    mutex_t chatpad_in_mutex_;
+#if defined(OGXM_HOST_TEST)
+    //Host tests check the tables against the functions they're built from
+    friend struct GamepadTestAccess;
+#endif
+
+    //Joystick response sampled over one quadrant when the profile is loaded, 
+    //the output magnitude only depends on abs(x) and abs(y) so signs are reapplied per report.
+    //Lookup is a bilinear interpolation between the 4 nearest samples.
+    struct JoystickLUT
+    {
+        static constexpr uint8_t CELL_BITS = 10;
+        static constexpr int32_t CELL_SIZE = 1 << CELL_BITS;
+        static constexpr uint8_t GRID_SIZE = (Range::MAX<int16_t> >> CELL_BITS) + 2;
+        //apply_joystick_settings zeroes X within EPSILON (0.0001) of the Y axis and Y only when exactly on the X axis,
+        //the first row/column is sampled just off the axis and those cases are handled in lookup()
+        static constexpr int32_t AXIS_MIN_X = 4;
+        static constexpr int32_t AXIS_MIN_Y = 1;
+
+        struct Sample
+        {
+            int16_t x;
+            int16_t y;
+        };
+
+        Sample samples[GRID_SIZE][GRID_SIZE];
+        //Inner deadzone is checked exactly instead of interpolated, only when axis restriction is off
+        uint32_t dz_inner_sq{0};
+
+        void build(const JoystickSettings& set)
+        {
+            int32_t dz_edge = 0;
+            if (set.axis_restrict == Fix16(0.0f))
+            {
+                //Fix16 rounding puts the effective edge slightly past dz_inner, find where output starts
+                dz_edge = fix16_to_int(set.dz_inner * Range::MAX<int16_t>);
+                while ( dz_edge < Range::MAX<int16_t> && 
+                        apply_joystick_settings(static_cast<int16_t>(dz_edge), 0, set, false).first == 0)
+                {
+                    ++dz_edge;
+                }
+            }
+            dz_inner_sq = static_cast<uint32_t>(dz_edge * dz_edge);
+
+            for (uint8_t iy = 0; iy < GRID_SIZE; ++iy)
+            {
+                for (uint8_t ix = 0; ix < GRID_SIZE; ++ix)
+                {
+                    float in_x = static_cast<float>(sample_pos(ix, AXIS_MIN_X));
+                    float in_y = static_cast<float>(sample_pos(iy, AXIS_MIN_Y));
+
+                    //Samples inside the deadzone are never returned since lookup() checks it first,
+                    //sample the deadzone edge instead so cells straddling it don't blend toward zero
+                    const float radius = std::sqrt(in_x * in_x + in_y * in_y);
+                    if (radius < static_cast<float>(dz_edge))
+                    {
+                        in_x = in_x * static_cast<float>(dz_edge) / radius;
+                        in_y = in_y * static_cast<float>(dz_edge) / radius;
+                    }
+
+                    auto [out_x, out_y] = apply_joystick_settings(  static_cast<int16_t>(std::lround(in_x)), 
+                                                                    static_cast<int16_t>(std::lround(in_y)), 
+                                                                    set, false);
+
+                    samples[iy][ix].x = static_cast<int16_t>(std::abs(out_x));
+                    samples[iy][ix].y = static_cast<int16_t>(std::abs(out_y));
+                }
+            }
+        }
 
-    PadOut pad_out_;
-    PadIn pad_in_;
-    ChatpadIn chatpad_in_{0};
+        inline std::pair<int16_t, int16_t> lookup(int16_t joy_x, int16_t joy_y, const JoystickSettings& set, bool invert_y) const
+        {
+            const int16_t x = set.invert_x ? Range::invert(joy_x) : joy_x;
+            const int16_t y = (set.invert_y ^ invert_y) ? Range::invert(joy_y) : joy_y;
+
+            const int32_t abs_x = std::min(std::abs(static_cast<int32_t>(x)), static_cast<int32_t>(Range::MAX<int16_t>));
+            const int32_t abs_y = std::min(std::abs(static_cast<int32_t>(y)), static_cast<int32_t>(Range::MAX<int16_t>));
+
+            if (static_cast<uint32_t>(abs_x * abs_x) + static_cast<uint32_t>(abs_y * abs_y) < dz_inner_sq)
+            {
+                return { 0, 0 };
+            }
+
+            const int32_t ix = abs_x >> CELL_BITS;
+            const int32_t iy = abs_y >> CELL_BITS;
+            const int32_t fx = cell_frac(abs_x, ix, AXIS_MIN_X);
+            const int32_t fy = cell_frac(abs_y, iy, AXIS_MIN_Y);
+
+            const Sample& s00 = samples[iy][ix];
+            const Sample& s01 = samples[iy][ix + 1];
+            const Sample& s10 = samples[iy + 1][ix];
+            const Sample& s11 = samples[iy + 1][ix + 1];
+
+            int32_t out_x = (abs_x < AXIS_MIN_X) ? 0 : lerp(lerp(s00.x, s01.x, fx), lerp(s10.x, s11.x, fx), fy);
+            int32_t out_y = (abs_y < AXIS_MIN_Y) ? 0 : lerp(lerp(s00.y, s01.y, fx), lerp(s10.y, s11.y, fx), fy);
+
+            return {    static_cast<int16_t>((x < 0) ? -out_x : out_x), 
+                        static_cast<int16_t>((y < 0) ? -out_y : out_y) };
+        }
+
+        static inline int32_t sample_pos(int32_t idx, int32_t axis_min)
+        {
+            return (idx == 0) ? axis_min : std::min(idx * CELL_SIZE, static_cast<int32_t>(Range::MAX<int16_t>));
+        }
+
+        //Position within the cell scaled to 0 - CELL_SIZE, the first cell starts at axis_min
+        static inline int32_t cell_frac(int32_t value, int32_t idx, int32_t axis_min)
+        {
+            if (idx == 0)
+            {
+                return (value <= axis_min) ? 0 : ((value - axis_min) << CELL_BITS) / (CELL_SIZE - axis_min);
+            }
+            return value & (CELL_SIZE - 1);
+        }
+
+        static inline int32_t lerp(int32_t a, int32_t b, int32_t frac)
+        {
+            return a + (((b - a) * frac) >> CELL_BITS);
+        }
+    };
+
+    //Tables are ~4.3 KB each so they live in a static pool shared by every Gamepad instead of the heap.
+    //Profiles are only loaded from core0 during init, the pool isn't locked.
+    struct JoystickLUTPool
+    {
+        struct Entry
+        {
+            JoystickSettingsRaw key;
+            uint8_t refs;
+            JoystickLUT lut;
+        };
+
+        static Entry entries[JOYSTICK_LUT_POOL_SIZE];
+
+        //Returns nullptr if every table is in use with other settings
+        static const JoystickLUT* acquire(const JoystickSettingsRaw& raw, const JoystickSettings& set)
+        {
+            //Inversion is applied to the input before the lookup, it doesn't change the table
+            JoystickSettingsRaw key = raw;
+            key.invert_x = 0;
+            key.invert_y = 0;
+
+            Entry* free_entry = nullptr;
+            for (auto& entry : entries)
+            {
+                if (entry.refs == 0)
+                {
+                    free_entry = free_entry ? free_entry : &entry;
+                }
+                else if (std::memcmp(&entry.key, &key, sizeof(key)) == 0)
+                {
+                    ++entry.refs;
+                    return &entry.lut;
+                }
+            }
+            if (!free_entry)
+            {
+                return nullptr;
+            }
+
+            JoystickSettings build_set = set;
+            build_set.invert_x = false;
+            build_set.invert_y = false;
+
+            free_entry->key = key;
+            free_entry->refs = 1;
+            free_entry->lut.build(build_set);
+            return &free_entry->lut;
+        }
+
+        static void release(const JoystickLUT* lut)
+        {
+            for (auto& entry : entries)
+            {
+                if (lut == &entry.lut)
+                {
+                    --entry.refs;
+                    return;
+                }
+            }
+        }
+    };
+
+    SeqLock<PadOut> pad_out_;
+    //Timestamp is kept out of PadIn, its layout is shared over I2C and BLE
+    struct StampedPadIn
+    {
+        PadIn pad_in;
+        uint64_t capture_us;
+        uint64_t fingerprint;
+    };
+
+    //XOR/rotate/multiply over the packed struct, a change in any single 8 byte lane always changes the result
+    static inline uint64_t fingerprint(const PadIn& pad_in)
+    {
+        static_assert(sizeof(PadIn) <= 4 * sizeof(uint64_t), "Gamepad::fingerprint: PadIn too large");
+
+        std::array<uint64_t, 4> lanes{0};
+        std::memcpy(lanes.data(), &pad_in, sizeof(PadIn));
+
+        uint64_t hash = 0;
+        for (const uint64_t lane : lanes)
+        {
+            hash = (std::rotl(hash, 23) ^ lane) * 0x9E3779B97F4A7C15ULL;
+        }
+        return hash;
+    }
+
+    SeqLock<StampedPadIn> pad_in_;
+    SeqLock<ChatpadIn> chatpad_in_;
 
     std::atomic<bool> new_pad_in_{false};
+    std::atomic<uint32_t> pad_in_published_{0};
+    std::atomic<uint32_t> pad_in_suppressed_{0};
+
+    //Device driver side only
+    uint64_t pad_in_capture_us_{0};
+    uint64_t recorded_capture_us_{0};
+    LatencyHistogram latency_;
     std::atomic<bool> new_pad_out_{false};
+    std::atomic<PadOutDoorbell> pad_out_doorbell_{nullptr};
+    uint8_t pad_out_doorbell_id_{0};
 
     std::atomic<bool> analog_enabled_{false};
     std::atomic<bool> analog_host_{false};
@@ -370,6 +665,20 @@ private:
     TriggerSettings trig_settings_l_;
     TriggerSettings trig_settings_r_;
 
+    //nullptr if the pool ran out, the stick then uses apply_joystick_settings directly
+    const JoystickLUT* joy_lut_l_{nullptr};
+    const JoystickLUT* joy_lut_r_{nullptr};
+
+    //Mapped mask for every combination of the low/high byte of a default button mask, and of the 4 dpad bits
+    std::array<uint16_t, 256> button_map_lo_;
+    std::array<uint16_t, 256> button_map_hi_;
+    std::array<uint8_t, 16> dpad_map_;
+
+    //Trigger response for every input value, identity when settings are disabled
+    using TriggerLUT = std::array<uint8_t, Range::MAX<uint8_t> + 1>;
+    TriggerLUT trig_lut_l_;
+    TriggerLUT trig_lut_r_;
+
     bool joy_settings_l_en_{false};
     bool joy_settings_r_en_{false};
     bool trig_settings_l_en_{false};
@@ -380,6 +689,16 @@ private:
         profile_analog_enabled_ = profile.analog_enabled ? true : false;
         OGXM_LOG("profile_analog_enabled_: %d\n", profile_analog_enabled_);
 
+        JoystickLUTPool::release(joy_lut_l_);
+        JoystickLUTPool::release(joy_lut_r_);
+        joy_lut_l_ = nullptr;
+        joy_lut_r_ = nullptr;
+        //Settings are enabled when they differ from the defaults, not from a previous profile
+        joy_settings_l_ = JoystickSettings();
+        joy_settings_r_ = JoystickSettings();
+        trig_settings_l_ = TriggerSettings();
+        trig_settings_r_ = TriggerSettings();
+
         if ((joy_settings_l_en_ = !joy_settings_l_.is_same(profile.joystick_settings_l)))
         {
             joy_settings_l_.set_from_raw(profile.joystick_settings_l);
@@ -387,6 +706,11 @@ private:
             joy_settings_l_.axis_restrict *= static_cast<int16_t>(100);
             joy_settings_l_.angle_restrict *= static_cast<int16_t>(100);
             joy_settings_l_.anti_dz_angular *= static_cast<int16_t>(100);
+
+            if (!(joy_lut_l_ = JoystickLUTPool::acquire(profile.joystick_settings_l, joy_settings_l_)))
+            {
+                OGXM_LOG("Gamepad: Joystick table pool full, left stick uses direct response\n");
+            }
         }
         if ((joy_settings_r_en_ = !joy_settings_r_.is_same(profile.joystick_settings_r)))
         {
@@ -395,6 +719,11 @@ private:
             joy_settings_r_.axis_restrict *= static_cast<int16_t>(100);
             joy_settings_r_.angle_restrict *= static_cast<int16_t>(100);
             joy_settings_r_.anti_dz_angular *= static_cast<int16_t>(100);
+
+            if (!(joy_lut_r_ = JoystickLUTPool::acquire(profile.joystick_settings_r, joy_settings_r_)))
+            {
+                OGXM_LOG("Gamepad: Joystick table pool full, right stick uses direct response\n");
+            }
         }
         if ((trig_settings_l_en_ = !trig_settings_l_.is_same(profile.trigger_settings_l)))
         {
@@ -404,6 +733,8 @@ private:
         {
             trig_settings_r_.set_from_raw(profile.trigger_settings_r);
         }
+        build_trigger_lut(trig_lut_l_, trig_settings_l_, trig_settings_l_en_);
+        build_trigger_lut(trig_lut_r_, trig_settings_r_, trig_settings_r_en_);
 
         OGXM_LOG("GamepadMapper: JoyL: %s, JoyR: %s, TrigL: %s, TrigR: %s\n",
             joy_settings_l_en_ ? "Enabled" : "Disabled",
@@ -447,6 +778,51 @@ private:
         MAP_ANALOG_OFF_Y     = profile.analog_off_y;
         MAP_ANALOG_OFF_LB    = profile.analog_off_lb;
         MAP_ANALOG_OFF_RB    = profile.analog_off_rb;
+
+        build_mapping_tables();
+    }
+
+    void build_mapping_tables()
+    {
+        const uint16_t button_maps[16] = 
+        {
+            MAP_BUTTON_A, MAP_BUTTON_B, MAP_BUTTON_X, MAP_BUTTON_Y, 
+            MAP_BUTTON_L3, MAP_BUTTON_R3, MAP_BUTTON_BACK, MAP_BUTTON_START,
+            MAP_BUTTON_LB, MAP_BUTTON_RB, MAP_BUTTON_SYS, MAP_BUTTON_MISC,
+            0, 0, 0, 0
+        };
+        static_assert(  BUTTON_A == (1 << 0) && BUTTON_START == (1 << 7) && 
+                        BUTTON_LB == (1 << 8) && BUTTON_MISC == (1 << 11), "Button bits don't match mapping table order");
+
+        for (size_t i = 0; i < button_map_lo_.size(); ++i)
+        {
+            button_map_lo_[i] = 0;
+            button_map_hi_[i] = 0;
+            for (uint8_t bit = 0; bit < 8; ++bit)
+            {
+                if (i & (1 << bit))
+                {
+                    button_map_lo_[i] |= button_maps[bit];
+                    button_map_hi_[i] |= button_maps[bit + 8];
+                }
+            }
+        }
+
+        const uint8_t dpad_maps[4] = { MAP_DPAD_UP, MAP_DPAD_DOWN, MAP_DPAD_LEFT, MAP_DPAD_RIGHT };
+        static_assert(  DPAD_UP == (1 << 0) && DPAD_DOWN == (1 << 1) && 
+                        DPAD_LEFT == (1 << 2) && DPAD_RIGHT == (1 << 3), "Dpad bits don't match mapping table order");
+
+        for (size_t i = 0; i < dpad_map_.size(); ++i)
+        {
+            dpad_map_[i] = 0;
+            for (uint8_t bit = 0; bit < 4; ++bit)
+            {
+                if (i & (1 << bit))
+                {
+                    dpad_map_[i] |= dpad_maps[bit];
+                }
+            }
+        }
     }
 
     static inline std::pair<int16_t, int16_t> apply_joystick_settings(
@@ -608,6 +984,15 @@ private:
         return { static_cast<int16_t>(fix16_to_int(output_x)), static_cast<int16_t>(fix16_to_int(output_y)) };
     }
 
+    void build_trigger_lut(TriggerLUT& lut, const TriggerSettings& set, bool enabled) const
+    {
+        for (size_t i = 0; i < lut.size(); ++i)
+        {
+            const uint8_t value = static_cast<uint8_t>(i);
+            lut[i] = enabled ? apply_trigger_settings(value, set) : value;
+        }
+    }
+
     uint8_t apply_trigger_settings(uint8_t value, const TriggerSettings& set) const
     {
         Fix16 abs_value = fix16::abs(Fix16(static_cast<int16_t>(value)) / static_cast<int16_t>(Range::MAX<uint8_t>));
@@ -643,4 +1028,6 @@ private:
     }
 };
 
+inline Gamepad::JoystickLUTPool::Entry Gamepad::JoystickLUTPool::entries[JOYSTICK_LUT_POOL_SIZE]{};
+
 #endif // _GAMEPAD_H_
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef _LATENCY_HISTOGRAM_H_
+#define _LATENCY_HISTOGRAM_H_
+
+#include <cstdint>
+#include <array>
+
+//Log2 binned microsecond histogram, bin N counts samples in [2^N, 2^(N+1)) us,
+//bin 0 also takes 0us and the last bin takes everything above its lower bound.
+//Not synchronized, only touched from the core running the device driver.
+struct LatencyHistogram
+{
+    static constexpr uint8_t NUM_BINS = 16;
+
+    std::array<uint32_t, NUM_BINS> bins{0};
+    uint32_t count{0};
+    uint32_t max_us{0};
+    uint64_t total_us{0};
+
+    inline void record(uint64_t delta_us)
+    {
+        const uint32_t us = (delta_us > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(delta_us);
+        const uint32_t bin = 31 - __builtin_clz(us | 1);
+
+        ++bins[(bin < NUM_BINS) ? bin : NUM_BINS - 1];
+        ++count;
+        total_us += us;
+        if (us > max_us)
+        {
+            max_us = us;
+        }
+    }
+
+    inline void reset()
+    {
+        *this = LatencyHistogram();
+    }
+};
+static_assert(sizeof(LatencyHistogram) == 80, "LatencyHistogram size mismatch");
+
+#endif // _LATENCY_HISTOGRAM_H_
@@ -4,7 +4,6 @@
 #include <cstdint>
 #include <limits>
 #include <type_traits>
-#include "Board/ogxm_log.h"
 
 namespace Range {
 
@@ -0,0 +1,85 @@
+#ifndef _SEQ_LOCK_H_
+#define _SEQ_LOCK_H_
+
+#include <cstdint>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <hardware/sync.h>
+
+//Single value shared between cores and IRQ handlers.
+//Readers never take a lock, they retry if a store was in progress while copying.
+//Stores hold a striped hardware spinlock with IRQs off for the length of one copy,
+//so multiple writers (e.g. both cores, or an I2C IRQ) are serialized and it's safe to store from an IRQ.
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock: T must be trivially copyable");
+
+public:
+    SeqLock()
+        : spinlock_(spin_lock_instance(next_striped_spin_lock_num())) {}
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    inline void store(const T& value)
+    {
+        uint32_t irq_state = spin_lock_blocking(spinlock_);
+        store_locked(value);
+        spin_unlock(spinlock_, irq_state);
+    }
+
+    //Stores only if should_store(current, value) returns true, checked under the writer lock
+    //so the comparison can't race another writer. Returns true if the value was stored.
+    template <typename Pred>
+    inline bool store_if(const T& value, Pred&& should_store)
+    {
+        uint32_t irq_state = spin_lock_blocking(spinlock_);
+        const bool stored = should_store(value_, value);
+        if (stored)
+        {
+            store_locked(value);
+        }
+        spin_unlock(spinlock_, irq_state);
+        return stored;
+    }
+
+    inline T load() const
+    {
+        T value;
+        uint32_t seq_start = 0;
+        uint32_t seq_end = 0;
+        do
+        {
+            seq_start = seq_.load(std::memory_order_acquire);
+            std::memcpy(&value, &value_, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq_end = seq_.load(std::memory_order_relaxed);
+        }
+        while ((seq_start & 1) || (seq_start != seq_end));
+
+        return value;
+    }
+
+private:
+    spin_lock_t* spinlock_;
+    std::atomic<uint32_t> seq_{0};
+    T value_{};
+
+    inline void store_locked(const T& value)
+    {
+        const uint32_t seq = seq_.load(std::memory_order_relaxed);
+
+        //Odd sequence marks a store in progress
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::memcpy(&value_, &value, sizeof(T));
+
+        std::atomic_thread_fence(std::memory_order_release);
+        seq_.store(seq + 2, std::memory_order_relaxed);
+    }
+};
+
+#endif // _SEQ_LOCK_H_
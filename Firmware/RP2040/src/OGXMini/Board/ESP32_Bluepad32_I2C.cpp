@@ -12,6 +12,7 @@
 #include "bsp/board_api.h"
 
 #include "USBDevice/DeviceManager.h"
+#include "USBDevice/sof_sync.h"
 #include "UserSettings/UserSettings.h"
 #include "Board/board_api.h"
 #include "Board/esp32_api.h"
@@ -189,7 +190,7 @@ void esp32_bp32_i2c::run() {
             device_driver->process(i, _gamepads[i]);
             tud_task();
         }
-        sleep_ms(1);
+        sof_sync::wait_for_next_poll();
     }
 }
 
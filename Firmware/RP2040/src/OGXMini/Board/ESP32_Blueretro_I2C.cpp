@@ -11,6 +11,7 @@
 
 #include "UserSettings/UserSettings.h"
 #include "USBDevice/DeviceManager.h"
+#include "USBDevice/sof_sync.h"
 #include "Board/board_api.h"
 #include "Board/esp32_api.h"
 #include "Gamepad/Gamepad.h"
@@ -188,7 +189,7 @@ void esp32_br_i2c::run() {
         TaskQueue::Core0::process_tasks();
         device_driver->process(0, _gamepads[0]);
         tud_task();
-        sleep_ms(1);
+        sof_sync::wait_for_next_poll();
     }
 }
 
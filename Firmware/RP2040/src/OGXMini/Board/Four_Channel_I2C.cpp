@@ -14,6 +14,7 @@
 #include "pio_usb.h"
 
 #include "USBDevice/DeviceManager.h"
+#include "USBDevice/sof_sync.h"
 #include "USBHost/HostManager.h"
 #include "Board/board_api.h"
 #include "Board/ogxm_log.h"
@@ -361,6 +362,7 @@ void core1_task() {
 
     while (true) {
         TaskQueue::Core1::process_tasks();
+        host_manager.process_feedback();
         tuh_task();
     }
 }
@@ -447,14 +449,14 @@ void four_ch_i2c::run() {
             I2C::Master::process();
             device_driver->process(0, _gamepads[0]);
             tud_task();
-            sleep_ms(1);
+            sof_sync::wait_for_next_poll();
         }
     } else {
         while (true) {
             TaskQueue::Core0::process_tasks();
             device_driver->process(0, _gamepads[0]);
             tud_task();
-            sleep_ms(1);
+            sof_sync::wait_for_next_poll();
         }
     }
 }
@@ -9,6 +9,7 @@
 #include "bsp/board_api.h"
 
 #include "USBDevice/DeviceManager.h"
+#include "USBDevice/sof_sync.h"
 #include "UserSettings/UserSettings.h"
 #include "Board/board_api.h"
 #include "Bluepad32/Bluepad32.h"
@@ -69,7 +70,7 @@ void pico_w::run() {
             device_driver->process(i, _gamepads[i]);
             tud_task();
         }
-        sleep_ms(1);
+        sof_sync::wait_for_next_poll();
     }
 }
 
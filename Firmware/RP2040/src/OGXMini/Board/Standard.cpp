@@ -10,6 +10,7 @@
 
 #include "USBHost/HostManager.h"
 #include "USBDevice/DeviceManager.h"
+#include "USBDevice/sof_sync.h"
 #include "TaskQueue/TaskQueue.h"
 #include "Gamepad/Gamepad.h"
 #include "Board/board_api.h"
@@ -42,6 +43,7 @@ void core1_task() {
 
     while (true) {
         TaskQueue::Core1::process_tasks();
+        host_manager.process_feedback();
         tuh_task();
     }
 }
@@ -121,7 +123,7 @@ void standard::run() {
             device_driver->process(i, _gamepads[i]);
         }
         tud_task();
-        sleep_ms(1);
+        sof_sync::wait_for_next_poll();
     }
 }
 
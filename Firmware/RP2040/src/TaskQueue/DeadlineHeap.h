@@ -0,0 +1,146 @@
+#ifndef _DEADLINE_HEAP_H_
+#define _DEADLINE_HEAP_H_
+
+#include <cstdint>
+#include <array>
+#include <utility>
+
+//Indexed binary min-heap of 64-bit deadlines keyed by slot index (0 to Capacity - 1).
+//push/remove/update are O(log n), the earliest deadline is always at the top.
+//Not synchronized, callers hold the delayed task spinlock.
+template <uint8_t Capacity>
+class DeadlineHeap
+{
+    static_assert(Capacity > 0 && Capacity <= 127, "DeadlineHeap: invalid capacity");
+
+public:
+    static constexpr uint8_t NPOS = 0xFF;
+
+    DeadlineHeap()
+    {
+        positions_.fill(NPOS);
+    }
+
+    inline bool empty() const { return size_ == 0; }
+    inline uint8_t size() const { return size_; }
+    inline bool contains(uint8_t slot) const { return positions_[slot] != NPOS; }
+
+    inline uint8_t top_slot() const { return entries_[0].slot; }
+    inline uint64_t top_deadline() const { return entries_[0].deadline; }
+
+    inline void push(uint8_t slot, uint64_t deadline)
+    {
+        entries_[size_] = { deadline, slot };
+        positions_[slot] = size_;
+        sift_up(size_++);
+    }
+
+    inline void remove(uint8_t slot)
+    {
+        const uint8_t pos = positions_[slot];
+        if (pos == NPOS)
+        {
+            return;
+        }
+        positions_[slot] = NPOS;
+        if (pos == --size_)
+        {
+            return;
+        }
+        entries_[pos] = entries_[size_];
+        positions_[entries_[pos].slot] = pos;
+        restore(pos);
+    }
+
+    inline void update(uint8_t slot, uint64_t deadline)
+    {
+        const uint8_t pos = positions_[slot];
+        entries_[pos].deadline = deadline;
+        restore(pos);
+    }
+
+    //Re-heapify after deadlines were changed in bulk through for_each
+    template <typename Fn>
+    inline void for_each(Fn&& fn)
+    {
+        for (uint8_t i = 0; i < size_; ++i)
+        {
+            fn(entries_[i].slot, entries_[i].deadline);
+        }
+        for (uint8_t i = size_ / 2; i-- > 0;)
+        {
+            sift_down(i);
+        }
+    }
+
+private:
+    struct Entry
+    {
+        uint64_t deadline;
+        uint8_t slot;
+    };
+
+    std::array<Entry, Capacity> entries_{};
+    std::array<uint8_t, Capacity> positions_;
+    uint8_t size_{0};
+
+    inline void swap_entries(uint8_t a, uint8_t b)
+    {
+        std::swap(entries_[a], entries_[b]);
+        positions_[entries_[a].slot] = a;
+        positions_[entries_[b].slot] = b;
+    }
+
+    inline void restore(uint8_t pos)
+    {
+        if (pos > 0 && entries_[pos].deadline < entries_[(pos - 1) / 2].deadline)
+        {
+            sift_up(pos);
+        }
+        else
+        {
+            sift_down(pos);
+        }
+    }
+
+    inline void sift_up(uint8_t pos)
+    {
+        while (pos > 0)
+        {
+            const uint8_t parent = (pos - 1) / 2;
+            if (entries_[parent].deadline <= entries_[pos].deadline)
+            {
+                break;
+            }
+            swap_entries(pos, parent);
+            pos = parent;
+        }
+    }
+
+    inline void sift_down(uint8_t pos)
+    {
+        while (true)
+        {
+            const uint8_t left = pos * 2 + 1;
+            const uint8_t right = left + 1;
+            uint8_t smallest = pos;
+
+            if (left < size_ && entries_[left].deadline < entries_[smallest].deadline)
+            {
+                smallest = left;
+            }
+            if (right < size_ && entries_[right].deadline < entries_[smallest].deadline)
+            {
+                smallest = right;
+            }
+            if (smallest == pos)
+            {
+                break;
+            }
+            swap_entries(pos, smallest);
+            pos = smallest;
+        }
+    }
+};
+
+#endif // _DEADLINE_HEAP_H_
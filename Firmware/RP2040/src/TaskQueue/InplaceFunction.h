@@ -0,0 +1,115 @@
+#ifndef _INPLACE_FUNCTION_H_
+#define _INPLACE_FUNCTION_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+//Move only void() callable stored inline, never allocates.
+//Callables that don't fit in Capacity bytes fail to compile at the call site that creates them.
+template <size_t Capacity>
+class InplaceFunction
+{
+public:
+    template <typename F>
+    static constexpr bool fits = sizeof(std::decay_t<F>) <= Capacity &&
+                                 alignof(std::decay_t<F>) <= alignof(std::max_align_t);
+
+    InplaceFunction() = default;
+    InplaceFunction(std::nullptr_t) {}
+
+    template <typename F, typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, InplaceFunction> && !std::is_same_v<Fn, std::nullptr_t>>>
+    InplaceFunction(F&& function)
+    {
+        static_assert(fits<Fn>, "InplaceFunction: captures exceed capacity, capture less or by reference");
+        static_assert(std::is_invocable_r_v<void, Fn&>, "InplaceFunction: callable must be invocable as void()");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "InplaceFunction: callable must be nothrow movable");
+
+        ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(function));
+
+        invoke_ = [](void* storage)
+        {
+            (*static_cast<Fn*>(storage))();
+        };
+        relocate_ = [](void* dst, void* src)
+        {
+            //Null dst just destroys src
+            if (dst)
+            {
+                ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            }
+            static_cast<Fn*>(src)->~Fn();
+        };
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    InplaceFunction(InplaceFunction&& other) noexcept
+    {
+        move_from(other);
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    ~InplaceFunction()
+    {
+        reset();
+    }
+
+    inline void operator()()
+    {
+        invoke_(storage_);
+    }
+
+    inline explicit operator bool() const
+    {
+        return invoke_ != nullptr;
+    }
+
+    inline void reset()
+    {
+        if (relocate_)
+        {
+            relocate_(nullptr, storage_);
+        }
+        invoke_ = nullptr;
+        relocate_ = nullptr;
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    void (*invoke_)(void* storage){nullptr};
+    void (*relocate_)(void* dst, void* src){nullptr};
+
+    inline void move_from(InplaceFunction& other)
+    {
+        if (other.relocate_)
+        {
+            other.relocate_(storage_, other.storage_);
+        }
+        invoke_ = other.invoke_;
+        relocate_ = other.relocate_;
+        other.invoke_ = nullptr;
+        other.relocate_ = nullptr;
+    }
+};
+
+#endif // _INPLACE_FUNCTION_H_
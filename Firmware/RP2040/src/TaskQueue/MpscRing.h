@@ -0,0 +1,104 @@
+#ifndef _MPSC_RING_H_
+#define _MPSC_RING_H_
+
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <utility>
+
+//Bounded multi-producer single-consumer FIFO, producers may be on either core or in an IRQ.
+//Each cell carries a sequence number, producers claim a cell with one CAS on tail_ and publish it
+//by advancing its sequence, so the move of the value itself happens outside of any lock.
+//Items come out in the order their cells were claimed, a claimed cell that isn't published yet
+//holds back the ones behind it instead of being skipped.
+template <typename T, uint32_t Depth>
+class MpscRing
+{
+    static_assert(Depth >= 2 && (Depth & (Depth - 1)) == 0, "MpscRing: depth must be a power of 2");
+
+public:
+    MpscRing()
+    {
+        for (uint32_t i = 0; i < Depth; ++i)
+        {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    //Returns false if full, value is left untouched
+    inline bool push(T&& value)
+    {
+        uint32_t pos = tail_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+
+        while (true)
+        {
+            cell = &cells_[pos & MASK];
+            const int32_t diff = static_cast<int32_t>(cell->seq.load(std::memory_order_acquire) - pos);
+
+            if (diff == 0)
+            {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    //Consumer only
+    inline bool pop(T& value)
+    {
+        Cell& cell = cells_[head_ & MASK];
+        const int32_t diff = static_cast<int32_t>(cell.seq.load(std::memory_order_acquire) - (head_ + 1));
+        if (diff < 0)
+        {
+            return false;
+        }
+
+        value = std::move(cell.value);
+        cell.seq.store(head_ + Depth, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    static constexpr uint32_t depth() { return Depth; }
+
+    //Consumer only, includes cells claimed but not yet published
+    inline uint32_t size() const { return tail_.load(std::memory_order_relaxed) - head_; }
+
+private:
+#if defined(OGXM_HOST_TEST)
+    //Host tests start the counters just short of their wrap
+    friend struct MpscRingTestAccess;
+#endif
+
+    static constexpr uint32_t MASK = Depth - 1;
+
+    struct Cell
+    {
+        std::atomic<uint32_t> seq{0};
+        T value{};
+    };
+
+    std::array<Cell, Depth> cells_;
+    std::atomic<uint32_t> tail_{0};
+    uint32_t head_{0};
+};
+
+#endif // _MPSC_RING_H_
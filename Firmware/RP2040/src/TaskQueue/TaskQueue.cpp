@@ -1,3 +1,4 @@
+#include "Board/ogxm_log.h"
 #include "TaskQueue/TaskQueue.h"
 
 TaskQueue::TaskQueue(CoreNum core_num) 
@@ -5,13 +6,8 @@ TaskQueue::TaskQueue(CoreNum core_num)
     alarm_num_ = (core_num == CoreNum::Core0) ? 0 : 1;
     alarm_num_ += (OGXM_BOARD == PI_PICOW) ? 1 : 0; //BTStack uses alarm 0
 
-    hw_set_bits(&timer_hw->inte, 1u << alarm_num_);
-
-    irq_set_exclusive_handler(
-        TIMER_IRQ(alarm_num_), 
+    task_queue_platform::alarm_init(alarm_num_, 
         (core_num == CoreNum::Core0) ? timer_irq_wrapper_c0 : timer_irq_wrapper_c1);
-
-    irq_set_enabled(TIMER_IRQ(alarm_num_), true);
 }
 
 uint32_t TaskQueue::get_new_task_id()
@@ -19,180 +15,296 @@ uint32_t TaskQueue::get_new_task_id()
     return new_task_id_++;
 }
 
-bool TaskQueue::queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const std::function<void()>& function)
+bool TaskQueue::queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, TaskFunction&& function)
 {
-    uint32_t irq_state = spin_lock_blocking(spinlock_delayed_);
-    for (const auto& task : task_queue_delayed_) 
+    uint32_t irq_state = task_queue_platform::lock(spinlock_delayed_);
+    if (find_delayed_slot_unsafe(task_id) != DelayedHeap::NPOS)
     {
-        if (task.task_id == task_id)
-        {
-            spin_unlock(spinlock_delayed_, irq_state);
-            return false;
-        }
+        task_queue_platform::unlock(spinlock_delayed_, irq_state);
+        return false;
     }
 
-    hw_set_bits(&timer_hw->inte, 1u << alarm_num_);
-
-    //Might come back to this, there is overflow potential
-    uint64_t target_time = timer_hw->timerawl + static_cast<uint64_t>(delay_ms) * 1000;
-
-    for (auto& task : task_queue_delayed_) 
+    const uint8_t slot = find_delayed_slot_unsafe(0);
+    if (slot == DelayedHeap::NPOS)
     {
-        if (!task.function) 
-        {
-            task.target_time = target_time;
-            task.interval_ms = repeating ? delay_ms : 0;
-            task.function = function;
-            task.task_id = task_id;
+#if defined(CONFIG_OGXM_TASK_STATS)
+        ++stats_.rejected_delayed_tasks;
+#endif
+        task_queue_platform::unlock(spinlock_delayed_, irq_state);
+        return false;
+    }
 
-            auto it = std::min_element(task_queue_delayed_.begin(), task_queue_delayed_.end(), [](const DelayedTask& a, const DelayedTask& b) 
-            {
-                return a.function && (!b.function || a.target_time < b.target_time);
-            });
+    DelayedTask& task = task_queue_delayed_[slot];
+    task.interval_ms = repeating ? delay_ms : 0;
+    task.due = false;
+    task.running = false;
+    task.function = std::move(function);
+    task.task_id = task_id;
 
-            if (it != task_queue_delayed_.end() && it->function) 
-            {
-                timer_hw->alarm[alarm_num_] = static_cast<uint32_t>(it->target_time);
-            }
+    delayed_heap_.push(slot, get_time_64_us() + static_cast<uint64_t>(delay_ms) * 1000);
 
-            spin_unlock(spinlock_delayed_, irq_state);
-            return true;
-        }
+#if defined(CONFIG_OGXM_TASK_STATS)
+    const uint32_t in_use = static_cast<uint32_t>(std::count_if(task_queue_delayed_.begin(), task_queue_delayed_.end(), 
+        [](const DelayedTask& delayed_task) { return delayed_task.task_id != 0; }));
+    stats_.delayed_high_water = std::max(stats_.delayed_high_water, in_use);
+#endif
+    if (delayed_heap_.top_slot() == slot)
+    {
+        set_alarm_unsafe();
     }
 
-    spin_unlock(spinlock_delayed_, irq_state);
-    return false;
+    task_queue_platform::unlock(spinlock_delayed_, irq_state);
+    return true;
 }
 
 void TaskQueue::cancel_delayed_task(uint32_t task_id)
 {
-    uint32_t irq_state = spin_lock_blocking(spinlock_delayed_);
-    bool found = false;
+    uint32_t irq_state = task_queue_platform::lock(spinlock_delayed_);
 
-    for (auto& task : task_queue_delayed_) 
+    const uint8_t slot = find_delayed_slot_unsafe(task_id);
+    if (task_id == 0 || slot == DelayedHeap::NPOS)
     {
-        if (task.task_id == task_id) 
-        {
-            task.function = nullptr;
-            task.task_id = 0;
-            task.interval_ms = 0;
-            found = true;
-        }
+        task_queue_platform::unlock(spinlock_delayed_, irq_state);
+        return;
     }
 
-    if (!found)
+    //A running task is destroyed by process_delayed_tasks() once it returns
+    DelayedTask& task = task_queue_delayed_[slot];
+    task.function = nullptr;
+    task.task_id = 0;
+    task.interval_ms = 0;
+    task.due = false;
+    task.running = false;
+
+    const bool was_next = !delayed_heap_.empty() && delayed_heap_.top_slot() == slot;
+    delayed_heap_.remove(slot);
+    if (was_next)
     {
-        spin_unlock(spinlock_delayed_, irq_state);
-        return;
+        set_alarm_unsafe();
     }
 
-    hw_set_bits(&timer_hw->inte, 1u << alarm_num_);
+    task_queue_platform::unlock(spinlock_delayed_, irq_state);
+}
 
-    int64_t next_target_time = get_next_target_time_unsafe(task_queue_delayed_);
-    if (next_target_time >= 0) 
+bool TaskQueue::queue_task(TaskFunction&& function)
+{
+    if (!task_queue_.push(std::move(function)))
     {
-        timer_hw->alarm[alarm_num_] = static_cast<uint32_t>(next_target_time);
+        dropped_tasks_.fetch_add(1, std::memory_order_relaxed);
+        return false;
     }
-    
-    spin_unlock(spinlock_delayed_, irq_state);
+    return true;
 }
 
-bool TaskQueue::queue_task(const std::function<void()>& function)
+void TaskQueue::process_tasks()
 {
-    uint32_t irq_state = spin_lock_blocking(spinlock_queue_);
-    for (auto& task : task_queue_)
+#if defined(CONFIG_OGXM_TASK_STATS)
+    uint32_t irq_state = task_queue_platform::lock(spinlock_delayed_);
+    stats_.queue_high_water = std::max(stats_.queue_high_water, task_queue_.size());
+    task_queue_platform::unlock(spinlock_delayed_, irq_state);
+#endif
+
+    //Bounded so tasks queueing more tasks can't keep the loop here
+    TaskFunction function;
+    for (uint32_t i = 0; i < task_queue_.depth() && task_queue_.pop(function); ++i)
     {
-        if (!task.function)
-        {
-            task.function = function;
-            spin_unlock(spinlock_queue_, irq_state);
-            return true;
-        }
+#if defined(CONFIG_OGXM_TASK_STATS)
+        const uint64_t start_time = get_time_64_us();
+        function();
+        record_run(0, get_time_64_us() - start_time, 0);
+#else
+        function();
+#endif
+        function = nullptr;
     }
-    spin_unlock(spinlock_queue_, irq_state);
-    return false;
+
+    process_delayed_tasks();
 }
 
-void TaskQueue::process_tasks()
+//Runs tasks flagged due by the timer IRQ, on the core that owns the queue
+void TaskQueue::process_delayed_tasks()
 {
-    uint32_t irq_state = spin_lock_blocking(spinlock_queue_);
-    for (auto& task : task_queue_)
+    //Cleared before scanning, a task flagged during the scan sets it again
+    if (!delayed_due_.load())
+    {
+        return;
+    }
+    delayed_due_.store(false);
+
+    for (auto& task : task_queue_delayed_)
     {
-        if (task.function)
+        uint32_t irq_state = task_queue_platform::lock(spinlock_delayed_);
+        if (!task.task_id || !task.due || task.running)
         {
-            auto function = task.function;
-            task.function = nullptr;
-            spin_unlock(spinlock_queue_, irq_state);
+            task_queue_platform::unlock(spinlock_delayed_, irq_state);
+            continue;
+        }
 
-            function();
+        const uint32_t task_id = task.task_id;
+        const bool repeating = (task.interval_ms != 0);
+        TaskFunction function = std::move(task.function);
+        task.due = false;
+#if defined(CONFIG_OGXM_TASK_STATS)
+        const uint64_t due_time = task.due_time;
+#endif
 
-            irq_state = spin_lock_blocking(spinlock_queue_);
+        if (repeating)
+        {
+            task.running = true;
         }
         else
         {
-            break; //No more tasks
+            task.task_id = 0;
+        }
+        task_queue_platform::unlock(spinlock_delayed_, irq_state);
+
+#if defined(CONFIG_OGXM_TASK_STATS)
+        const uint64_t start_time = get_time_64_us();
+        function();
+        record_run(task_id, get_time_64_us() - start_time, start_time - due_time);
+#else
+        function();
+#endif
+
+        if (repeating)
+        {
+            irq_state = task_queue_platform::lock(spinlock_delayed_);
+            //Skip if it was cancelled (or cancelled and replaced) while running
+            if (task.running && task.task_id == task_id)
+            {
+                task.function = std::move(function);
+                task.running = false;
+            }
+            task_queue_platform::unlock(spinlock_delayed_, irq_state);
         }
     }
-    spin_unlock(spinlock_queue_, irq_state);
 }
 
 uint64_t TaskQueue::get_time_64_us()
 {
-    static spin_lock_t* spinlock_time_ = nullptr;
-    if (!spinlock_time_)
+    return task_queue_platform::time_us();
+}
+
+//Arms the alarm for the earliest deadline. The alarm only compares the low 32 bits of the timer,
+//so deadlines further out than MAX_ALARM_DELAY_US are reached in steps, and a deadline that has
+//already passed (or passes while arming) forces the IRQ instead of waiting for the counter to wrap.
+void TaskQueue::set_alarm_unsafe()
+{
+    if (delayed_heap_.empty() || suspended_)
+    {
+        return;
+    }
+
+    const uint64_t now = get_time_64_us();
+    const uint64_t target_time = delayed_heap_.top_deadline();
+    const uint64_t delay = (target_time > now) ? std::min(target_time - now, MAX_ALARM_DELAY_US) : 0;
+    const uint32_t alarm_time = static_cast<uint32_t>(now + delay);
+
+    task_queue_platform::alarm_arm(alarm_num_, alarm_time);
+
+    if (delay == 0 || static_cast<int32_t>(task_queue_platform::time_us_low() - alarm_time) >= 0)
     {
-        int spinlock_time_num = spin_lock_claim_unused(true);
-        spinlock_time_ = spin_lock_instance(static_cast<uint>(spinlock_time_num));
+        task_queue_platform::alarm_force(alarm_num_);
     }
-    uint32_t irq_state = spin_lock_blocking(spinlock_time_);
-    uint32_t lo = timer_hw->timelr;
-    uint32_t hi = timer_hw->timehr;
-    spin_unlock(spinlock_time_, irq_state);
-    return ((uint64_t) hi << 32u) | lo;;
 }
 
 void TaskQueue::timer_irq_handler()
 {
-    hw_clear_bits(&timer_hw->intr, 1u << alarm_num_);
+    task_queue_platform::alarm_clear(alarm_num_);
 
-    uint64_t now = get_time_64_us();
-    uint32_t irq_state = spin_lock_blocking(spinlock_delayed_);
+    uint32_t irq_state = task_queue_platform::lock(spinlock_delayed_);
     if (suspended_)
     {
-        spin_unlock(spinlock_delayed_, irq_state);
+        task_queue_platform::unlock(spinlock_delayed_, irq_state);
         return;
     }
 
-    for (auto& task : task_queue_delayed_) 
+    const uint64_t now = get_time_64_us();
+
+    while (!delayed_heap_.empty() && delayed_heap_.top_deadline() <= now) 
     {
-        if (task.function && task.target_time <= now) 
-        {
-            auto function = task.function;
-            if (task.interval_ms) 
-            {
-                task.target_time += (task.interval_ms * 1000);
-            } 
-            else 
-            {
-                task.function = nullptr;
-                task.task_id = 0;
-            }
+        const uint8_t slot = delayed_heap_.top_slot();
+        DelayedTask& task = task_queue_delayed_[slot];
+
+        //Flag only, the function runs from process_tasks() so it never has to be copied here
+        task.due = true;
+        delayed_due_.store(true);
 
-            spin_unlock(spinlock_delayed_, irq_state);
-            queue_task(function);
-            irq_state = spin_lock_blocking(spinlock_delayed_);
+#if defined(CONFIG_OGXM_TASK_STATS)
+        task.due_time = delayed_heap_.top_deadline();
+        stats_.record_irq_late(now - task.due_time);
+#endif
+
+        if (task.interval_ms) 
+        {
+            //Skip intervals missed while late instead of firing once per missed interval
+            const uint64_t interval_us = static_cast<uint64_t>(task.interval_ms) * 1000;
+            const uint64_t target_time = delayed_heap_.top_deadline();
+            delayed_heap_.update(slot, target_time + ((now - target_time) / interval_us + 1) * interval_us);
+        } 
+        else 
+        {
+            //One shot stays in its slot until run
+            delayed_heap_.remove(slot);
         }
     }
 
-    int64_t next_target_time = get_next_target_time_unsafe(task_queue_delayed_);
-    if (next_target_time >= 0) 
+    set_alarm_unsafe();
+    task_queue_platform::unlock(spinlock_delayed_, irq_state);
+}
+
+#if defined(CONFIG_OGXM_TASK_STATS)
+
+//Under the same lock as the IRQ's writes, so get_stats() from the other core copies a consistent snapshot
+void TaskQueue::record_run(uint32_t task_id, uint64_t exec_us, uint64_t late_us)
+{
+    uint32_t irq_state = task_queue_platform::lock(spinlock_delayed_);
+    stats_.record_run(task_id, exec_us, late_us);
+    task_queue_platform::unlock(spinlock_delayed_, irq_state);
+}
+
+TaskStats TaskQueue::get_stats()
+{
+    uint32_t irq_state = task_queue_platform::lock(spinlock_delayed_);
+    TaskStats stats = stats_;
+    task_queue_platform::unlock(spinlock_delayed_, irq_state);
+
+    stats.rejected_tasks = dropped_tasks_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void TaskQueue::log_stats(uint8_t core_num)
+{
+    const TaskStats stats = get_stats();
+
+    OGXM_LOG("TaskQueue core%d: queue hwm %d/%d, delayed hwm %d/%d, rejected %d/%d\n", 
+        core_num, stats.queue_high_water, task_queue_.depth(), stats.delayed_high_water, MAX_DELAYED_TASKS,
+        stats.rejected_tasks, stats.rejected_delayed_tasks);
+
+    if (stats.irq_count)
     {
-        timer_hw->alarm[alarm_num_] = static_cast<uint32_t>(next_target_time);
+        OGXM_LOG("  alarm irq: %d, late avg %dus max %dus\n", 
+            stats.irq_count, static_cast<uint32_t>(stats.irq_late_total_us / stats.irq_count), stats.irq_late_max_us);
+    }
+    for (const auto& entry : stats.entries)
+    {
+        if (!entry.runs)
+        {
+            continue;
+        }
+        OGXM_LOG("  task %d: runs %d, exec avg %dus max %dus, late avg %dus max %dus\n", 
+            entry.task_id, entry.runs,
+            static_cast<uint32_t>(entry.exec_total_us / entry.runs), entry.exec_max_us,
+            static_cast<uint32_t>(entry.late_total_us / entry.runs), entry.late_max_us);
+    }
+    if (stats.untracked_runs)
+    {
+        OGXM_LOG("  untracked runs: %d\n", stats.untracked_runs);
     }
-
-    spin_unlock(spinlock_delayed_, irq_state);
 }
 
+#endif // defined(CONFIG_OGXM_TASK_STATS)
+
 void TaskQueue::suspend_delayed_tasks()
 {
     get_core0().suspend_delayed();
@@ -211,42 +323,35 @@ void TaskQueue::resume_delayed_tasks()
 
 void TaskQueue::suspend_delayed()
 {
-    uint32_t irq_state = spin_lock_blocking(spinlock_delayed_);
+    uint32_t irq_state = task_queue_platform::lock(spinlock_delayed_);
     if (suspended_)
     {
-        spin_unlock(spinlock_delayed_, irq_state);
+        task_queue_platform::unlock(spinlock_delayed_, irq_state);
         return;
     }
-    hw_clear_bits(&timer_hw->intr, 1u << alarm_num_);
+    task_queue_platform::alarm_clear(alarm_num_);
     suspended_time_ = get_time_64_us();
     suspended_ = true;
-    spin_unlock(spinlock_delayed_, irq_state);
+    task_queue_platform::unlock(spinlock_delayed_, irq_state);
 }
 
 void TaskQueue::resume_delayed()
 {
-    uint32_t irq_state = spin_lock_blocking(spinlock_delayed_);
+    uint32_t irq_state = task_queue_platform::lock(spinlock_delayed_);
     if (!suspended_)
     {
-        spin_unlock(spinlock_delayed_, irq_state);
+        task_queue_platform::unlock(spinlock_delayed_, irq_state);
         return;
     }
 
     uint64_t now = get_time_64_us();
     uint64_t elapsed_time = now - suspended_time_;
 
-    for (auto& task : task_queue_delayed_) 
+    delayed_heap_.for_each([elapsed_time, now](uint8_t, uint64_t& target_time)
     {
-        if (task.function) 
-        {
-            task.target_time = std::max(task.target_time + elapsed_time, now + 10);
-        }
-    }
-    int64_t next_target_time = get_next_target_time_unsafe(task_queue_delayed_);
-    if (next_target_time >= 0) 
-    {
-        timer_hw->alarm[alarm_num_] = static_cast<uint32_t>(next_target_time);
-    }
+        target_time = std::max(target_time + elapsed_time, now + 10);
+    });
     suspended_ = false;
-    spin_unlock(spinlock_delayed_, irq_state);
+    set_alarm_unsafe();
+    task_queue_platform::unlock(spinlock_delayed_, irq_state);
 }
\ No newline at end of file
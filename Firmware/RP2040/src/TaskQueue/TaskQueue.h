@@ -2,18 +2,32 @@
 #define TASK_QUEUE_H
 
 #include <cstdint>
-#include <functional>
-#include <memory>
-#include <pico/stdlib.h>
-#include <hardware/timer.h>
-#include <hardware/irq.h>
-#include <hardware/sync.h>
+#include <array>
+#include <algorithm>
+#include <utility>
+#include <atomic>
 
 #include "Board/Config.h"
+#include "TaskQueue/TaskQueuePlatform.h"
+#include "TaskQueue/InplaceFunction.h"
+#include "TaskQueue/DeadlineHeap.h"
+#include "TaskQueue/MpscRing.h"
+#if defined(CONFIG_OGXM_TASK_STATS)
+    #include "TaskQueue/TaskStats.h"
+#endif
+
+//Immediate tasks each core can hold before queue_task() starts dropping, power of 2
+#ifndef TASK_QUEUE_DEPTH
+    #define TASK_QUEUE_DEPTH 16
+#endif
 
 class TaskQueue
 {
 public:
+    //Largest capture a task can hold, anything bigger fails to compile where the task is queued
+    static constexpr size_t TASK_CAPACITY = 24;
+    using TaskFunction = InplaceFunction<TASK_CAPACITY>;
+
     struct Core0
     {
         static inline uint32_t get_new_task_id()
@@ -24,18 +38,34 @@ public:
         {
             get_core0().cancel_delayed_task(task_id);
         }
-        static inline bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const std::function<void()>& function)
+        template <typename F>
+        static inline bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, F&& function)
         {
-            return get_core0().queue_delayed_task(task_id, delay_ms, repeating, function);
+            return get_core0().queue_delayed_task(task_id, delay_ms, repeating, TaskFunction(std::forward<F>(function)));
         }
-        static inline bool queue_task(const std::function<void()>& function)
+        template <typename F>
+        static inline bool queue_task(F&& function)
         {
-            return get_core0().queue_task(function);
+            return get_core0().queue_task(TaskFunction(std::forward<F>(function)));
         }
         static inline void process_tasks()
         {
             get_core0().process_tasks();
         }
+        static inline uint32_t dropped_tasks()
+        {
+            return get_core0().dropped_tasks_.load(std::memory_order_relaxed);
+        }
+#if defined(CONFIG_OGXM_TASK_STATS)
+        static inline TaskStats get_stats()
+        {
+            return get_core0().get_stats();
+        }
+        static inline void log_stats()
+        {
+            get_core0().log_stats(0);
+        }
+#endif
         static inline void suspend_delayed_tasks()
         {
             get_core0().suspend_delayed();
@@ -57,18 +87,40 @@ public:
         {
             get_core1().cancel_delayed_task(task_id);
         }
-        static inline bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const std::function<void()>& function)
+        template <typename F>
+        static inline bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, F&& function)
         {
-            return get_core1().queue_delayed_task(task_id, delay_ms, repeating, function);
+            return get_core1().queue_delayed_task(task_id, delay_ms, repeating, TaskFunction(std::forward<F>(function)));
         }
-        static inline bool queue_task(const std::function<void()>& function)
+        template <typename F>
+        static inline bool queue_task(F&& function)
         {
-            return get_core1().queue_task(function);
+            return get_core1().queue_task(TaskFunction(std::forward<F>(function)));
         }
         static inline void process_tasks()
         {
             get_core1().process_tasks();
         }
+        static inline uint32_t dropped_tasks()
+        {
+            return get_core1().dropped_tasks_.load(std::memory_order_relaxed);
+        }
+#if defined(CONFIG_OGXM_TASK_STATS)
+        static inline TaskStats get_stats()
+        {
+            return get_core1().get_stats();
+        }
+        static inline void log_stats()
+        {
+            get_core1().log_stats(1);
+        }
+        //Copy without the lock, for the reboot path: board_api::usb::disconnect_all() resets core1, 
+        //which could have been holding it
+        static inline TaskStats get_stats_unlocked()
+        {
+            return get_core1().stats_;
+        }
+#endif
         static inline void suspend_delayed_tasks()
         {
             get_core1().suspend_delayed();
@@ -97,37 +149,49 @@ private:
     TaskQueue(CoreNum core_num);
     ~TaskQueue() = default;
 
-    struct Task
-    {
-        // uint32_t task_id = 0;
-        std::function<void()> function = nullptr;
-    };
-
+    //Slot is in use while task_id != 0, its deadline lives in delayed_heap_ until it's due.
+    //Due tasks are run from process_tasks(), a repeating task's function is moved out
+    //while it runs (running) and moved back after.
     struct DelayedTask
     {
         uint32_t task_id = 0;
         uint32_t interval_ms = 0;
-        uint64_t target_time = 0;
-        std::function<void()> function = nullptr;
+        bool due = false;
+        bool running = false;
+        TaskFunction function = nullptr;
+#if defined(CONFIG_OGXM_TASK_STATS)
+        uint64_t due_time = 0;
+#endif
     };
 
-    static constexpr uint8_t MAX_TASKS = 8;
-    static constexpr uint8_t MAX_DELAYED_TASKS = MAX_TASKS * 2;
+    static constexpr uint8_t MAX_DELAYED_TASKS = 16;
+    //Alarm compares against the low 32 bits of the timer, longer waits are split
+    static constexpr uint64_t MAX_ALARM_DELAY_US = 1ULL << 31;
+
+    using DelayedHeap = DeadlineHeap<MAX_DELAYED_TASKS>;
 
     // CoreNum core_num_;
     uint32_t alarm_num_;
     uint32_t new_task_id_ = 1;
 
     bool suspended_ = false;
+    std::atomic<bool> delayed_due_{false};
     uint64_t suspended_time_ = 0;
 
-    int spinlock_queue_num_ = spin_lock_claim_unused(true);
-    int spinlock_delayed_num_ = spin_lock_claim_unused(true);
-    spin_lock_t* spinlock_queue_ = spin_lock_instance(static_cast<uint>(spinlock_queue_num_));
-    spin_lock_t* spinlock_delayed_ = spin_lock_instance(static_cast<uint>(spinlock_delayed_num_));
+    task_queue_platform::SpinLock spinlock_delayed_ = task_queue_platform::claim_spinlock();
 
-    std::array<Task, MAX_TASKS> task_queue_;
+    MpscRing<TaskFunction, TASK_QUEUE_DEPTH> task_queue_;
+    std::atomic<uint32_t> dropped_tasks_{0};
+
+#if defined(CONFIG_OGXM_TASK_STATS)
+    TaskStats stats_;
+
+    void record_run(uint32_t task_id, uint64_t exec_us, uint64_t late_us);
+    TaskStats get_stats();
+    void log_stats(uint8_t core_num);
+#endif
     std::array<DelayedTask, MAX_DELAYED_TASKS> task_queue_delayed_;
+    DelayedHeap delayed_heap_;
 
     static TaskQueue& get_core0()
     {
@@ -141,14 +205,16 @@ private:
     }
 
     uint32_t get_new_task_id();
-    bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, const std::function<void()>& function);
+    bool queue_delayed_task(uint32_t task_id, uint32_t delay_ms, bool repeating, TaskFunction&& function);
     void cancel_delayed_task(uint32_t task_id);
-    bool queue_task(const std::function<void()>& function);
+    bool queue_task(TaskFunction&& function);
     void process_tasks();
+    void process_delayed_tasks();
 
     void suspend_delayed();
     void resume_delayed();
     void timer_irq_handler();
+    void set_alarm_unsafe();
     static uint64_t get_time_64_us();
 
     static inline void timer_irq_wrapper_c0()
@@ -159,23 +225,17 @@ private:
     {
         get_core1().timer_irq_handler();
     }
-    static inline uint32_t TIMER_IRQ(uint32_t alarm_num)
-    {
-        return timer_hardware_alarm_get_irq_num(timer_hw, alarm_num);
-    }
-    static inline int64_t get_next_target_time_unsafe(std::array<DelayedTask, MAX_DELAYED_TASKS>& task_queue_delayed)
+    //Task id 0 finds a free slot
+    inline uint8_t find_delayed_slot_unsafe(uint32_t task_id) const
     {
-        auto it = std::min_element(task_queue_delayed.begin(), task_queue_delayed.end(), [](const DelayedTask& a, const DelayedTask& b) 
-        {
-            //Get task with the earliest target time
-            return a.function && (!b.function || a.target_time < b.target_time);
-        });
-
-        if (it != task_queue_delayed.end() && it->function) 
+        for (uint8_t i = 0; i < MAX_DELAYED_TASKS; ++i)
         {
-            return static_cast<int64_t>(it->target_time);
+            if (task_queue_delayed_[i].task_id == task_id)
+            {
+                return i;
+            }
         }
-        return -1;
+        return DelayedHeap::NPOS;
     }
 
 }; // class TaskQueue
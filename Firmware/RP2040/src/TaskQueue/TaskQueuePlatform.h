@@ -0,0 +1,162 @@
+#ifndef _TASK_QUEUE_PLATFORM_H_
+#define _TASK_QUEUE_PLATFORM_H_
+
+#include <cstdint>
+
+//Everything TaskQueue needs from the hardware: a spinlock, the 64-bit microsecond timer,
+//and one timer alarm per core whose compare register only holds the low 32 bits.
+//Define TASK_QUEUE_FAKE_PLATFORM to build the queue off-target against a simulated clock.
+
+#if !defined(TASK_QUEUE_FAKE_PLATFORM)
+
+#include <pico/stdlib.h>
+#include <hardware/timer.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
+
+namespace task_queue_platform
+{
+    using SpinLock = spin_lock_t*;
+
+    static inline SpinLock claim_spinlock()
+    {
+        return spin_lock_instance(static_cast<uint>(spin_lock_claim_unused(true)));
+    }
+    static inline uint32_t lock(SpinLock spinlock)
+    {
+        return spin_lock_blocking(spinlock);
+    }
+    static inline void unlock(SpinLock spinlock, uint32_t irq_state)
+    {
+        spin_unlock(spinlock, irq_state);
+    }
+
+    //Reads the raw registers, unlike timelr/timehr there's no latch shared between cores
+    static inline uint64_t time_us()
+    {
+        return time_us_64();
+    }
+    static inline uint32_t time_us_low()
+    {
+        return timer_hw->timerawl;
+    }
+
+    static inline void alarm_init(uint32_t alarm_num, void (*handler)())
+    {
+        hw_set_bits(&timer_hw->inte, 1u << alarm_num);
+        irq_set_exclusive_handler(timer_hardware_alarm_get_irq_num(timer_hw, alarm_num), handler);
+        irq_set_enabled(timer_hardware_alarm_get_irq_num(timer_hw, alarm_num), true);
+    }
+    //Fires when the low 32 bits of the timer reach alarm_time
+    static inline void alarm_arm(uint32_t alarm_num, uint32_t alarm_time)
+    {
+        hw_set_bits(&timer_hw->inte, 1u << alarm_num);
+        timer_hw->alarm[alarm_num] = alarm_time;
+    }
+    //Raises the alarm IRQ now
+    static inline void alarm_force(uint32_t alarm_num)
+    {
+        hw_set_bits(&timer_hw->intf, 1u << alarm_num);
+    }
+    static inline void alarm_clear(uint32_t alarm_num)
+    {
+        hw_clear_bits(&timer_hw->intf, 1u << alarm_num);
+        hw_clear_bits(&timer_hw->intr, 1u << alarm_num);
+    }
+
+} // namespace task_queue_platform
+
+#else // !defined(TASK_QUEUE_FAKE_PLATFORM)
+
+#include <array>
+
+//Single threaded simulation, time only moves when fake::advance_to() is called
+//and alarm handlers run from inside it, like an IRQ would.
+namespace task_queue_platform
+{
+    using SpinLock = uint32_t*;
+
+    namespace fake
+    {
+        struct Alarm
+        {
+            void (*handler)() = nullptr;
+            uint32_t alarm_time = 0;
+            bool armed = false;
+            bool forced = false;
+        };
+
+        inline uint64_t now_us = 0;
+        inline std::array<Alarm, 4> alarms{};
+        inline uint32_t spinlock_state = 0;
+
+        //Moves the clock forward in step_us increments, an armed alarm fires when the low 32 bits
+        //of the clock pass its compare value, the same as the hardware comparator
+        static inline void advance_to(uint64_t time_us, uint32_t step_us = 1)
+        {
+            while (now_us < time_us)
+            {
+                const uint64_t prev_us = now_us;
+                now_us = (time_us - now_us > step_us) ? now_us + step_us : time_us;
+
+                for (auto& alarm : alarms)
+                {
+                    const uint32_t elapsed = static_cast<uint32_t>(now_us - prev_us);
+                    const uint32_t until_alarm = alarm.alarm_time - static_cast<uint32_t>(prev_us);
+                    if (alarm.armed && until_alarm != 0 && until_alarm <= elapsed)
+                    {
+                        alarm.armed = false;
+                        alarm.forced = true;
+                    }
+                    //Handler clears forced, a handler that forces again runs again
+                    for (uint8_t i = 0; alarm.forced && alarm.handler && i < 8; ++i)
+                    {
+                        alarm.handler();
+                    }
+                }
+            }
+        }
+    } // namespace fake
+
+    static inline SpinLock claim_spinlock()
+    {
+        return &fake::spinlock_state;
+    }
+    static inline uint32_t lock(SpinLock)
+    {
+        return 0;
+    }
+    static inline void unlock(SpinLock, uint32_t) {}
+
+    static inline uint64_t time_us()
+    {
+        return fake::now_us;
+    }
+    static inline uint32_t time_us_low()
+    {
+        return static_cast<uint32_t>(fake::now_us);
+    }
+
+    static inline void alarm_init(uint32_t alarm_num, void (*handler)())
+    {
+        fake::alarms[alarm_num].handler = handler;
+    }
+    static inline void alarm_arm(uint32_t alarm_num, uint32_t alarm_time)
+    {
+        fake::alarms[alarm_num].alarm_time = alarm_time;
+        fake::alarms[alarm_num].armed = true;
+    }
+    static inline void alarm_force(uint32_t alarm_num)
+    {
+        fake::alarms[alarm_num].forced = true;
+    }
+    static inline void alarm_clear(uint32_t alarm_num)
+    {
+        fake::alarms[alarm_num].forced = false;
+    }
+
+} // namespace task_queue_platform
+
+#endif // !defined(TASK_QUEUE_FAKE_PLATFORM)
+
+#endif // _TASK_QUEUE_PLATFORM_H_
@@ -0,0 +1,86 @@
+#ifndef _TASK_STATS_H_
+#define _TASK_STATS_H_
+
+#include <cstdint>
+#include <array>
+
+//Runtime stats for one core's TaskQueue, only compiled in with CONFIG_OGXM_TASK_STATS.
+//Written from the owning core (task loop and its timer IRQ) under the queue's spinlock, read it through get_stats().
+struct TaskStats
+{
+    //Delayed tasks are tracked by id, immediate tasks (no id) are all counted under id 0
+    static constexpr uint8_t MAX_TRACKED = 16;
+
+    struct Entry
+    {
+        uint32_t task_id;
+        uint32_t runs;
+        uint32_t exec_max_us;
+        uint32_t late_max_us;       //Scheduled deadline to start of execution
+        uint64_t exec_total_us;
+        uint64_t late_total_us;
+    };
+
+    std::array<Entry, MAX_TRACKED> entries{};
+    uint32_t untracked_runs{0};     //Runs of delayed tasks that didn't fit in entries
+
+    uint32_t irq_count{0};
+    uint32_t irq_late_max_us{0};    //Scheduled deadline to alarm IRQ
+    uint64_t irq_late_total_us{0};
+
+    uint32_t queue_high_water{0};
+    uint32_t delayed_high_water{0};
+    uint32_t rejected_tasks{0};
+    uint32_t rejected_delayed_tasks{0};
+
+    inline void record_run(uint32_t task_id, uint64_t exec_us, uint64_t late_us)
+    {
+        Entry* entry = find(task_id);
+        if (!entry)
+        {
+            ++untracked_runs;
+            return;
+        }
+        ++entry->runs;
+        entry->exec_total_us += exec_us;
+        entry->late_total_us += late_us;
+        entry->exec_max_us = max_u32(entry->exec_max_us, exec_us);
+        entry->late_max_us = max_u32(entry->late_max_us, late_us);
+    }
+
+    inline void record_irq_late(uint64_t late_us)
+    {
+        ++irq_count;
+        irq_late_total_us += late_us;
+        irq_late_max_us = max_u32(irq_late_max_us, late_us);
+    }
+
+private:
+    //Finds the entry for task_id or claims an unused one
+    inline Entry* find(uint32_t task_id)
+    {
+        for (auto& entry : entries)
+        {
+            if (entry.runs && entry.task_id == task_id)
+            {
+                return &entry;
+            }
+        }
+        for (auto& entry : entries)
+        {
+            if (!entry.runs)
+            {
+                entry.task_id = task_id;
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    static inline uint32_t max_u32(uint32_t current, uint64_t value)
+    {
+        return (value > current) ? ((value > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(value)) : current;
+    }
+};
+
+#endif // _TASK_STATS_H_
@@ -4,6 +4,28 @@
 
 #include "Descriptors/PS3.h"
 #include "USBDevice/DeviceDriver/DInput/DInput.h"
+#include "USBDevice/DeviceDriver/ReportEncoder.h"
+
+static constexpr ReportEncoder::ButtonBit BUTTONS[] =
+{
+    { Gamepad::BUTTON_A,     ReportEncoder::at(0, DInput::Buttons0::CROSS)    },
+    { Gamepad::BUTTON_B,     ReportEncoder::at(0, DInput::Buttons0::CIRCLE)   },
+    { Gamepad::BUTTON_X,     ReportEncoder::at(0, DInput::Buttons0::SQUARE)   },
+    { Gamepad::BUTTON_Y,     ReportEncoder::at(0, DInput::Buttons0::TRIANGLE) },
+    { Gamepad::BUTTON_LB,    ReportEncoder::at(0, DInput::Buttons0::L1)       },
+    { Gamepad::BUTTON_RB,    ReportEncoder::at(0, DInput::Buttons0::R1)       },
+    { Gamepad::BUTTON_L3,    ReportEncoder::at(1, DInput::Buttons1::L3)       },
+    { Gamepad::BUTTON_R3,    ReportEncoder::at(1, DInput::Buttons1::R3)       },
+    { Gamepad::BUTTON_BACK,  ReportEncoder::at(1, DInput::Buttons1::SELECT)   },
+    { Gamepad::BUTTON_START, ReportEncoder::at(1, DInput::Buttons1::START)    },
+    { Gamepad::BUTTON_SYS,   ReportEncoder::at(1, DInput::Buttons1::SYS)      },
+    { Gamepad::BUTTON_MISC,  ReportEncoder::at(1, DInput::Buttons1::TP)       },
+};
+
+//Both button bytes, the hat has its own byte
+static constexpr auto ENCODER = ReportEncoder::make<uint16_t>(BUTTONS,
+    { DInput::DPad::UP, DInput::DPad::DOWN, DInput::DPad::LEFT, DInput::DPad::RIGHT,
+      DInput::DPad::UP_LEFT, DInput::DPad::UP_RIGHT, DInput::DPad::DOWN_LEFT, DInput::DPad::DOWN_RIGHT, DInput::DPad::CENTER });
 
 bool DInputDevice::control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request)
 {
@@ -48,52 +70,10 @@ void DInputDevice::process(const uint8_t idx, Gamepad& gamepad)
     {
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
 
-        switch (gp_in.dpad)
-        {
-            case Gamepad::DPAD_UP:
-                in_report.dpad = DInput::DPad::UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                in_report.dpad = DInput::DPad::DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                in_report.dpad = DInput::DPad::LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                in_report.dpad = DInput::DPad::RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                in_report.dpad = DInput::DPad::UP_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                in_report.dpad = DInput::DPad::UP_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                in_report.dpad = DInput::DPad::DOWN_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                in_report.dpad = DInput::DPad::DOWN_RIGHT;
-                break;
-            default:
-                in_report.dpad = DInput::DPad::CENTER;
-                break;
-        }
-
-        std::memset(in_report.buttons, 0, sizeof(in_report.buttons));
-
-        if (gp_in.buttons & Gamepad::BUTTON_A)   in_report.buttons[0] |= DInput::Buttons0::CROSS;
-        if (gp_in.buttons & Gamepad::BUTTON_B)   in_report.buttons[0] |= DInput::Buttons0::CIRCLE;
-        if (gp_in.buttons & Gamepad::BUTTON_X)   in_report.buttons[0] |= DInput::Buttons0::SQUARE;
-        if (gp_in.buttons & Gamepad::BUTTON_Y)   in_report.buttons[0] |= DInput::Buttons0::TRIANGLE;
-        if (gp_in.buttons & Gamepad::BUTTON_LB)  in_report.buttons[0] |= DInput::Buttons0::L1;
-        if (gp_in.buttons & Gamepad::BUTTON_RB)  in_report.buttons[0] |= DInput::Buttons0::R1;
+        in_report.dpad = static_cast<uint8_t>(ENCODER.dpad(gp_in));
 
-        if (gp_in.buttons & Gamepad::BUTTON_L3)    in_report.buttons[1] |= DInput::Buttons1::L3;
-        if (gp_in.buttons & Gamepad::BUTTON_R3)    in_report.buttons[1] |= DInput::Buttons1::R3;
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report.buttons[1] |= DInput::Buttons1::SELECT;
-        if (gp_in.buttons & Gamepad::BUTTON_START) in_report.buttons[1] |= DInput::Buttons1::START;
-        if (gp_in.buttons & Gamepad::BUTTON_SYS)   in_report.buttons[1] |= DInput::Buttons1::SYS;
-        if (gp_in.buttons & Gamepad::BUTTON_MISC)  in_report.buttons[1] |= DInput::Buttons1::TP;
+        const uint16_t buttons = ENCODER.buttons(gp_in);
+        std::memcpy(in_report.buttons, &buttons, sizeof(in_report.buttons));
 
         if (gamepad.analog_enabled())
         {
@@ -125,9 +105,10 @@ void DInputDevice::process(const uint8_t idx, Gamepad& gamepad)
         tud_remote_wakeup();
     }
 
-    if (tud_hid_n_ready(idx))
+    if (tud_hid_n_ready(idx) &&
+        tud_hid_n_report(idx, 0, reinterpret_cast<void*>(&in_report), sizeof(DInput::InReport)))
     {
-        tud_hid_n_report(idx, 0, reinterpret_cast<void*>(&in_report), sizeof(DInput::InReport));
+        gamepad.record_latency();
     }
 }
 
@@ -31,6 +31,11 @@ public:
     
     const usbd_class_driver_t* get_class_driver() { return &class_driver_; };
 
+    //None of the class drivers use SOF themselves, the hook is free for sof_sync
+    void set_sof_cb(void (*sof_cb)(uint8_t rhport, uint32_t frame_count)) { class_driver_.sof = sof_cb; }
+    //For poll_rate's measurement, which chains to the driver's own xfer_cb
+    void set_xfer_cb(bool (*xfer_cb)(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)) { class_driver_.xfer_cb = xfer_cb; }
+
 protected:
     usbd_class_driver_t class_driver_;
 
@@ -2,6 +2,28 @@
 #include <algorithm>
 
 #include "USBDevice/DeviceDriver/PS3/PS3.h"
+#include "USBDevice/DeviceDriver/ReportEncoder.h"
+
+static constexpr ReportEncoder::ButtonBit BUTTONS[] =
+{
+    { Gamepad::BUTTON_X,     ReportEncoder::at(1, PS3::Buttons1::SQUARE)   },
+    { Gamepad::BUTTON_A,     ReportEncoder::at(1, PS3::Buttons1::CROSS)    },
+    { Gamepad::BUTTON_Y,     ReportEncoder::at(1, PS3::Buttons1::TRIANGLE) },
+    { Gamepad::BUTTON_B,     ReportEncoder::at(1, PS3::Buttons1::CIRCLE)   },
+    { Gamepad::BUTTON_LB,    ReportEncoder::at(1, PS3::Buttons1::L1)       },
+    { Gamepad::BUTTON_RB,    ReportEncoder::at(1, PS3::Buttons1::R1)       },
+    { Gamepad::BUTTON_BACK,  ReportEncoder::at(0, PS3::Buttons0::SELECT)   },
+    { Gamepad::BUTTON_START, ReportEncoder::at(0, PS3::Buttons0::START)    },
+    { Gamepad::BUTTON_L3,    ReportEncoder::at(0, PS3::Buttons0::L3)       },
+    { Gamepad::BUTTON_R3,    ReportEncoder::at(0, PS3::Buttons0::R3)       },
+    { Gamepad::BUTTON_SYS,   ReportEncoder::at(2, PS3::Buttons2::SYS)      },
+    { Gamepad::BUTTON_MISC,  ReportEncoder::at(2, PS3::Buttons2::TP)       },
+};
+
+//All 3 button bytes, dpad bits in the first, L2/R2 set by the triggers
+static constexpr auto ENCODER = ReportEncoder::make<uint32_t>(BUTTONS,
+    ReportEncoder::dpad_bits(PS3::Buttons0::DPAD_UP, PS3::Buttons0::DPAD_DOWN, PS3::Buttons0::DPAD_LEFT, PS3::Buttons0::DPAD_RIGHT),
+    ReportEncoder::at(1, PS3::Buttons1::L2), ReportEncoder::at(1, PS3::Buttons1::R2));
 
 void PS3Device::initialize() 
 {
@@ -25,51 +47,8 @@ void PS3Device::process(const uint8_t idx, Gamepad& gamepad)
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
         report_in_ = PS3::InReport();
 
-        switch (gp_in.dpad)
-        {
-            case Gamepad::DPAD_UP:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_UP | PS3::Buttons0::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                report_in_.buttons[0] = PS3::Buttons0::DPAD_DOWN | PS3::Buttons0::DPAD_RIGHT;
-                break;
-            default:
-                break;
-        }
-
-        if (gp_in.buttons & Gamepad::BUTTON_X)        report_in_.buttons[1] |= PS3::Buttons1::SQUARE;
-        if (gp_in.buttons & Gamepad::BUTTON_A)        report_in_.buttons[1] |= PS3::Buttons1::CROSS;
-        if (gp_in.buttons & Gamepad::BUTTON_Y)        report_in_.buttons[1] |= PS3::Buttons1::TRIANGLE;
-        if (gp_in.buttons & Gamepad::BUTTON_B)        report_in_.buttons[1] |= PS3::Buttons1::CIRCLE;
-        if (gp_in.buttons & Gamepad::BUTTON_LB)       report_in_.buttons[1] |= PS3::Buttons1::L1;
-        if (gp_in.buttons & Gamepad::BUTTON_RB)       report_in_.buttons[1] |= PS3::Buttons1::R1;
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)     report_in_.buttons[0] |= PS3::Buttons0::SELECT;
-        if (gp_in.buttons & Gamepad::BUTTON_START)    report_in_.buttons[0] |= PS3::Buttons0::START;
-        if (gp_in.buttons & Gamepad::BUTTON_L3)       report_in_.buttons[0] |= PS3::Buttons0::L3;
-        if (gp_in.buttons & Gamepad::BUTTON_R3)       report_in_.buttons[0] |= PS3::Buttons0::R3;
-        if (gp_in.buttons & Gamepad::BUTTON_SYS)      report_in_.buttons[2] |= PS3::Buttons2::SYS;
-        if (gp_in.buttons & Gamepad::BUTTON_MISC)     report_in_.buttons[2] |= PS3::Buttons2::TP;
-
-        if (gp_in.trigger_l) report_in_.buttons[1] |= PS3::Buttons1::L2;
-        if (gp_in.trigger_r) report_in_.buttons[1] |= PS3::Buttons1::R2;
+        const uint32_t buttons = ENCODER.encode(gp_in);
+        std::memcpy(report_in_.buttons, &buttons, sizeof(report_in_.buttons));
 
         report_in_.joystick_lx = Scale::int16_to_uint8(gp_in.joystick_lx);
         report_in_.joystick_ly = Scale::int16_to_uint8(gp_in.joystick_ly);
@@ -113,10 +92,11 @@ void PS3Device::process(const uint8_t idx, Gamepad& gamepad)
         tud_remote_wakeup();
     }
 
-    if (tud_hid_ready())
+    //PS3 seems to start using stale data if a report isn't sent every frame
+    if (tud_hid_ready() &&
+        tud_hid_report(0, reinterpret_cast<uint8_t*>(&report_in_), sizeof(PS3::InReport)))
     {
-        //PS3 seems to start using stale data if a report isn't sent every frame
-        tud_hid_report(0, reinterpret_cast<uint8_t*>(&report_in_), sizeof(PS3::InReport));
+        gamepad.record_latency();
     }
 
     if (new_report_out_)
@@ -1,6 +1,25 @@
 #include <cstring>
 
 #include "USBDevice/DeviceDriver/PSClassic/PSClassic.h"
+#include "USBDevice/DeviceDriver/ReportEncoder.h"
+
+static constexpr ReportEncoder::ButtonBit BUTTONS[] =
+{
+    { Gamepad::BUTTON_A,     PSClassic::Buttons::CROSS    },
+    { Gamepad::BUTTON_B,     PSClassic::Buttons::CIRCLE   },
+    { Gamepad::BUTTON_X,     PSClassic::Buttons::SQUARE   },
+    { Gamepad::BUTTON_Y,     PSClassic::Buttons::TRIANGLE },
+    { Gamepad::BUTTON_LB,    PSClassic::Buttons::L1       },
+    { Gamepad::BUTTON_RB,    PSClassic::Buttons::R1       },
+    { Gamepad::BUTTON_BACK,  PSClassic::Buttons::SELECT   },
+    { Gamepad::BUTTON_START, PSClassic::Buttons::START    },
+};
+
+//The dpad is a value in the button field, the sticks can override it so it's encoded separately
+static constexpr auto ENCODER = ReportEncoder::make<uint16_t>(BUTTONS,
+    { PSClassic::Buttons::UP, PSClassic::Buttons::DOWN, PSClassic::Buttons::LEFT, PSClassic::Buttons::RIGHT,
+      PSClassic::Buttons::UP_LEFT, PSClassic::Buttons::UP_RIGHT, PSClassic::Buttons::DOWN_LEFT, PSClassic::Buttons::DOWN_RIGHT, PSClassic::Buttons::CENTER },
+    PSClassic::Buttons::L2, PSClassic::Buttons::R2);
 
 void PSClassicDevice::initialize()
 {
@@ -22,36 +41,7 @@ void PSClassicDevice::process(const uint8_t idx, Gamepad& gamepad)
     if (gamepad.new_pad_in())
     {
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
-        switch (gp_in.dpad)
-        {
-            case Gamepad::DPAD_UP:
-                in_report_.buttons = PSClassic::Buttons::UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                in_report_.buttons = PSClassic::Buttons::DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                in_report_.buttons = PSClassic::Buttons::LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                in_report_.buttons = PSClassic::Buttons::RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                in_report_.buttons = PSClassic::Buttons::UP_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                in_report_.buttons = PSClassic::Buttons::UP_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                in_report_.buttons = PSClassic::Buttons::DOWN_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                in_report_.buttons = PSClassic::Buttons::DOWN_RIGHT;
-                break;
-            default:
-                in_report_.buttons = PSClassic::Buttons::CENTER;
-                break;
-        }
+        in_report_.buttons = ENCODER.dpad(gp_in);
 
         int16_t joy_lx = gp_in.joystick_lx;
         int16_t joy_ly = Range::invert(gp_in.joystick_ly);
@@ -97,26 +87,17 @@ void PSClassicDevice::process(const uint8_t idx, Gamepad& gamepad)
             in_report_.buttons = PSClassic::Buttons::UP;
         }
 
-        if (gp_in.buttons & Gamepad::BUTTON_A) in_report_.buttons |= PSClassic::Buttons::CROSS;
-        if (gp_in.buttons & Gamepad::BUTTON_B) in_report_.buttons |= PSClassic::Buttons::CIRCLE;
-        if (gp_in.buttons & Gamepad::BUTTON_X) in_report_.buttons |= PSClassic::Buttons::SQUARE;
-        if (gp_in.buttons & Gamepad::BUTTON_Y) in_report_.buttons |= PSClassic::Buttons::TRIANGLE;
-        if (gp_in.buttons & Gamepad::BUTTON_LB)    in_report_.buttons |= PSClassic::Buttons::L1;
-        if (gp_in.buttons & Gamepad::BUTTON_RB)    in_report_.buttons |= PSClassic::Buttons::R1;
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report_.buttons |= PSClassic::Buttons::SELECT;
-        if (gp_in.buttons & Gamepad::BUTTON_START) in_report_.buttons |= PSClassic::Buttons::START;
-        
-        if (gp_in.trigger_l) in_report_.buttons |= PSClassic::Buttons::L2;
-        if (gp_in.trigger_r) in_report_.buttons |= PSClassic::Buttons::R2;
+        in_report_.buttons |= ENCODER.buttons(gp_in);
     }
 
     if (tud_suspended())
     {
         tud_remote_wakeup();
     }
-    if (tud_hid_n_ready(idx))
+    if (tud_hid_n_ready(idx) &&
+        tud_hid_n_report(idx, 0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(PSClassic::InReport)))
     {
-        tud_hid_n_report(idx, 0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(PSClassic::InReport));
+        gamepad.record_latency();
     }
 }
 
@@ -0,0 +1,126 @@
+#ifndef _REPORT_ENCODER_H_
+#define _REPORT_ENCODER_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "Gamepad/Gamepad.h"
+
+//Button and dpad encoding shared by the device drivers. Each driver describes its report format once
+//(which report bits every Gamepad button sets, what its dpad/hat value is for each direction) and
+//ReportEncoder::make() turns that into lookup tables at compile time, so encoding a frame is a few
+//table loads and ORs with no branches on the buttons.
+namespace ReportEncoder
+{
+    //Mask of one byte of a multi byte button field, byte 0 ends up in the low bits (written little endian)
+    constexpr uint32_t at(uint8_t byte, uint32_t mask)
+    {
+        return mask << (byte * 8);
+    }
+
+    struct ButtonBit
+    {
+        uint16_t gamepad;   //Gamepad::BUTTON_*
+        uint32_t report;    //Report bits it sets
+    };
+
+    //Report value for each Gamepad::DPAD_* direction, none is also used for impossible combinations (up + down)
+    struct DPadLayout
+    {
+        uint32_t up;
+        uint32_t down;
+        uint32_t left;
+        uint32_t right;
+        uint32_t up_left;
+        uint32_t up_right;
+        uint32_t down_left;
+        uint32_t down_right;
+        uint32_t none;
+    };
+
+    //Bitmask dpads (one report bit per direction) and hat switches both fit a DPadLayout
+    constexpr DPadLayout dpad_bits(uint32_t up, uint32_t down, uint32_t left, uint32_t right)
+    {
+        return { up, down, left, right, up | left, up | right, down | left, down | right, 0 };
+    }
+
+    template <typename Word>
+    class Encoder
+    {
+    public:
+        //Gamepad buttons span 12 bits, one table per nibble
+        static constexpr size_t NIBBLES = 3;
+
+        template <size_t NumButtons>
+        constexpr Encoder(const ButtonBit (&buttons)[NumButtons], const DPadLayout& dpad, uint32_t trigger_l, uint32_t trigger_r)
+            : buttons_{}, dpad_{}, trigger_l_(static_cast<Word>(trigger_l)), trigger_r_(static_cast<Word>(trigger_r))
+        {
+            for (size_t n = 0; n < NIBBLES; ++n)
+            {
+                for (uint32_t value = 0; value < 16; ++value)
+                {
+                    Word report = 0;
+                    for (const ButtonBit& button : buttons)
+                    {
+                        if ((value << (n * 4)) & button.gamepad)
+                        {
+                            report |= static_cast<Word>(button.report);
+                        }
+                    }
+                    buttons_[n][value] = report;
+                }
+            }
+
+            for (uint8_t value = 0; value < 16; ++value)
+            {
+                dpad_[value] = static_cast<Word>(dpad.none);
+            }
+            dpad_[Gamepad::DPAD_UP]         = static_cast<Word>(dpad.up);
+            dpad_[Gamepad::DPAD_DOWN]       = static_cast<Word>(dpad.down);
+            dpad_[Gamepad::DPAD_LEFT]       = static_cast<Word>(dpad.left);
+            dpad_[Gamepad::DPAD_RIGHT]      = static_cast<Word>(dpad.right);
+            dpad_[Gamepad::DPAD_UP_LEFT]    = static_cast<Word>(dpad.up_left);
+            dpad_[Gamepad::DPAD_UP_RIGHT]   = static_cast<Word>(dpad.up_right);
+            dpad_[Gamepad::DPAD_DOWN_LEFT]  = static_cast<Word>(dpad.down_left);
+            dpad_[Gamepad::DPAD_DOWN_RIGHT] = static_cast<Word>(dpad.down_right);
+        }
+
+        //Buttons, plus the trigger bits for formats with digital triggers
+        inline Word buttons(const Gamepad::PadIn& gp_in) const
+        {
+            return  buttons_[0][gp_in.buttons & 0x0F] |
+                    buttons_[1][(gp_in.buttons >> 4) & 0x0F] |
+                    buttons_[2][(gp_in.buttons >> 8) & 0x0F] |
+                    (trigger_l_ & static_cast<Word>(-static_cast<int32_t>(gp_in.trigger_l != 0))) |
+                    (trigger_r_ & static_cast<Word>(-static_cast<int32_t>(gp_in.trigger_r != 0)));
+        }
+
+        inline Word dpad(const Gamepad::PadIn& gp_in) const
+        {
+            return dpad_[gp_in.dpad & 0x0F];
+        }
+
+        //For formats with the dpad in the button field
+        inline Word encode(const Gamepad::PadIn& gp_in) const
+        {
+            return buttons(gp_in) | dpad(gp_in);
+        }
+
+    private:
+        std::array<std::array<Word, 16>, NIBBLES> buttons_;
+        std::array<Word, 16> dpad_;
+        Word trigger_l_;
+        Word trigger_r_;
+    };
+
+    //Word is the smallest type that holds the report's button field, drivers keep the result as a static constexpr
+    template <typename Word, size_t NumButtons>
+    constexpr Encoder<Word> make(const ButtonBit (&buttons)[NumButtons], const DPadLayout& dpad, uint32_t trigger_l = 0, uint32_t trigger_r = 0)
+    {
+        return Encoder<Word>(buttons, dpad, trigger_l, trigger_r);
+    }
+
+} // namespace ReportEncoder
+
+#endif // _REPORT_ENCODER_H_
@@ -2,8 +2,10 @@
 #include "bsp/board_api.h"
 
 #include "Board/ogxm_log.h"
+#include "TaskQueue/TaskQueue.h"
 #include "Descriptors/CDCDev.h"
 #include "USBDevice/DeviceDriver/WebApp/WebApp.h"
+#include "USBDevice/stats_snapshot.h"
 
 void WebAppDevice::initialize() 
 {
@@ -180,14 +182,15 @@ bool WebAppDevice::write_profile(uint8_t index, const UserProfile& profile, Pack
     return true;
 }
 
-bool WebAppDevice::write_gamepad(uint8_t index, const Gamepad::PadIn& pad_in)
+bool WebAppDevice::write_chunks(uint8_t index, PacketID packet_id, const void* data, size_t len, DeviceDriverType driver)
 {
     Packet packet_in;
-    const uint8_t* pad_in_data = reinterpret_cast<const uint8_t*>(&pad_in);
-    const uint8_t total_chunks = static_cast<uint8_t>((sizeof(Gamepad::PadIn) + packet_in.data.size() - 1) / packet_in.data.size());
+    const uint8_t* chunk_data = reinterpret_cast<const uint8_t*>(data);
+    const uint8_t total_chunks = static_cast<uint8_t>((len + packet_in.data.size() - 1) / packet_in.data.size());
     uint8_t current_chunk = 0;
 
-    packet_in.header.packet_id = PacketID::SET_GP_IN;
+    packet_in.header.packet_id = packet_id;
+    packet_in.header.device_driver = driver;
     packet_in.header.max_gamepads = MAX_GAMEPADS;
     packet_in.header.player_idx = index;
     packet_in.header.chunks_total = total_chunks;
@@ -195,13 +198,13 @@ bool WebAppDevice::write_gamepad(uint8_t index, const Gamepad::PadIn& pad_in)
     while (current_chunk < total_chunks)
     {
         size_t offset = current_chunk * packet_in.data.size();
-        size_t remaining_bytes = sizeof(Gamepad::PadIn) - offset;
+        size_t remaining_bytes = len - offset;
         uint8_t current_chunk_len = static_cast<uint8_t>(std::min(packet_in.data.size(), remaining_bytes));
 
         packet_in.header.chunk_idx = current_chunk;
         packet_in.header.chunk_len = current_chunk_len;
 
-        std::memcpy(packet_in.data.data(), pad_in_data + offset, packet_in.header.chunk_len);
+        std::memcpy(packet_in.data.data(), chunk_data + offset, packet_in.header.chunk_len);
 
         if (!write_packet(packet_in))
         {
@@ -212,6 +215,47 @@ bool WebAppDevice::write_gamepad(uint8_t index, const Gamepad::PadIn& pad_in)
     return true;
 }
 
+bool WebAppDevice::write_gamepad(uint8_t index, const Gamepad::PadIn& pad_in)
+{
+    return write_chunks(index, PacketID::SET_GP_IN, &pad_in, sizeof(Gamepad::PadIn));
+}
+
+bool WebAppDevice::write_latency(uint8_t index, DeviceDriverType driver, const LatencyHistogram& latency)
+{
+    return write_chunks(index, PacketID::GET_LATENCY, &latency, sizeof(LatencyHistogram), driver);
+}
+
+//WEBAPP reads the live histogram, any other driver the one the driver before the WebApp left
+bool WebAppDevice::write_latency(uint8_t index, const PacketHeader& request, Gamepad& gamepad)
+{
+    const bool reset = (request.packet_id == PacketID::RESET_LATENCY);
+
+    if (request.device_driver == DeviceDriverType::WEBAPP)
+    {
+        if (reset)
+        {
+            gamepad.reset_latency();
+        }
+        return write_latency(index, DeviceDriverType::WEBAPP, gamepad.get_latency());
+    }
+
+    stats_snapshot::Snapshot* snapshot = stats_snapshot::previous();
+    if (snapshot == nullptr)
+    {
+        return false;
+    }
+    if (reset)
+    {
+        snapshot->latency[index].reset();
+    }
+    return write_latency(index, snapshot->driver, snapshot->latency[index]);
+}
+
+bool WebAppDevice::write_pad_stats(uint8_t index, const Gamepad::PadInStats& stats)
+{
+    return write_chunks(index, PacketID::GET_PAD_STATS, &stats, sizeof(Gamepad::PadInStats));
+}
+
 void WebAppDevice::write_error()
 {
     Packet packet_in;
@@ -231,6 +275,22 @@ void WebAppDevice::process(const uint8_t idx, Gamepad& gamepad)
     bool success = false;   
     static Packet packet_out;
 
+    //Gamepad requests are answered from the call that owns the requested gamepad
+    if (gamepad_request_.packet_id != PacketID::NONE && gamepad_request_.player_idx == idx)
+    {
+        const PacketHeader request = gamepad_request_;
+        gamepad_request_.packet_id = PacketID::NONE;
+
+        success = (request.packet_id == PacketID::GET_PAD_STATS) 
+                    ? write_pad_stats(idx, gamepad.get_pad_in_stats())
+                    : write_latency(idx, request, gamepad);
+        if (!success)
+        {
+            write_error();
+            return;
+        }
+    }
+
     if (tud_cdc_available())
     {
         OGXM_LOG("Reading packet\n");
@@ -289,16 +349,123 @@ void WebAppDevice::process(const uint8_t idx, Gamepad& gamepad)
                 }
                 break;
 
+            //device_driver selects the driver. The measured rate is zero unless it's the driver the WebApp replaced
+            //and the build has CONFIG_OGXM_POLL_STATS
+            case PacketID::GET_POLL_RATE:
+            {
+                const DeviceDriverType driver = packet_out.header.device_driver;
+                if (driver == DeviceDriverType::WEBAPP || !user_settings_.is_valid_driver(driver))
+                {
+                    write_error();
+                    return;
+                }
+                PollRate rate;
+                rate.interval_ms = user_settings_.get_poll_interval(driver);
+                rate.choices = poll_rate::get_choices(driver);
+#if defined(CONFIG_OGXM_POLL_STATS)
+                //Measured while that driver ran, before the reboot into the WebApp
+                const stats_snapshot::Snapshot* snapshot = stats_snapshot::previous();
+                if (snapshot != nullptr && snapshot->driver == driver)
+                {
+                    rate.measured = snapshot->poll;
+                }
+#endif
+                if (!write_chunks(0, PacketID::GET_POLL_RATE, &rate, sizeof(PollRate)))
+                {
+                    write_error();
+                    return;
+                }
+                break;
+            }
+
+            //Reboots once stored, same as a profile
+            case PacketID::SET_POLL_RATE:
+                if (packet_out.header.device_driver == DeviceDriverType::WEBAPP ||
+                    !user_settings_.store_poll_interval(packet_out.header.device_driver, packet_out.data[0]))
+                {
+                    write_error();
+                    return;
+                }
+                break;
+
+            //player_idx selects the core, only available in builds with CONFIG_OGXM_TASK_STATS.
+            //device_driver picks the live or the previous driver's stats, like GET_LATENCY
+            case PacketID::GET_TASK_STATS:
+            {
+#if defined(CONFIG_OGXM_TASK_STATS)
+                TaskStats stats;
+                DeviceDriverType stats_driver = DeviceDriverType::WEBAPP;
+                if (packet_out.header.device_driver != DeviceDriverType::WEBAPP)
+                {
+                    const stats_snapshot::Snapshot* snapshot = stats_snapshot::previous();
+                    if (snapshot == nullptr || packet_out.header.player_idx >= snapshot->tasks.size())
+                    {
+                        write_error();
+                        return;
+                    }
+                    stats = snapshot->tasks[packet_out.header.player_idx];
+                    stats_driver = snapshot->driver;
+                }
+                else if (packet_out.header.player_idx == 0)
+                {
+                    stats = TaskQueue::Core0::get_stats();
+                }
+    #if (OGXM_BOARD != PI_PICOW)
+                else if (packet_out.header.player_idx == 1)
+                {
+                    stats = TaskQueue::Core1::get_stats();
+                }
+    #endif
+                else
+                {
+                    write_error();
+                    return;
+                }
+                if (!write_chunks(packet_out.header.player_idx, PacketID::GET_TASK_STATS, &stats, sizeof(TaskStats), stats_driver))
+                {
+                    write_error();
+                    return;
+                }
+#else
+                write_error();
+                return;
+#endif
+                break;
+            }
+
+            case PacketID::GET_LATENCY:
+            case PacketID::RESET_LATENCY:
+            case PacketID::GET_PAD_STATS:
+                if (packet_out.header.player_idx >= MAX_GAMEPADS)
+                {
+                    write_error();
+                    return;
+                }
+                gamepad_request_ = packet_out.header;
+                break;
+
             default:
                 // write_response(PacketID::RESP_ERROR);
                 return;
         }
     } 
-    else if (gamepad.new_pad_in())
+    else
     {
-        OGXM_LOG("Writing gamepad input\n");
-        Gamepad::PadIn gp_in = gamepad.get_pad_in();
-        write_gamepad(idx, gp_in);
+        //Unchanged input doesn't flag new_pad_in() again, keep the last one until it's written
+        if (gamepad.new_pad_in())
+        {
+            pad_in_[idx] = gamepad.get_pad_in();
+            report_pending_[idx] = true;
+        }
+        if (report_pending_[idx])
+        {
+            OGXM_LOG("Writing gamepad input\n");
+            if (write_gamepad(idx, pad_in_[idx]))
+            {
+                report_pending_[idx] = false;
+                gamepad.record_latency();
+            }
+        }
     }
 }
 
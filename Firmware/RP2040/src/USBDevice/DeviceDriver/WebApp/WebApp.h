@@ -4,6 +4,7 @@
 #include <array>
 
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
+#include "USBDevice/poll_rate.h"
 #include "UserSettings/UserSettings.h"
 #include "UserSettings/UserProfile.h"
 
@@ -29,8 +30,17 @@ private:
         GET_PROFILE_BY_IDX = 0x55,
         SET_PROFILE_START = 0x60,
         SET_PROFILE = 0x61,
+        GET_POLL_RATE = 0x70,
+        SET_POLL_RATE = 0x71,
         SET_GP_IN = 0x80,
         SET_GP_OUT = 0x81,
+        //device_driver WEBAPP reads the WebApp's own histograms, any other driver reads the ones
+        //the driver before the WebApp left (see stats_snapshot), the response names that driver
+        GET_LATENCY = 0x90,
+        RESET_LATENCY = 0x91,
+        GET_PAD_STATS = 0x92,
+        //player_idx is the core, device_driver works as for GET_LATENCY
+        GET_TASK_STATS = 0x93,
         RESP_ERROR = 0xFF
     };
     
@@ -55,10 +65,20 @@ private:
         std::array<uint8_t, 64 - sizeof(PacketHeader)> data{0};
     };
     static_assert(sizeof(Packet) == 64, "WebApp report size mismatch");
+
+    struct PollRate
+    {
+        uint8_t interval_ms{0};         //0 if the driver uses its descriptor's rate
+        poll_rate::Choices choices{0};  //Whitelist for the driver, zero padded
+        poll_rate::Measurement measured; //Host's poll rate the last time the driver ran, zero if unknown
+    };
     #pragma pack(pop)
 
     UserSettings& user_settings_{UserSettings::get_instance()};
     UserProfile profile_;
+    PacketHeader gamepad_request_;
+    std::array<Gamepad::PadIn, MAX_GAMEPADS> pad_in_;
+    std::array<bool, MAX_GAMEPADS> report_pending_{};
 
     bool read_profile(UserProfile& profile);
     bool read_serial(void* buffer, size_t len, bool block);
@@ -66,7 +86,11 @@ private:
     bool write_serial(const void* buffer, size_t len);
     bool write_packet(const Packet& packet);
     bool write_profile(uint8_t index, const UserProfile& profile, PacketID packet_id);
+    bool write_chunks(uint8_t index, PacketID packet_id, const void* data, size_t len, DeviceDriverType driver = DeviceDriverType::WEBAPP);
     bool write_gamepad(uint8_t index, const Gamepad::PadIn& pad_in);
+    bool write_latency(uint8_t index, DeviceDriverType driver, const LatencyHistogram& latency);
+    bool write_latency(uint8_t index, const PacketHeader& request, Gamepad& gamepad);
+    bool write_pad_stats(uint8_t index, const Gamepad::PadInStats& stats);
     void write_error();  
 };
 
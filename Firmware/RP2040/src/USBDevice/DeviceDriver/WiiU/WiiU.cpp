@@ -100,11 +100,17 @@ void WiiUDevice::process(const uint8_t idx, Gamepad& gamepad)
 	if (idx >= 4)
 		return;
 
-	// Always update from current gamepad state so late controller connections are reflected immediately.
-	// Dolphin may stop re-checking after seeing initial zeros; filling every frame avoids that.
-	// Combo check (check_for_driver_change) also uses get_pad_in(); both see the same current state.
-	Gamepad::PadIn gp_in = gamepad.get_pad_in();
-	fill_port_block(in_report_.port_data[idx], gp_in, gamepad.stick_y_positive_is_up());
+	// Port blocks persist in in_report_ and the report is still sent every frame (Dolphin may stop
+	// re-checking after seeing initial zeros), so a port only needs re-encoding when its state changed.
+	// A late controller connection sets the Y orientation before its first report, re-encode on that too.
+	const bool stick_y_positive_is_up = gamepad.stick_y_positive_is_up();
+	if (gamepad.new_pad_in() || !port_gamepads_[idx] || port_y_up_[idx] != stick_y_positive_is_up)
+	{
+		Gamepad::PadIn gp_in = gamepad.get_pad_in();
+		fill_port_block(in_report_.port_data[idx], gp_in, stick_y_positive_is_up);
+		port_y_up_[idx] = stick_y_positive_is_up;
+		port_gamepads_[idx] = &gamepad;
+	}
 
 	if (tud_suspended())
 		tud_remote_wakeup();
@@ -115,7 +121,14 @@ void WiiUDevice::process(const uint8_t idx, Gamepad& gamepad)
 	if (idx == last_port && (WIIU_SKIP_INIT_GATE || init_received_) && tud_hid_n_ready(0))
 	{
 		// TinyUSB prepends report_id; pass only port_data (36 bytes) to avoid double report ID
-		tud_hid_n_report(0, WiiU::HID_REPORT_ID, in_report_.port_data, sizeof(in_report_.port_data));
+		if (tud_hid_n_report(0, WiiU::HID_REPORT_ID, in_report_.port_data, sizeof(in_report_.port_data)))
+		{
+			for (Gamepad* port_gamepad : port_gamepads_)
+			{
+				if (port_gamepad)
+					port_gamepad->record_latency();
+			}
+		}
 #if defined(CONFIG_OGXM_DEBUG)
 		static uint32_t send_count = 0;
 		if (++send_count % 500 == 0)
@@ -2,6 +2,7 @@
 #define _WIIU_DEVICE_H_
 
 #include <cstdint>
+#include <array>
 
 #include "USBDevice/DeviceDriver/DeviceDriver.h"
 #include "Descriptors/WiiU.h"
@@ -23,6 +24,8 @@ public:
 private:
     WiiU::InReport in_report_{};
     bool init_received_{ false };  // true after host sends Start Polling (0x13)
+    std::array<Gamepad*, 4> port_gamepads_{};  // Latency is recorded for every port when the shared report goes out
+    std::array<bool, 4> port_y_up_{};           // Y orientation each port block was last encoded with
 };
 
 #endif // _WIIU_DEVICE_H_
@@ -2,6 +2,26 @@
 
 #include "USBDevice/DeviceDriver/XInput/tud_xinput/tud_xinput.h"
 #include "USBDevice/DeviceDriver/XInput/XInput.h"
+#include "USBDevice/DeviceDriver/ReportEncoder.h"
+
+static constexpr ReportEncoder::ButtonBit BUTTONS[] =
+{
+    { Gamepad::BUTTON_BACK,  ReportEncoder::at(0, XInput::Buttons0::BACK)  },
+    { Gamepad::BUTTON_START, ReportEncoder::at(0, XInput::Buttons0::START) },
+    { Gamepad::BUTTON_L3,    ReportEncoder::at(0, XInput::Buttons0::L3)    },
+    { Gamepad::BUTTON_R3,    ReportEncoder::at(0, XInput::Buttons0::R3)    },
+    { Gamepad::BUTTON_X,     ReportEncoder::at(1, XInput::Buttons1::X)     },
+    { Gamepad::BUTTON_A,     ReportEncoder::at(1, XInput::Buttons1::A)     },
+    { Gamepad::BUTTON_Y,     ReportEncoder::at(1, XInput::Buttons1::Y)     },
+    { Gamepad::BUTTON_B,     ReportEncoder::at(1, XInput::Buttons1::B)     },
+    { Gamepad::BUTTON_LB,    ReportEncoder::at(1, XInput::Buttons1::LB)    },
+    { Gamepad::BUTTON_RB,    ReportEncoder::at(1, XInput::Buttons1::RB)    },
+    { Gamepad::BUTTON_SYS,   ReportEncoder::at(1, XInput::Buttons1::HOME)  },
+};
+
+//Both button bytes, dpad bits in the first
+static constexpr auto ENCODER = ReportEncoder::make<uint16_t>(BUTTONS,
+    ReportEncoder::dpad_bits(XInput::Buttons0::DPAD_UP, XInput::Buttons0::DPAD_DOWN, XInput::Buttons0::DPAD_LEFT, XInput::Buttons0::DPAD_RIGHT));
 
 void XInputDevice::initialize()
 {
@@ -12,53 +32,10 @@ void XInputDevice::process(const uint8_t idx, Gamepad& gamepad)
 {
     if (gamepad.new_pad_in())
     {
-        in_report_.buttons[0] = 0;
-        in_report_.buttons[1] = 0;
-
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
 
-        switch (gp_in.dpad)
-        {
-            case Gamepad::DPAD_UP:
-                in_report_.buttons[0] = XInput::Buttons0::DPAD_UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                in_report_.buttons[0] = XInput::Buttons0::DPAD_DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                in_report_.buttons[0] = XInput::Buttons0::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                in_report_.buttons[0] = XInput::Buttons0::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                in_report_.buttons[0] = XInput::Buttons0::DPAD_UP | XInput::Buttons0::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                in_report_.buttons[0] = XInput::Buttons0::DPAD_UP | XInput::Buttons0::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                in_report_.buttons[0] = XInput::Buttons0::DPAD_DOWN | XInput::Buttons0::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                in_report_.buttons[0] = XInput::Buttons0::DPAD_DOWN | XInput::Buttons0::DPAD_RIGHT;
-                break;
-            default:
-                break;
-        }
-
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)  in_report_.buttons[0] |= XInput::Buttons0::BACK;
-        if (gp_in.buttons & Gamepad::BUTTON_START) in_report_.buttons[0] |= XInput::Buttons0::START;
-        if (gp_in.buttons & Gamepad::BUTTON_L3)    in_report_.buttons[0] |= XInput::Buttons0::L3;
-        if (gp_in.buttons & Gamepad::BUTTON_R3)    in_report_.buttons[0] |= XInput::Buttons0::R3;
-
-        if (gp_in.buttons & Gamepad::BUTTON_X)     in_report_.buttons[1] |= XInput::Buttons1::X;
-        if (gp_in.buttons & Gamepad::BUTTON_A)     in_report_.buttons[1] |= XInput::Buttons1::A;
-        if (gp_in.buttons & Gamepad::BUTTON_Y)     in_report_.buttons[1] |= XInput::Buttons1::Y;
-        if (gp_in.buttons & Gamepad::BUTTON_B)     in_report_.buttons[1] |= XInput::Buttons1::B;
-        if (gp_in.buttons & Gamepad::BUTTON_LB)    in_report_.buttons[1] |= XInput::Buttons1::LB;
-        if (gp_in.buttons & Gamepad::BUTTON_RB)    in_report_.buttons[1] |= XInput::Buttons1::RB;
-        if (gp_in.buttons & Gamepad::BUTTON_SYS)   in_report_.buttons[1] |= XInput::Buttons1::HOME;
+        const uint16_t buttons = ENCODER.encode(gp_in);
+        std::memcpy(in_report_.buttons, &buttons, sizeof(in_report_.buttons));
 
         in_report_.trigger_l = gp_in.trigger_l;
         in_report_.trigger_r = gp_in.trigger_r;
@@ -68,12 +45,22 @@ void XInputDevice::process(const uint8_t idx, Gamepad& gamepad)
         in_report_.joystick_rx = gp_in.joystick_rx;
         in_report_.joystick_ry = Range::invert(gp_in.joystick_ry);
 
+        report_pending_ = true;
+    }
+
+    //Unchanged input doesn't flag new_pad_in() again, retry until the endpoint takes the report
+    if (report_pending_)
+    {
         if (tud_suspended())
         {
             tud_remote_wakeup();
         }
 
-        tud_xinput::send_report((uint8_t*)&in_report_, sizeof(XInput::InReport));
+        if (tud_xinput::send_report((uint8_t*)&in_report_, sizeof(XInput::InReport)))
+        {
+            report_pending_ = false;
+            gamepad.record_latency();
+        }
     }
 
     if (tud_xinput::receive_report(reinterpret_cast<uint8_t*>(&out_report_), sizeof(XInput::OutReport)) &&
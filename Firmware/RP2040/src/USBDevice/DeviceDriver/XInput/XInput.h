@@ -21,6 +21,7 @@ public:
 private:
     XInput::InReport in_report_;
     XInput::OutReport out_report_;
+    bool report_pending_{false};
 };
 
 #endif // _XINPUT_DEVICE_H_
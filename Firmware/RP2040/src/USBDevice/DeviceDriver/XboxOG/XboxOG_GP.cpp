@@ -3,6 +3,19 @@
 
 #include "USBDevice/DeviceDriver/XboxOG/tud_xid/tud_xid.h"
 #include "USBDevice/DeviceDriver/XboxOG/XboxOG_GP.h"
+#include "USBDevice/DeviceDriver/ReportEncoder.h"
+
+static constexpr ReportEncoder::ButtonBit BUTTONS[] =
+{
+    { Gamepad::BUTTON_BACK,  XboxOG::GP::Buttons::BACK  },
+    { Gamepad::BUTTON_START, XboxOG::GP::Buttons::START },
+    { Gamepad::BUTTON_L3,    XboxOG::GP::Buttons::L3    },
+    { Gamepad::BUTTON_R3,    XboxOG::GP::Buttons::R3    },
+};
+
+//Only the digital buttons, face and shoulder buttons are analog bytes
+static constexpr auto ENCODER = ReportEncoder::make<uint8_t>(BUTTONS,
+    ReportEncoder::dpad_bits(XboxOG::GP::Buttons::DPAD_UP, XboxOG::GP::Buttons::DPAD_DOWN, XboxOG::GP::Buttons::DPAD_LEFT, XboxOG::GP::Buttons::DPAD_RIGHT));
 
 void XboxOGDevice::initialize() 
 {
@@ -20,40 +33,7 @@ void XboxOGDevice::process(const uint8_t idx, Gamepad& gamepad)
         std::memset(&in_report_.buttons, 0, 8);
         Gamepad::PadIn gp_in = gamepad.get_pad_in();
 
-        switch (gp_in.dpad)
-        {
-            case Gamepad::DPAD_UP:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_UP;
-                break;
-            case Gamepad::DPAD_DOWN:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_DOWN;
-                break;
-            case Gamepad::DPAD_LEFT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_RIGHT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_UP_LEFT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_UP | XboxOG::GP::Buttons::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_UP_RIGHT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_UP | XboxOG::GP::Buttons::DPAD_RIGHT;
-                break;
-            case Gamepad::DPAD_DOWN_LEFT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_DOWN | XboxOG::GP::Buttons::DPAD_LEFT;
-                break;
-            case Gamepad::DPAD_DOWN_RIGHT:
-                in_report_.buttons = XboxOG::GP::Buttons::DPAD_DOWN | XboxOG::GP::Buttons::DPAD_RIGHT;
-                break;
-            default:
-                break;
-        }
-        
-        if (gp_in.buttons & Gamepad::BUTTON_BACK)     in_report_.buttons |= XboxOG::GP::Buttons::BACK;
-        if (gp_in.buttons & Gamepad::BUTTON_START)    in_report_.buttons |= XboxOG::GP::Buttons::START;
-        if (gp_in.buttons & Gamepad::BUTTON_L3)       in_report_.buttons |= XboxOG::GP::Buttons::L3;
-        if (gp_in.buttons & Gamepad::BUTTON_R3)       in_report_.buttons |= XboxOG::GP::Buttons::R3;
+        in_report_.buttons = ENCODER.encode(gp_in);
 
         if (gamepad.analog_enabled())
         {
@@ -82,13 +62,21 @@ void XboxOGDevice::process(const uint8_t idx, Gamepad& gamepad)
         in_report_.joystick_rx = gp_in.joystick_rx;
         in_report_.joystick_ry = Range::invert(gp_in.joystick_ry);
 
+        report_pending_ = true;
+    }
+
+    //Unchanged input doesn't flag new_pad_in() again, retry until the endpoint takes the report
+    if (report_pending_)
+    {
         if (tud_suspended())
         {
             tud_remote_wakeup();
         }
-        if (tud_xid::send_report_ready(0))
+        if (tud_xid::send_report_ready(0) &&
+            tud_xid::send_report(0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(XboxOG::GP::InReport)))
         {
-            tud_xid::send_report(0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(XboxOG::GP::InReport));
+            report_pending_ = false;
+            gamepad.record_latency();
         }
     }
 
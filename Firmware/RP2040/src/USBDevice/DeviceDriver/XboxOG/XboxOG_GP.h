@@ -23,6 +23,7 @@ public:
 private:
     XboxOG::GP::InReport in_report_;
     XboxOG::GP::OutReport out_report_;
+    bool report_pending_{false};
 };
 
 #endif // _XBOXGOG_DEVICE_H_
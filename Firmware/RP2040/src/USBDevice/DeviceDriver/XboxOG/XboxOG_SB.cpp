@@ -282,6 +282,7 @@ void XboxOGSBDevice::process(const uint8_t idx, Gamepad& gamepad)
         tud_xid::send_report(0, reinterpret_cast<uint8_t*>(&in_report_), sizeof(XboxOG::SB::InReport)))
     {
         std::memcpy(&prev_in_report_, &in_report_, sizeof(XboxOG::SB::InReport));
+        gamepad.record_latency();
     }
 
     if (chatpad_pressed(gp_in_chatpad, XInput::Chatpad::CODE_ORANGE))
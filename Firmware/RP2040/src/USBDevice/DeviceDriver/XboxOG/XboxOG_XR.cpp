@@ -23,7 +23,12 @@ void XboxOGXRDevice::process(const uint8_t idx, Gamepad& gamepad)
     uint32_t time_elapsed = board_api::ms_since_boot() - ms_timer_;
     uint8_t index = tud_xid::get_index_by_type(0, tud_xid::Type::XREMOTE);
 
-    if (index == 0xFF || !gamepad.new_pad_in() || time_elapsed < 64)
+    if (index == 0xFF || time_elapsed < 64)
+    {
+        return;
+    }
+    //Unchanged input no longer flags new_pad_in(), keep repeating held buttons like the real remote
+    if (!gamepad.new_pad_in() && in_report_.buttonCode == 0x0000)
     {
         return;
     }
@@ -72,6 +77,7 @@ void XboxOGXRDevice::process(const uint8_t idx, Gamepad& gamepad)
         tud_xid::send_report(index, reinterpret_cast<uint8_t*>(&in_report_), sizeof(XboxOG::XR::InReport)))
     {
         ms_timer_ = board_api::ms_since_boot();
+        gamepad.record_latency();
     }
 }
 
@@ -12,6 +12,11 @@
 #include "USBDevice/DeviceDriver/XboxOG/XboxOG_XR.h"
 #include "USBDevice/DeviceDriver/WebApp/WebApp.h"
 #include "USBDevice/DeviceManager.h"
+#include "USBDevice/sof_sync.h"
+#include "USBDevice/poll_rate.h"
+#include "USBDevice/stats_log.h"
+#include "USBDevice/stats_snapshot.h"
+#include "UserSettings/UserSettings.h"
 
 #if defined(CONFIG_EN_UART_BRIDGE)
 #include "USBDevice/DeviceDriver/UARTBridge/UARTBridge.h"
@@ -85,4 +90,22 @@ void DeviceManager::initialize_driver(  DeviceDriverType driver_type,
     }
 
     device_driver_->initialize();
+
+#if defined(CONFIG_OGXM_SOF_SYNC)
+    device_driver_->set_sof_cb(sof_sync::sof_cb);
+#endif // defined(CONFIG_OGXM_SOF_SYNC)
+
+#if defined(CONFIG_OGXM_POLL_STATS)
+    poll_rate::start_measuring(device_driver_->get_class_driver()->xfer_cb);
+    device_driver_->set_xfer_cb(poll_rate::xfer_cb);
+#endif // defined(CONFIG_OGXM_POLL_STATS)
+
+    stats_log::start(gamepads);
+    stats_snapshot::start(gamepads, driver_type);
+
+    poll_interval_ = UserSettings::get_instance().get_poll_interval(driver_type);
+}
+
+const uint8_t* DeviceManager::get_descriptor_configuration_cb(uint8_t index) {
+    return poll_rate::patch_configuration(device_driver_->get_descriptor_configuration_cb(index), poll_interval_);
 }
\ No newline at end of file
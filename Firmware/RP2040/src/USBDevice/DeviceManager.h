@@ -21,12 +21,16 @@ public:
 	void initialize_driver(DeviceDriverType driver_type, Gamepad(&gamepads)[MAX_GAMEPADS]);
 	
 	DeviceDriver* get_driver() { return device_driver_.get(); }
+
+	//Driver's configuration descriptor with the user's polling rate patched in
+	const uint8_t* get_descriptor_configuration_cb(uint8_t index);
 	
 private:
     DeviceManager() = default;
 	~DeviceManager() = default;
 
 	std::unique_ptr<DeviceDriver> device_driver_{nullptr};
+	uint8_t poll_interval_{0};
 };
 
 #endif // _DEVICE_MANAGER_H_
\ No newline at end of file
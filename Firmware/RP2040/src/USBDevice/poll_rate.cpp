@@ -0,0 +1,168 @@
+#include <cstring>
+#include <pico/stdlib.h>
+
+#include "Board/ogxm_log.h"
+#include "TaskQueue/TaskQueue.h"
+#include "USBDevice/poll_rate.h"
+
+namespace poll_rate {
+
+struct Whitelist
+{
+    DeviceDriverType driver;
+    Choices intervals;
+};
+
+//Original pads are 1ms except where noted, slower rates are always fine for the console,
+//faster ones only where they're known to work. Steel Battalion and XRemote stay at their own rate
+static constexpr Whitelist WHITELISTS[] =
+{
+    { DeviceDriverType::XBOXOG,    { 1, 2, 4, 8 }     }, //Duke is 4ms, 1ms overclocking is well tested on the console
+    { DeviceDriverType::XINPUT,    { 1, 2, 4, 8 }     },
+    { DeviceDriverType::PS3,       { 1, 2, 4, 8 }     },
+    { DeviceDriverType::DINPUT,    { 1, 2, 4, 8 }     },
+    { DeviceDriverType::SWITCH,    { 1, 2, 4, 8 }     },
+    { DeviceDriverType::PSCLASSIC, { 1, 2, 4, 8, 10 } }, //Pad is 10ms, the console is a Linux host
+    { DeviceDriverType::WIIU,      { 1, 2, 4, 8 }     }, //Adapter is 8ms, 1ms is the common adapter overclock
+};
+
+//Biggest configuration descriptor is DInput/Switch with 4 gamepads
+static constexpr uint16_t MAX_CONFIG_LEN = 256;
+
+Choices get_choices(DeviceDriverType driver)
+{
+    for (const auto& whitelist : WHITELISTS)
+    {
+        if (whitelist.driver == driver)
+        {
+            return whitelist.intervals;
+        }
+    }
+    return Choices{};
+}
+
+bool is_allowed(DeviceDriverType driver, uint8_t interval_ms)
+{
+    if (interval_ms == 0)
+    {
+        return true;
+    }
+    for (const uint8_t allowed : get_choices(driver))
+    {
+        if (allowed == interval_ms)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+const uint8_t* patch_configuration(const uint8_t* desc, uint8_t interval_ms)
+{
+    static uint8_t patched[MAX_CONFIG_LEN];
+
+    if (desc == nullptr || interval_ms == 0)
+    {
+        return desc;
+    }
+
+    //wTotalLength
+    const uint16_t total_len = static_cast<uint16_t>(desc[2] | (desc[3] << 8));
+    if (total_len > sizeof(patched))
+    {
+        return desc;
+    }
+    std::memcpy(patched, desc, total_len);
+
+    for (uint16_t offset = 0; offset + 2 <= total_len && patched[offset] != 0; offset += patched[offset])
+    {
+        const uint8_t* ep = &patched[offset];
+
+        if (ep[1] == TUSB_DESC_ENDPOINT && ep[0] >= 7 && offset + 7 <= total_len &&
+            (ep[2] & TUSB_DIR_IN_MASK) && (ep[3] & 0x03) == TUSB_XFER_INTERRUPT)
+        {
+            //bInterval
+            patched[offset + 6] = interval_ms;
+        }
+    }
+    return patched;
+}
+
+#if defined(CONFIG_OGXM_POLL_STATS)
+
+//The host only completes a transfer when a report is armed, so this reads the poll rate while the
+//driver keeps its endpoint busy (move a stick for drivers that only send changes)
+static constexpr uint32_t MEASURE_PERIOD_MS = 1000;
+
+static bool (*driver_xfer_cb_)(uint8_t, uint8_t, xfer_result_t, uint32_t) = nullptr;
+static uint8_t measured_ep_ = 0;
+static uint32_t transfers_ = 0;
+static uint64_t period_start_us_ = 0;
+static Measurement measurement_;
+
+void start_measuring(bool (*driver_xfer_cb)(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes))
+{
+    driver_xfer_cb_ = driver_xfer_cb;
+    period_start_us_ = time_us_64();
+
+    TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), MEASURE_PERIOD_MS, true,
+    [] {
+        const uint64_t now = time_us_64();
+        const uint32_t elapsed_us = static_cast<uint32_t>(now - period_start_us_);
+
+        measurement_.transfers = transfers_;
+        measurement_.interval_us = (transfers_ > 0) ? (elapsed_us / transfers_) : 0;
+        transfers_ = 0;
+        period_start_us_ = now;
+
+        OGXM_LOG("Host poll EP %02X: %d transfers, interval %dus\n",
+            measured_ep_, measurement_.transfers, measurement_.interval_us);
+    });
+}
+
+//Task context, same core as the TaskQueue callback above
+bool xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)
+{
+    if ((ep_addr & TUSB_DIR_IN_MASK) && result == XFER_RESULT_SUCCESS)
+    {
+        if (measured_ep_ == 0)
+        {
+            measured_ep_ = ep_addr;
+        }
+        if (ep_addr == measured_ep_)
+        {
+            ++transfers_;
+        }
+    }
+    return driver_xfer_cb_ ? driver_xfer_cb_(rhport, ep_addr, result, xferred_bytes) : false;
+}
+
+Measurement get_measurement()
+{
+    return measurement_;
+}
+
+#else // defined(CONFIG_OGXM_POLL_STATS)
+
+void start_measuring(bool (*driver_xfer_cb)(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes))
+{
+    (void)driver_xfer_cb;
+}
+
+bool xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)
+{
+    (void)rhport;
+    (void)ep_addr;
+    (void)result;
+    (void)xferred_bytes;
+    return false;
+}
+
+Measurement get_measurement()
+{
+    return Measurement();
+}
+
+#endif // defined(CONFIG_OGXM_POLL_STATS)
+
+} // namespace poll_rate
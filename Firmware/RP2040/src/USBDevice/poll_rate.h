@@ -0,0 +1,46 @@
+#ifndef _POLL_RATE_H_
+#define _POLL_RATE_H_
+
+#include <cstdint>
+#include <array>
+
+#include "tusb.h"
+
+#include "USBDevice/DeviceDriver/DeviceDriverTypes.h"
+
+//User selectable bInterval for the device's interrupt IN endpoints. 0 leaves the driver's descriptor alone,
+//anything else has to be on the driver's whitelist, rates the console is known to poll at without issue.
+namespace poll_rate
+{
+    static constexpr uint8_t MAX_CHOICES = 6;
+
+    //Allowed bInterval values in ms, zero padded
+    using Choices = std::array<uint8_t, MAX_CHOICES>;
+
+    //Empty for drivers that keep their descriptor's rate
+    Choices get_choices(DeviceDriverType driver);
+
+    bool is_allowed(DeviceDriverType driver, uint8_t interval_ms);
+
+    //Copy of the configuration descriptor with interval_ms in every interrupt IN endpoint,
+    //the descriptor itself if interval_ms is 0 or it's too big to copy
+    const uint8_t* patch_configuration(const uint8_t* desc, uint8_t interval_ms);
+
+    //Measurement, only collected with CONFIG_OGXM_POLL_STATS
+
+    struct Measurement
+    {
+        uint32_t transfers{0};     //IN transfers the host read in the last second
+        uint32_t interval_us{0};   //Average time between them
+    };
+
+    //Wraps the driver's xfer_cb to count completed IN transfers on its first IN endpoint,
+    //a second of them is logged over the debug UART
+    void start_measuring(bool (*driver_xfer_cb)(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes));
+    bool xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes);
+
+    Measurement get_measurement();
+
+} // namespace poll_rate
+
+#endif // _POLL_RATE_H_
@@ -0,0 +1,119 @@
+#include <atomic>
+#include <pico/stdlib.h>
+#include <hardware/sync.h>
+
+#include "tusb.h"
+
+#include "USBDevice/sof_sync.h"
+
+namespace sof_sync {
+
+#if defined(CONFIG_OGXM_SOF_SYNC)
+
+//Full speed frame
+static constexpr uint32_t FRAME_US = 1000;
+//No SOF for this long and the bus is idle, suspended or gone
+static constexpr uint32_t STALE_US = 3 * FRAME_US;
+
+static_assert(SOF_SYNC_LEAD_US < FRAME_US / 2, "sof_sync: lead has to be under half a frame");
+
+//32 bit so the SOF interrupt's stores can't tear
+static std::atomic<uint32_t> last_sof_us_{0};
+static std::atomic<uint32_t> submitted_us_{0};
+static std::atomic<bool> in_flight_{false};
+static LatencyHistogram lead_;
+
+static bool sof_enabled_ = false;
+static bool synced_ = false;
+static uint32_t window_us_ = 0;
+
+void sof_cb(uint8_t rhport, uint32_t frame_count)
+{
+    (void)rhport;
+    (void)frame_count;
+
+    const uint32_t now = time_us_32();
+    if (in_flight_.load(std::memory_order_relaxed))
+    {
+        lead_.record(now - submitted_us_.load(std::memory_order_relaxed));
+        in_flight_.store(false, std::memory_order_relaxed);
+    }
+    last_sof_us_.store(now, std::memory_order_release);
+}
+
+void wait_for_next_poll()
+{
+    if (!sof_enabled_)
+    {
+        if (!tud_inited())
+        {
+            sleep_ms(1);
+            return;
+        }
+        //Only wakes the class driver's hook, SOF interrupts are off by default
+        tud_sof_cb_enable(true);
+        sof_enabled_ = true;
+    }
+
+    const uint32_t now = time_us_32();
+    const uint32_t last_sof = last_sof_us_.load(std::memory_order_acquire);
+
+    if (now - last_sof > STALE_US)
+    {
+        synced_ = false;
+        sleep_ms(1);
+        return;
+    }
+
+    //The pass that just ran was a synced one, its reports go out at the coming SOF
+    if (synced_)
+    {
+        submitted_us_.store(now, std::memory_order_relaxed);
+        in_flight_.store(true, std::memory_order_relaxed);
+    }
+
+    uint32_t window = last_sof + FRAME_US - SOF_SYNC_LEAD_US;
+
+    //Woke ahead of this SOF already and it hasn't landed yet, aim for the one after
+    if (synced_ && static_cast<int32_t>(window - window_us_) < static_cast<int32_t>(FRAME_US / 2))
+    {
+        window = window_us_ + FRAME_US;
+    }
+    window_us_ = window;
+    synced_ = true;
+
+    const int32_t delay = static_cast<int32_t>(window - time_us_32());
+    if (delay > 0)
+    {
+        sleep_us(delay);
+    }
+
+    //Completes the transfer the host read at the last SOF, so the endpoint is free for the next report
+    tud_task();
+}
+
+LatencyHistogram get_lead()
+{
+    //Same core as the SOF interrupt, keep it from recording mid copy
+    const uint32_t irq_state = save_and_disable_interrupts();
+    const LatencyHistogram lead = lead_;
+    restore_interrupts(irq_state);
+    return lead;
+}
+
+#else // defined(CONFIG_OGXM_SOF_SYNC)
+
+void sof_cb(uint8_t rhport, uint32_t frame_count)
+{
+    (void)rhport;
+    (void)frame_count;
+}
+
+void wait_for_next_poll()
+{
+    sleep_ms(1);
+}
+
+#endif // defined(CONFIG_OGXM_SOF_SYNC)
+
+} // namespace sof_sync
@@ -0,0 +1,35 @@
+#ifndef _SOF_SYNC_H_
+#define _SOF_SYNC_H_
+
+#include <cstdint>
+
+#include "Gamepad/LatencyHistogram.h"
+
+//How far ahead of the next SOF the device loop wakes to build and arm its IN reports,
+//has to cover TaskQueue::Core0::process_tasks(), tud_task() and the driver's process()
+#ifndef SOF_SYNC_LEAD_US
+    #define SOF_SYNC_LEAD_US 100
+#endif
+
+//Lines the device loop up with the host's polling. With CONFIG_OGXM_SOF_SYNC the loop sleeps until just ahead
+//of the next start of frame instead of a free running 1ms, the host polls right after the SOF so the report
+//it reads was built from the newest PadIn. Without it wait_for_next_poll() is the old sleep_ms(1).
+namespace sof_sync
+{
+    //Class driver SOF hook, ISR context
+    void sof_cb(uint8_t rhport, uint32_t frame_count);
+
+    //Call at the end of each device loop pass, after the drivers' process() and tud_task().
+    //Falls back to sleep_ms(1) while there are no SOFs (not connected, suspended)
+    void wait_for_next_poll();
+
+#if defined(CONFIG_OGXM_SOF_SYNC)
+    //Time from the end of a synced pass to the SOF the host reads its reports after, the age of a
+    //sample when it's read is this plus the gamepad's capture to submit latency.
+    //Copy of the one the SOF interrupt records, call from Core0
+    LatencyHistogram get_lead();
+#endif
+
+} // namespace sof_sync
+
+#endif // _SOF_SYNC_H_
@@ -0,0 +1,82 @@
+#include <cstdio>
+
+#include "Board/ogxm_log.h"
+#include "TaskQueue/TaskQueue.h"
+#include "USBDevice/sof_sync.h"
+#include "USBDevice/stats_log.h"
+
+namespace stats_log {
+
+#if defined(CONFIG_OGXM_DEBUG)
+
+static Gamepad* gamepads_ = nullptr;
+
+static void log_latency(const char* name, const LatencyHistogram& latency)
+{
+    if (latency.count == 0)
+    {
+        return;
+    }
+
+    OGXM_LOG("%s: %u samples, avg %uus, max %uus\n", name, 
+        static_cast<unsigned>(latency.count), 
+        static_cast<unsigned>(latency.total_us / latency.count), 
+        static_cast<unsigned>(latency.max_us));
+
+    //Non empty bins only, by lower bound
+    char line[192] = {0};
+    int len = 0;
+    for (uint8_t bin = 0; bin < LatencyHistogram::NUM_BINS && len < static_cast<int>(sizeof(line)); ++bin)
+    {
+        if (latency.bins[bin] != 0)
+        {
+            len += std::snprintf(line + len, sizeof(line) - len, " %uus:%u", 
+                (bin == 0) ? 0u : (1u << bin), static_cast<unsigned>(latency.bins[bin]));
+        }
+    }
+    OGXM_LOG("%s bins:%s\n", name, line);
+}
+
+void start(Gamepad(&gamepads)[MAX_GAMEPADS])
+{
+    gamepads_ = gamepads;
+
+    TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), LOG_PERIOD_MS, true,
+    [] {
+        char name[32];
+        for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+        {
+            std::snprintf(name, sizeof(name), "Gamepad %u latency", i);
+            log_latency(name, gamepads_[i].get_latency());
+
+            const Gamepad::PadInStats stats = gamepads_[i].get_pad_in_stats();
+            if (stats.published != 0 || stats.suppressed != 0)
+            {
+                OGXM_LOG("Gamepad %u input: %u published, %u suppressed as unchanged\n", i,
+                    static_cast<unsigned>(stats.published), static_cast<unsigned>(stats.suppressed));
+            }
+        }
+
+#if defined(CONFIG_OGXM_SOF_SYNC)
+        log_latency("SOF lead", sof_sync::get_lead());
+#endif
+
+#if defined(CONFIG_OGXM_TASK_STATS)
+        TaskQueue::Core0::log_stats();
+    #if (OGXM_BOARD != PI_PICOW)
+        TaskQueue::Core1::log_stats();
+    #endif
+#endif
+    });
+}
+
+#else // defined(CONFIG_OGXM_DEBUG)
+
+void start(Gamepad(&gamepads)[MAX_GAMEPADS])
+{
+    (void)gamepads;
+}
+
+#endif // defined(CONFIG_OGXM_DEBUG)
+
+} // namespace stats_log
@@ -0,0 +1,19 @@
+#ifndef _STATS_LOG_H_
+#define _STATS_LOG_H_
+
+#include <cstdint>
+
+#include "Board/Config.h"
+#include "Gamepad/Gamepad.h"
+
+//Periodic dump of the runtime stats over the debug UART. Only does anything with CONFIG_OGXM_DEBUG,
+//OGXM_LOG compiles out otherwise. Runs as a Core0 task, the core the device driver records on.
+namespace stats_log
+{
+    static constexpr uint32_t LOG_PERIOD_MS = 5000;
+
+    void start(Gamepad(&gamepads)[MAX_GAMEPADS]);
+
+} // namespace stats_log
+
+#endif // _STATS_LOG_H_
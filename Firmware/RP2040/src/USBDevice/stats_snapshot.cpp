@@ -0,0 +1,99 @@
+#include <pico/platform.h>
+
+#include "Board/board_api.h"
+#if defined(CONFIG_OGXM_TASK_STATS)
+    #include "TaskQueue/TaskQueue.h"
+#endif
+#include "USBDevice/stats_snapshot.h"
+
+namespace stats_snapshot {
+
+static constexpr uint32_t MAGIC = 0x4F47534E;
+
+struct Retained
+{
+    uint32_t magic;
+    uint32_t size;
+    Snapshot snapshot;
+    uint32_t checksum;
+};
+
+//Not zeroed at boot, holds whatever the last reboot saved or garbage after a power cycle
+static Retained __uninitialized_ram(retained_);
+
+static Snapshot previous_;
+static bool has_previous_{false};
+static Gamepad* gamepads_{nullptr};
+static DeviceDriverType driver_{DeviceDriverType::NONE};
+
+//FNV-1a, so a cold boot's garbage isn't taken for a snapshot
+static uint32_t checksum(const Snapshot& snapshot)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&snapshot);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(Snapshot); ++i)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void save()
+{
+    if (driver_ == DeviceDriverType::WEBAPP)
+    {
+        //Nothing worth keeping is recorded in the WebApp, carry the previous driver's stats to the next session
+        if (!has_previous_)
+        {
+            return;
+        }
+        retained_.snapshot = previous_;
+    }
+    else
+    {
+        retained_.snapshot.driver = driver_;
+        for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+        {
+            retained_.snapshot.latency[i] = gamepads_[i].get_latency();
+        }
+#if defined(CONFIG_OGXM_TASK_STATS)
+        retained_.snapshot.tasks[0] = TaskQueue::Core0::get_stats();
+    #if (OGXM_BOARD != PI_PICOW)
+        retained_.snapshot.tasks[1] = TaskQueue::Core1::get_stats_unlocked();
+    #else
+        retained_.snapshot.tasks[1] = TaskStats();
+    #endif
+#endif
+#if defined(CONFIG_OGXM_POLL_STATS)
+        retained_.snapshot.poll = poll_rate::get_measurement();
+#endif
+    }
+    retained_.size = sizeof(Snapshot);
+    retained_.checksum = checksum(retained_.snapshot);
+    retained_.magic = MAGIC;
+}
+
+void start(Gamepad(&gamepads)[MAX_GAMEPADS], DeviceDriverType driver)
+{
+    gamepads_ = gamepads;
+    driver_ = driver;
+
+    has_previous_ = (retained_.magic == MAGIC) && 
+                    (retained_.size == sizeof(Snapshot)) && 
+                    (retained_.checksum == checksum(retained_.snapshot));
+    if (has_previous_)
+    {
+        previous_ = retained_.snapshot;
+    }
+    //A reset that skips reboot() shouldn't hand the same snapshot on again
+    retained_.magic = 0;
+
+    board_api::set_reboot_cb(save);
+}
+
+Snapshot* previous()
+{
+    return has_previous_ ? &previous_ : nullptr;
+}
+
+} // namespace stats_snapshot
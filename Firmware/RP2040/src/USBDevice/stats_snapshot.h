@@ -0,0 +1,44 @@
+#ifndef _STATS_SNAPSHOT_H_
+#define _STATS_SNAPSHOT_H_
+
+#include <cstdint>
+#include <array>
+
+#include "Board/Config.h"
+#include "Gamepad/Gamepad.h"
+#include "Gamepad/LatencyHistogram.h"
+#include "USBDevice/DeviceDriver/DeviceDriverTypes.h"
+#if defined(CONFIG_OGXM_TASK_STATS)
+    #include "TaskQueue/TaskStats.h"
+#endif
+#if defined(CONFIG_OGXM_POLL_STATS)
+    #include "USBDevice/poll_rate.h"
+#endif
+
+//Runtime stats of the driver that ran before the last reboot. Switching driver reboots the board, so the WebApp 
+//reads the stats of the driver it replaced from here. Kept in RAM the SDK doesn't clear on boot, a power cycle loses it.
+namespace stats_snapshot
+{
+    struct Snapshot
+    {
+        DeviceDriverType driver{DeviceDriverType::NONE};
+        std::array<LatencyHistogram, MAX_GAMEPADS> latency;
+#if defined(CONFIG_OGXM_TASK_STATS)
+        //By core, core1 stays empty on boards where BTstack runs there
+        std::array<TaskStats, 2> tasks;
+#endif
+#if defined(CONFIG_OGXM_POLL_STATS)
+        poll_rate::Measurement poll;
+#endif
+    };
+
+    //Picks up the snapshot the last reboot left and has board_api::reboot() take a new one from these gamepads, 
+    //while the WebApp is running the previous snapshot is kept instead. Call from core0.
+    void start(Gamepad(&gamepads)[MAX_GAMEPADS], DeviceDriverType driver);
+
+    //nullptr if there's no snapshot from before this boot
+    Snapshot* previous();
+
+} // namespace stats_snapshot
+
+#endif // _STATS_SNAPSHOT_H_
@@ -46,7 +46,7 @@ uint8_t const *tud_hid_descriptor_report_cb(uint8_t itf)
 
 uint8_t const *tud_descriptor_configuration_cb(uint8_t index) 
 {
-	return DeviceManager::get_instance().get_driver()->get_descriptor_configuration_cb(index);
+	return DeviceManager::get_instance().get_descriptor_configuration_cb(index);
 }
 
 uint8_t const* tud_descriptor_device_qualifier_cb() 
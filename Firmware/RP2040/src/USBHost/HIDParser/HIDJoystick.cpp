@@ -25,18 +25,55 @@
 #include "USBHost/HIDParser/HIDJoystick.h"
 #include "USBHost/HIDParser/HIDUtils.h"
 #include <cstring>
+#include <algorithm>
 
 /* ----------------------------------------------- */
 
-static int32_t mapValue(int32_t value, int32_t in_min, int32_t in_max, int32_t out_min, int32_t out_max)
+static int8_t axisIndex(HIDIOType type)
 {
-    return (value - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+    switch (type)
+    {
+        case HIDIOType::X:      return 0;
+        case HIDIOType::Y:      return 1;
+        case HIDIOType::Z:      return 2;
+        case HIDIOType::Rx:     return 3;
+        case HIDIOType::Ry:     return 4;
+        case HIDIOType::Rz:     return 5;
+        case HIDIOType::Slider: return 6;
+        case HIDIOType::Dial:   return 7;
+        default:                return -1;
+    }
+}
+
+//Same order as axisIndex(), JOYSTICK_SUPPORT_X << index is the matching support bit
+static int16_t HIDJoystickData::* const AXIS_FIELDS[] =
+{
+    &HIDJoystickData::X,
+    &HIDJoystickData::Y,
+    &HIDJoystickData::Z,
+    &HIDJoystickData::Rx,
+    &HIDJoystickData::Ry,
+    &HIDJoystickData::Rz,
+    &HIDJoystickData::Slider,
+    &HIDJoystickData::Dial
+};
+
+//Maps logical_min to -32768 and logical_max to 32767 with a multiply and shift, no division
+static inline int16_t scaleAxis(const HIDJoystickOp &op, const HIDJoystickRange &range, uint32_t raw)
+{
+    int32_t value = static_cast<int32_t>(raw);
+    if (range.is_signed && op.size < 32)
+        value = static_cast<int32_t>(raw << (32 - op.size)) >> (32 - op.size);
+
+    value = std::clamp(value, range.logical_min, range.logical_max);
+
+    const uint32_t offset = (static_cast<uint32_t>(value) - static_cast<uint32_t>(range.logical_min)) >> range.pre_shift;
+    return static_cast<int16_t>(static_cast<int32_t>((offset * range.scale) >> 16) - 32768);
 }
 
 /* ----------------------------------------------- */
 
-HIDJoystickData::HIDJoystickData() : index(0xFF),
-                                     support(0),
+HIDJoystickData::HIDJoystickData() : index(0xFF),                                     support(0),
                                      X(0),
                                      Y(0),
                                      Z(0),
@@ -59,9 +96,13 @@ HIDJoystickData::~HIDJoystickData()
 
 /* ----------------------------------------------- */
 
-HIDJoystick::HIDJoystick(const std::shared_ptr<HIDReportDescriptor> &descriptor)
+HIDJoystick::HIDJoystick() : m_no_id_block(NO_JOYSTICK_BLOCK),
+                             m_has_report_ids(false),
+                             m_op_count(0),
+                             m_range_count(0),
+                             m_block_count(0),
+                             m_joystick_count(0)
 {
-    this->m_reports = descriptor->GetReports();
 }
 
 /* ----------------------------------------------- */
@@ -72,123 +113,280 @@ HIDJoystick::~HIDJoystick()
 
 /* ----------------------------------------------- */
 
-bool HIDJoystick::isValid()
+bool HIDJoystick::isValid() const
 {
     return getCount() > 0;
 }
 
 /* ----------------------------------------------- */
 
-uint8_t HIDJoystick::getCount()
+uint8_t HIDJoystick::getCount() const
 {
-    uint8_t count = 0;
+    return this->m_joystick_count;
+}
 
-    for (auto report : this->m_reports)
-    {
-        if (report.report_type == HIDIOReportType::Joystick || report.report_type == HIDIOReportType::GamePad)
-            count++;
-    }
+/* ----------------------------------------------- */
+
+bool HIDJoystick::addOp(const HIDJoystickOp &op)
+{
+    if (this->m_op_count >= MAX_JOYSTICK_OPS)
+        return false;
+
+    this->m_ops[this->m_op_count++] = op;
+    return true;
+}
 
-    return count;
+/* ----------------------------------------------- */
+
+bool HIDJoystick::addRange(HIDJoystickOp &op, const HIDJoystickRange &range)
+{
+    if (this->m_range_count >= MAX_JOYSTICK_RANGES)
+        return false;
+
+    op.range = this->m_range_count;
+    this->m_ranges[this->m_range_count++] = range;
+    return true;
 }
 
 /* ----------------------------------------------- */
 
-bool HIDJoystick::parseData(uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data)
+uint8_t HIDJoystick::findBlock(uint8_t report_id) const
 {
-    bool found = false;
-    uint8_t joystick_count = 0;
+    if (!this->m_has_report_ids)
+        return NO_JOYSTICK_BLOCK;
 
-    for (uint32_t i = 0; i < this->m_reports.size(); i++)
+    const uint8_t entry = (this->m_report_index[report_id >> 1] >> ((report_id & 1) * 4)) & 0x0F;
+    return (entry == NO_INDEXED_BLOCK) ? NO_JOYSTICK_BLOCK : entry;
+}
+
+/* ----------------------------------------------- */
+
+void HIDJoystick::indexBlock(uint8_t report_id, uint8_t block)
+{
+    const uint8_t shift = (report_id & 1) * 4;
+    uint8_t &entry = this->m_report_index[report_id >> 1];
+    entry = static_cast<uint8_t>((entry & ~(0x0F << shift)) | (block << shift));
+}
+
+/* ----------------------------------------------- */
+
+void HIDJoystick::compile(const HIDReportDescriptor &descriptor)
+{
+    this->m_op_count = 0;
+    this->m_range_count = 0;
+    this->m_block_count = 0;
+    this->m_joystick_count = 0;
+    this->m_no_id_block = NO_JOYSTICK_BLOCK;
+    this->m_has_report_ids = false;
+
+    for (uint8_t r = 0; r < descriptor.GetReportCount(); r++)
     {
-        auto report = this->m_reports[i];
+        const HIDIOReport &report = descriptor.GetReport(r);
 
         if (report.report_type != HIDIOReportType::Joystick && report.report_type != HIDIOReportType::GamePad)
             continue;
 
-        joystick_count += 1;
+        this->m_joystick_count += 1;
 
-        for (auto ioblock : report.inputs)
+        for (uint8_t b = 0; b < report.inputs.count; b++)
         {
-            uint32_t bitOffset = 0;
-
-            for (auto input : ioblock.data)
-            {
-                uint32_t value = HIDUtils::readBitsLE(data, bitOffset, input.size);
-                bitOffset += input.size;
+            if (this->m_block_count >= MAX_JOYSTICK_BLOCKS)
+                return;
 
-                if (bitOffset > (datalen * (uint32_t)8))
-                    return false; // Out of range
+            const HIDIOBlock &ioblock = descriptor.GetBlock(report.inputs.first + b);
 
-                if (input.type == HIDIOType::ReportId)
-                {
-                    if (value != input.id)
-                        break; // Not the correct report id
-                }
+            HIDJoystickBlock block = {};
+            block.index = this->m_joystick_count - 1;
+            block.first_op = this->m_op_count;
+            const uint8_t firstRange = this->m_range_count;
 
-                found = true;
-                joystick_data->index = joystick_count - 1;
+            uint64_t bitOffset = 0;
+            bool complete = true;
 
-                if (input.type == HIDIOType::Button)
-                {
-                    if (input.id >= MAX_BUTTONS)
-                        return false;
+            for (uint16_t u = 0; u < ioblock.usage_count && complete; u++)
+            {
+                const HIDUsage &usage = descriptor.GetUsage(ioblock, u);
 
-                    joystick_data->buttons[input.id] = value;
-                    if (joystick_data->button_count < input.id)
-                        joystick_data->button_count = input.id;
-                }
-                else if (input.type == HIDIOType::X)
-                {
-                    joystick_data->support |= JOYSTICK_SUPPORT_X;
-                    joystick_data->X = mapValue(value, input.logical_min, input.logical_max, -32768, 32767);
-                }
-                else if (input.type == HIDIOType::Y)
-                {
-                    joystick_data->support |= JOYSTICK_SUPPORT_Y;
-                    joystick_data->Y = mapValue(value, input.logical_min, input.logical_max, -32768, 32767);
-                }
-                else if (input.type == HIDIOType::Z)
+                //Fields nothing is read from only move the offset, the count comes from the device and can be anything
+                const HIDIOType type = HIDInputOutput(usage, 0).type;
+                if (usage.property.size == 0 || (type != HIDIOType::ReportId && type != HIDIOType::Button && 
+                    type != HIDIOType::HatSwitch && axisIndex(type) < 0))
                 {
-                    joystick_data->support |= JOYSTICK_SUPPORT_Z;
-                    joystick_data->Z = mapValue(value, input.logical_min, input.logical_max, -32768, 32767);
+                    bitOffset += static_cast<uint64_t>(usage.property.size) * usage.property.count;
+                    continue;
                 }
-                else if (input.type == HIDIOType::Rx)
-                {
-                    joystick_data->support |= JOYSTICK_SUPPORT_Rx;
-                    joystick_data->Rx = mapValue(value, input.logical_min, input.logical_max, -32768, 32767);
-                }
-                else if (input.type == HIDIOType::Ry)
-                {
-                    joystick_data->support |= JOYSTICK_SUPPORT_Ry;
-                    joystick_data->Ry = mapValue(value, input.logical_min, input.logical_max, -32768, 32767);
-                }
-                else if (input.type == HIDIOType::Rz)
-                {
-                    joystick_data->support |= JOYSTICK_SUPPORT_Rz;
-                    joystick_data->Rz = mapValue(value, input.logical_min, input.logical_max, -32768, 32767);
-                }
-                else if (input.type == HIDIOType::Slider)
-                {
-                    joystick_data->support |= JOYSTICK_SUPPORT_Slider;
-                    joystick_data->Slider = mapValue(value, input.logical_min, input.logical_max, -32768, 32767);
-                }
-                else if (input.type == HIDIOType::Dial)
+
+                //Nothing past UINT16_MAX bits can be read either
+
+                for (uint32_t i = 0; i < usage.property.count && bitOffset <= UINT16_MAX; i++)
                 {
-                    joystick_data->support |= JOYSTICK_SUPPORT_Dial;
-                    joystick_data->Dial = mapValue(value, input.logical_min, input.logical_max, -32768, 32767);
+                    const HIDInputOutput input(usage, i);
+                    const uint32_t fieldOffset = static_cast<uint32_t>(bitOffset);
+                    bitOffset += input.size;
+
+                    if (input.size == 0 || input.size > 32 || bitOffset > UINT16_MAX)
+                        continue; // Nothing a joystick field can use
+
+                    HIDJoystickOp op = {};
+                    HIDJoystickRange limits = {};
+                    op.bit_offset = static_cast<uint16_t>(fieldOffset);
+                    op.size = static_cast<uint8_t>(input.size);
+
+                    if (input.type == HIDIOType::ReportId)
+                    {
+                        if (fieldOffset == 0)
+                            block.report_id = static_cast<uint8_t>(input.id);
+                        continue;
+                    }
+                    else if (input.type == HIDIOType::Button)
+                    {
+                        if (input.id >= MAX_BUTTONS)
+                            continue;
+
+                        block.button_count = std::max(block.button_count, static_cast<uint8_t>(input.id));
+
+                        //Extend the previous run if this button follows it in both bit position and index
+                        HIDJoystickOp *prev = (this->m_op_count > block.first_op) ? &this->m_ops[this->m_op_count - 1] : nullptr;
+                        if (input.size == 1 && prev && prev->type == HIDJoystickOpType::Buttons &&
+                            prev->bit_offset + prev->size == fieldOffset && prev->dest + prev->size == input.id && prev->size < 32)
+                        {
+                            prev->size += 1;
+                            continue;
+                        }
+
+                        op.type = (input.size == 1) ? HIDJoystickOpType::Buttons : HIDJoystickOpType::Button;
+                        op.dest = static_cast<uint8_t>(input.id);
+                    }
+                    else if (input.type == HIDIOType::HatSwitch)
+                    {
+                        op.type = HIDJoystickOpType::HatSwitch;
+                        limits.logical_min = input.logical_min;
+                        block.support |= JOYSTICK_SUPPORT_HatSwitch;
+                    }
+                    else if (axisIndex(input.type) >= 0)
+                    {
+                        //An empty range can't be scaled, leave the axis centered
+                        if (input.logical_max <= input.logical_min)
+                            continue;
+
+                        //Unsigned so a full 32 bit range doesn't overflow
+                        const uint32_t range = static_cast<uint32_t>(input.logical_max) - static_cast<uint32_t>(input.logical_min);
+                        uint8_t preShift = 0;
+                        while ((range >> preShift) > 0xFFFF)
+                            preShift++;
+
+                        const uint64_t shiftedRange = range >> preShift;
+
+                        op.type = HIDJoystickOpType::Axis;
+                        op.dest = static_cast<uint8_t>(axisIndex(input.type));
+                        limits.is_signed = (input.logical_min < 0) ? 1 : 0;
+                        limits.pre_shift = preShift;
+                        limits.logical_min = input.logical_min;
+                        limits.logical_max = input.logical_max;
+                        limits.scale = static_cast<uint32_t>(((static_cast<uint64_t>(0xFFFF) << 16) + shiftedRange - 1) / shiftedRange);
+                        block.support |= (JOYSTICK_SUPPORT_X << op.dest);
+                    }
+                    else
+                    {
+                        continue; // Padding, vendor defined, wheel, etc.
+                    }
+
+                    const bool ranged = (op.type == HIDJoystickOpType::Axis || op.type == HIDJoystickOpType::HatSwitch);
+                    if ((ranged && !addRange(op, limits)) || !addOp(op))
+                    {
+                        complete = false;
+                        break;
+                    }
                 }
-                else if (input.type == HIDIOType::HatSwitch)
+            }
+
+            if (!complete)
+            {
+                this->m_op_count = block.first_op;
+                this->m_range_count = firstRange;
+                return;
+            }
+
+            block.op_count = this->m_op_count - block.first_op;
+            block.bit_length = static_cast<uint32_t>(std::min<uint64_t>(bitOffset, UINT32_MAX));
+
+            //First block wins if a report ID shows up twice
+            if (block.report_id == 0)
+            {
+                if (this->m_no_id_block == NO_JOYSTICK_BLOCK)
+                    this->m_no_id_block = this->m_block_count;
+            }
+            else
+            {
+                //Descriptors without report IDs never touch the index
+                if (!this->m_has_report_ids)
                 {
-                    joystick_data->support |= JOYSTICK_SUPPORT_HatSwitch;
-                    joystick_data->hat_switch = (HIDJoystickHatSwitch)value;
+                    this->m_report_index.fill(0xFF);
+                    this->m_has_report_ids = true;
                 }
+                if (findBlock(block.report_id) == NO_JOYSTICK_BLOCK)
+                    indexBlock(block.report_id, this->m_block_count);
             }
 
-            if (found)
-                return true;
+            this->m_blocks[this->m_block_count++] = block;
         }
     }
-
-    return false;
 }
+
+/* ----------------------------------------------- */
+
+int8_t HIDJoystick::parseData(uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data, uint8_t joystick_data_count)
+{
+    //Report ID 0 is reserved, so an ID that isn't indexed falls back to the block without one (if any)
+    uint8_t blockIdx = (datalen > 0) ? findBlock(data[0]) : NO_JOYSTICK_BLOCK;
+    if (blockIdx == NO_JOYSTICK_BLOCK)
+        blockIdx = this->m_no_id_block;
+
+    if (blockIdx == NO_JOYSTICK_BLOCK)
+        return -1; // Not a joystick report
+
+    const HIDJoystickBlock &block = this->m_blocks[blockIdx];
+
+    if (block.bit_length > (datalen * (uint32_t)8) || block.index >= joystick_data_count)
+        return -1; // Out of range
+
+    HIDJoystickData &joystick = joystick_data[block.index];
+    joystick.index = block.index;
+    joystick.support |= block.support;
+    if (joystick.button_count < block.button_count)
+        joystick.button_count = block.button_count;
+
+    const HIDJoystickOp *op = &this->m_ops[block.first_op];
+    const HIDJoystickOp *end = op + block.op_count;
+
+    for (; op != end; ++op)
+    {
+        const uint32_t value = HIDUtils::readBitsLE(data, op->bit_offset, op->size);
+
+        switch (op->type)
+        {
+            case HIDJoystickOpType::Buttons:
+                for (uint8_t b = 0; b < op->size; b++)
+                    joystick.buttons[op->dest + b] = (value >> b) & 0x01;
+                break;
+
+            case HIDJoystickOpType::Button:
+                joystick.buttons[op->dest] = static_cast<uint8_t>(value);
+                break;
+
+            case HIDJoystickOpType::Axis:
+                joystick.*AXIS_FIELDS[op->dest] = scaleAxis(*op, this->m_ranges[op->range], value);
+                break;
+
+            case HIDJoystickOpType::HatSwitch:
+            {
+                const uint32_t direction = value - static_cast<uint32_t>(this->m_ranges[op->range].logical_min);
+                joystick.hat_switch = (direction <= (uint32_t)HIDJoystickHatSwitch::UP_LEFT) ? 
+                    (HIDJoystickHatSwitch)direction : HIDJoystickHatSwitch::NEUTRAL;
+                break;
+            }
+        }
+    }
+
+    return block.index;
+}
\ No newline at end of file
@@ -23,10 +23,14 @@
 */
 
 #include "USBHost/HIDParser/HIDReportDescriptor.h"
-#include <memory>
-#include <vector>
+#include <array>
 
 #define MAX_BUTTONS 32
+#define MAX_JOYSTICK_OPS 48
+#define MAX_JOYSTICK_RANGES 32
+#define MAX_JOYSTICK_BLOCKS 8
+#define NO_JOYSTICK_BLOCK 0xFF
+#define NO_INDEXED_BLOCK 0x0F //Report ID index entries are 4 bits
 
 enum class HIDJoystickHatSwitch
 {
@@ -76,17 +80,80 @@ public:
     uint8_t buttons[MAX_BUTTONS];
 };
 
+enum class HIDJoystickOpType : uint8_t
+{
+    Buttons,   //Run of consecutive 1 bit buttons, read in one go
+    Button,    //Single button wider than 1 bit
+    Axis,
+    HatSwitch
+};
+
+//One field to pull out of a report, offsets are relative to the start of the report (report ID included)
+struct HIDJoystickOp
+{
+    uint16_t bit_offset;
+    uint8_t size;           //Field size in bits, number of buttons for a Buttons run
+    HIDJoystickOpType type;
+    uint8_t dest;           //First button index, axis index (X to Dial), unused for the hat
+    uint8_t range;          //Axis and hat: index of its HIDJoystickRange, buttons don't have one
+};
+
+//Logical range of an axis or hat, kept out of HIDJoystickOp so button ops stay small
+struct HIDJoystickRange
+{
+    int32_t logical_min;
+    int32_t logical_max;    //Axis only
+    uint32_t scale;         //Axis: (65535 << 16) / range rounded up, so (value - min) * scale >> 16 spans 0 to 65535
+    uint8_t is_signed;      //Axis: sign extend, logical minimum is negative
+    uint8_t pre_shift;      //Axis: ranges wider than 16 bits are shifted down before scaling
+};
+
+//Ops for one report (one report ID, or the whole report if the device doesn't use IDs)
+struct HIDJoystickBlock
+{
+    uint8_t report_id;      //0 if the report has no ID byte
+    uint8_t index;          //Joystick index, same as the joystick/gamepad collection order
+    uint8_t first_op;
+    uint8_t op_count;
+    uint16_t support;       //JOYSTICK_SUPPORT_* bits set by this report
+    uint8_t button_count;   //Highest button index in this report
+    uint32_t bit_length;    //Reports shorter than this are rejected
+};
+
 class HIDJoystick
 {
 public:
-    HIDJoystick(const std::shared_ptr<HIDReportDescriptor> &descriptor);
+    HIDJoystick();
     ~HIDJoystick();
 
-    bool isValid();
-    uint8_t getCount();
+    //The descriptor is compiled once at mount into a flat list of ops so parseData() doesn't walk it per report,
+    //the descriptor (and its arena) isn't needed once this returns
+    void compile(const HIDReportDescriptor &descriptor);
+
+    bool isValid() const;
+    uint8_t getCount() const;
 
-    bool parseData(uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data);
+    /// @brief Reads a report into the data of the joystick (application collection) it belongs to
+    /// @param joystick_data one entry per joystick, a report for an index past joystick_data_count is skipped
+    /// @return index of the joystick that was updated, -1 if the report isn't a joystick report
+    int8_t parseData(uint8_t *data, uint16_t datalen, HIDJoystickData *joystick_data, uint8_t joystick_data_count);
 
 private:
-    std::vector<HIDIOReport> m_reports;
+    bool addOp(const HIDJoystickOp &op);
+    bool addRange(HIDJoystickOp &op, const HIDJoystickRange &range);
+    uint8_t findBlock(uint8_t report_id) const;
+    void indexBlock(uint8_t report_id, uint8_t block);
+
+    std::array<HIDJoystickOp, MAX_JOYSTICK_OPS> m_ops;
+    std::array<HIDJoystickRange, MAX_JOYSTICK_RANGES> m_ranges;
+    std::array<HIDJoystickBlock, MAX_JOYSTICK_BLOCKS> m_blocks;
+    static_assert(MAX_JOYSTICK_BLOCKS <= NO_INDEXED_BLOCK, "HIDJoystick: block index doesn't fit an index entry");
+    //Report ID to block, two 4 bit entries a byte (low nibble is the even ID). Only filled when the descriptor uses report IDs
+    std::array<uint8_t, 128> m_report_index;
+    uint8_t m_no_id_block; //First block without a report ID, NO_JOYSTICK_BLOCK if there's none
+    bool m_has_report_ids;
+    uint8_t m_op_count;
+    uint8_t m_range_count;
+    uint8_t m_block_count;
+    uint8_t m_joystick_count;
 };
\ No newline at end of file
@@ -25,12 +25,6 @@
 #include "USBHost/HIDParser/HIDReportDescriptor.h"
 #include "USBHost/HIDParser/HIDReportDescriptorElements.h"
 #include "USBHost/HIDParser/HIDReportDescriptorUsages.h"
-#include <iostream>
-#include <vector>
-#include <memory>
-#include <stack>
-#include <cassert>
-#include <algorithm>
 
 // https://github.com/pasztorpisti/hid-report-parser/blob/master/src/hid_report_parser.cpp
 // https://docs.kernel.org/hid/hidintro.html
@@ -97,6 +91,16 @@ HIDInputOutput::HIDInputOutput(const HIDUsage &usage, uint32_t idx) : type(HIDIO
         this->type = HIDIOType::VendorDefined;
         this->sub_type = usage.sub_type;
     }
+    else if (usage.type == HIDUsageType::Haptics)
+    {
+        this->type = HIDIOType::Haptics;
+        this->sub_type = usage.sub_type;
+    }
+    else if (usage.type == HIDUsageType::PhysicalInterface)
+    {
+        this->type = HIDIOType::PhysicalInterface;
+        this->sub_type = usage.sub_type;
+    }
     else
     {
         this->type = HIDIOType::Unknown;
@@ -107,59 +111,78 @@ HIDInputOutput::HIDInputOutput(const HIDUsage &usage, uint32_t idx) : type(HIDIO
 
 /* -------------------------------------------------------------------- */
 
-HIDReportDescriptor::HIDReportDescriptor()
+HIDReportDescriptor::HIDReportDescriptor(HIDReportArena &arena, const uint8_t *hid_report_data, uint16_t hid_report_data_len) : m_arena(arena)
 {
+    m_result = parse(hid_report_data, hid_report_data_len);
 }
 
 /* -------------------------------------------------------------------- */
 
-HIDReportDescriptor::HIDReportDescriptor(const uint8_t *hid_report_data, uint16_t hid_report_data_len)
+HIDReportDescriptor::~HIDReportDescriptor()
 {
-    parse(hid_report_data, hid_report_data_len);
 }
 
 /* -------------------------------------------------------------------- */
 
-HIDReportDescriptor::~HIDReportDescriptor()
+HIDParseResult HIDReportDescriptor::parse(const uint8_t *hid_report_data, uint16_t hid_report_data_len)
 {
+    m_arena.block_count = 0;
+    m_arena.block_usage_count = 0;
+
+    HIDReportDescriptorElements hid_report_elements = HIDReportDescriptorElements(hid_report_data, hid_report_data_len);
+    HIDParseResult result = HIDReportDescriptorUsages::parse(hid_report_elements, m_arena);
+    if (result != HIDParseResult::Ok)
+        return result;
+
+    for (uint8_t r = 0; r < m_arena.report_count; r++)
+    {
+        const HIDReport &report = m_arena.reports[r];
+        HIDIOReport &io_report = m_arena.io_reports[r];
+
+        //The application collection usage gives the report type
+        io_report = HIDIOReport(report.usage_count ? (HIDIOReportType)m_arena.usages[report.first_usage].sub_type : HIDIOReportType::Unknown);
+
+        if ((result = addBlocks(report, HIDUsageIOType::Input, io_report.inputs)) != HIDParseResult::Ok ||
+            (result = addBlocks(report, HIDUsageIOType::Output, io_report.outputs)) != HIDParseResult::Ok ||
+            (result = addBlocks(report, HIDUsageIOType::Feature, io_report.features)) != HIDParseResult::Ok)
+            return result;
+    }
+
+    return HIDParseResult::Ok;
 }
 
 /* -------------------------------------------------------------------- */
 
-void HIDReportDescriptor::parse(const uint8_t *hid_report_data, uint16_t hid_report_data_len)
+HIDParseResult HIDReportDescriptor::addBlocks(const HIDReport &report, HIDUsageIOType io_type, HIDIOBlockList &list)
 {
-    HIDReportDescriptorElements hid_report_elements = HIDReportDescriptorElements(hid_report_data, hid_report_data_len);
-    std::vector<HIDReport> hid_report_usage = HIDReportDescriptorUsages::parse(hid_report_elements);
-    for (auto report : hid_report_usage)
+    list.first = m_arena.block_count;
+    list.count = 0;
+
+    for (uint16_t k = 1; k < report.usage_count; k++)
     {
-        m_reports.push_back(HIDIOReport((HIDIOReportType)report.usages[0].sub_type));
+        const uint16_t usage_idx = report.first_usage + k;
+        const HIDUsage &usage = m_arena.usages[usage_idx];
+
+        if (usage.io_type != io_type || usage.property.count == 0)
+            continue;
 
-        for (size_t k = 1; k < report.usages.size(); k++)
+        //We need to create a new block everytime we meet a ReportId and if there is no block
+        if (usage.type == HIDUsageType::ReportId || list.count == 0)
         {
-            std::vector<HIDIOBlock> *ioblocks = NULL;
-            HIDUsage &usage = report.usages[k];
-
-            if (usage.io_type == HIDUsageIOType::Input)
-                ioblocks = &m_reports.back().inputs;
-            else if (usage.io_type == HIDUsageIOType::Output)
-                ioblocks = &m_reports.back().outputs;
-            else if (usage.io_type == HIDUsageIOType::Feature)
-                ioblocks = &m_reports.back().features;
-            else
-                continue;
-
-            for (uint32_t i = 0; i < usage.property.count; i++)
-            {
-                HIDInputOutput io(usage, i);
-                
-                //We need to create a new block everytime we meet a ReportId and if there is no block
-                if (io.type == HIDIOType::ReportId || ioblocks->size() == 0)
-                    ioblocks->push_back(HIDIOBlock());
-
-                ioblocks->back().data.push_back(io);
-            }
+            if (m_arena.block_count >= HID_MAX_BLOCKS)
+                return HIDParseResult::TooManyBlocks;
+
+            m_arena.blocks[m_arena.block_count++] = HIDIOBlock{m_arena.block_usage_count, 0};
+            list.count++;
         }
+
+        //Each usage lands in at most one block, this only trips if the usage parser let the arena overflow
+        if (m_arena.block_usage_count >= HID_MAX_USAGES)
+            return HIDParseResult::TooManyUsages;
+
+        m_arena.block_usages[m_arena.block_usage_count++] = usage_idx;
+        m_arena.blocks[m_arena.block_count - 1].usage_count++;
     }
 
-    assert(m_reports.size() > 0);
+    return HIDParseResult::Ok;
 }
@@ -25,7 +25,22 @@
 #pragma once
 
 #include <stdint.h>
-#include <vector>
+#include <array>
+#include "USBHost/HIDParser/HIDReportDescriptorUsages.h"
+
+//Arena capacity, a descriptor that needs more fails to parse with the matching HIDParseResult
+#ifndef HID_MAX_REPORTS
+#define HID_MAX_REPORTS 8             //Application collections
+#endif
+#ifndef HID_MAX_USAGES
+#define HID_MAX_USAGES 128            //Usages of all reports, one per usage or usage range of a main item
+#endif
+#ifndef HID_MAX_BLOCKS
+#define HID_MAX_BLOCKS 64             //Input/output/feature blocks, one per report ID and type
+#endif
+#ifndef HID_MAX_COLLECTION_DEPTH
+#define HID_MAX_COLLECTION_DEPTH 8
+#endif
 
 enum class HIDIOType 
 {
@@ -43,10 +58,10 @@ enum class HIDIOType
     Slider,
     Dial,
     HatSwitch,
-    Wheel
+    Wheel,
+    Haptics,            //sub_type is the Haptics page usage
+    PhysicalInterface   //sub_type is the PID page usage
 };
-class HIDUsage;
-
 class HIDInputOutput
 {
 public:
@@ -85,41 +100,77 @@ typedef enum class HIDIOReportType
     MAX = 0x2F
 } HIDIOReportType;
 
+//Items of one report ID, a range of HIDReportArena::block_usages
 class HIDIOBlock
 {
 public:
-    HIDIOBlock() {}
-    ~HIDIOBlock() {}
+    uint16_t first_usage;
+    uint16_t usage_count;
+};
 
-    std::vector<HIDInputOutput> data;
+//Range of HIDReportArena::blocks
+class HIDIOBlockList
+{
+public:
+    uint8_t first;
+    uint8_t count;
 };
 
 class HIDIOReport
 {
 public:
     HIDIOReport(HIDIOReportType report_type = HIDIOReportType::Unknown) :
-        report_type(report_type)
+        report_type(report_type),
+        inputs{0, 0},
+        outputs{0, 0},
+        features{0, 0}
     {}
 
     HIDIOReportType report_type;
-    std::vector<HIDIOBlock> inputs;
-    std::vector<HIDIOBlock> outputs;
-    std::vector<HIDIOBlock> features;
+    HIDIOBlockList inputs;
+    HIDIOBlockList outputs;
+    HIDIOBlockList features;
+};
+
+/* -------------------------------------------------------------------------- */
+
+//Storage for a parsed descriptor, provided by the caller so parsing never allocates
+class HIDReportArena
+{
+public:
+    std::array<HIDReport, HID_MAX_REPORTS> reports;
+    std::array<HIDIOReport, HID_MAX_REPORTS> io_reports;
+    std::array<HIDUsage, HID_MAX_USAGES> usages;
+    std::array<HIDIOBlock, HID_MAX_BLOCKS> blocks;
+    std::array<uint16_t, HID_MAX_USAGES> block_usages; //Usage indexes of each block, in report order
+
+    uint8_t report_count;
+    uint16_t usage_count;
+    uint8_t block_count;
+    uint16_t block_usage_count;
 };
 
 /* -------------------------------------------------------------------------- */
 
+//View of a descriptor parsed into an arena, only valid until the arena is reused
 class HIDReportDescriptor
 {
 public:
-    HIDReportDescriptor();
-    HIDReportDescriptor(const uint8_t *hid_report_data, uint16_t hid_report_data_size);
+    HIDReportDescriptor(HIDReportArena &arena, const uint8_t *hid_report_data, uint16_t hid_report_data_len);
     ~HIDReportDescriptor();
 
-    std::vector<HIDIOReport> GetReports() const { return m_reports; }
-    
+    HIDParseResult GetResult() const { return m_result; }
+    uint8_t GetReportCount() const { return (m_result == HIDParseResult::Ok) ? m_arena.report_count : 0; }
+    const HIDIOReport &GetReport(uint8_t idx) const { return m_arena.io_reports[idx]; }
+    const HIDIOBlock &GetBlock(uint8_t idx) const { return m_arena.blocks[idx]; }
+
+    /// @brief Each usage expands to usage.property.count items, HIDInputOutput(usage, i)
+    const HIDUsage &GetUsage(const HIDIOBlock &block, uint16_t idx) const { return m_arena.usages[m_arena.block_usages[block.first_usage + idx]]; }
+
 private:
-    void parse(const uint8_t *hid_report_data, uint16_t hid_report_data_len);
+    HIDParseResult parse(const uint8_t *hid_report_data, uint16_t hid_report_data_len);
+    HIDParseResult addBlocks(const HIDReport &report, HIDUsageIOType io_type, HIDIOBlockList &list);
 
-    std::vector<HIDIOReport> m_reports;
+    HIDReportArena &m_arena;
+    HIDParseResult m_result;
 };
@@ -29,6 +29,7 @@
 #define HID_FUNC_TYPE_MASK 0xFC
 #define HID_TYPE_MASK      0x0C
 #define HID_LENGTH_MASK    0x03
+#define HID_LONG_ITEM      0xFE
 
 /* -------------------------------------------------------------------------- */
 
@@ -167,11 +168,27 @@ bool HIDReportDescriptorElements::Iterator::operator!=(const Iterator& other) co
 
 void HIDReportDescriptorElements::Iterator::parse_current_element() 
 {
+    const uint16_t remaining = hid_report_data_len - offset - 1;
     uint8_t type = hid_report_data[offset];
-    uint8_t datalen = type & HID_LENGTH_MASK;
+    uint16_t datalen = type & HID_LENGTH_MASK;
     if (datalen == 3)
         datalen = 4;
 
-    current_element = HIDElement((HIDElementType)(type & HID_FUNC_TYPE_MASK), &hid_report_data[offset + 1], datalen);
+    //Long item, the data size is in the next byte and a tag byte follows it
+    if (type == HID_LONG_ITEM && remaining > 0)
+        datalen = 2 + hid_report_data[offset + 1];
+
+    //A truncated last item ends the descriptor rather than reading past it
+    if (datalen > remaining)
+    {
+        offset = hid_report_data_len;
+        return;
+    }
+
+    if (type == HID_LONG_ITEM)
+        current_element = HIDElement(); //No long items are defined, skipped as unknown
+    else
+        current_element = HIDElement((HIDElementType)(type & HID_FUNC_TYPE_MASK), &hid_report_data[offset + 1], (uint8_t)datalen);
+
     current_element_length = datalen;
 }
\ No newline at end of file
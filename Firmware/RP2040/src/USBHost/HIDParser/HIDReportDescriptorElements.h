@@ -23,8 +23,6 @@
 */
 
 #pragma once
-#include <memory>
-#include <vector>
 #include <stdint.h>
 
 /* -------------------------------------------------------------------------- */
@@ -105,7 +103,7 @@ public:
             uint16_t hid_report_data_len;
             uint16_t offset;
             HIDElement current_element;
-            uint8_t current_element_length;
+            uint16_t current_element_length;
     };
 
     Iterator begin() const;
@@ -23,12 +23,7 @@
 */
 
 #include "USBHost/HIDParser/HIDReportDescriptorUsages.h"
-#include <iostream>
-#include <vector>
-#include <memory>
-#include <stack>
-#include <cassert>
-#include <algorithm>
+#include "USBHost/HIDParser/HIDReportDescriptor.h"
 
 //---------------USAGE_PAGE-----------------
 #define USAGE_PAGE_GenericDesktop 0x01
@@ -43,6 +38,8 @@
 #define USAGE_PAGE_Ordinal        0x0A
 #define USAGE_PAGE_Telephony      0x0B
 #define USAGE_PAGE_Consumer       0x0C
+#define USAGE_PAGE_Haptics        0x0E
+#define USAGE_PAGE_PID            0x0F
 #define USAGE_PAGE_VendorDefined  0xFF00
 
 //---------------USAGE-----------------
@@ -79,10 +76,10 @@
 /* -------------------------------------------------------------------------- */
 
 HIDUsage::HIDUsage(HIDUsageType type, uint32_t sub_type, HIDUsageIOType io_type, HIDProperty property) : type(type),
+                                                                                                         io_type(io_type),
                                                                                                          sub_type(sub_type),
                                                                                                          usage_min(0),
                                                                                                          usage_max(0),
-                                                                                                         io_type(io_type),
                                                                                                          property(property)
 {
     if (sub_type != 0)
@@ -119,7 +116,7 @@ HIDProperty::~HIDProperty()
 
 /* -------------------------------------------------------------------------- */
 
-bool HIDProperty::is_valid()
+bool HIDProperty::is_valid() const
 {
     return size != 0 && count != 0;
 }
@@ -134,22 +131,34 @@ HIDUsageType convert_usage_page(uint32_t usage_page)
             return HIDUsageType::Button;
         case USAGE_PAGE_GenericDesktop:
             return HIDUsageType::GenericDesktop;
-        case USAGE_PAGE_VendorDefined:
-            return HIDUsageType::VendorDefined;
+        case USAGE_PAGE_Haptics:
+            return HIDUsageType::Haptics;
+        case USAGE_PAGE_PID:
+            return HIDUsageType::PhysicalInterface;
         default:
-            return HIDUsageType::Unknown;
+            //0xFF00 to 0xFFFF are all vendor pages
+            return (usage_page >= USAGE_PAGE_VendorDefined && usage_page <= 0xFFFF) ? HIDUsageType::VendorDefined : HIDUsageType::Unknown;
     }
 }
 
 /* -------------------------------------------------------------------------- */
 
-std::vector<HIDReport> HIDReportDescriptorUsages::parse(const HIDReportDescriptorElements &elements)
+HIDParseResult HIDReportDescriptorUsages::parse(const HIDReportDescriptorElements &elements, HIDReportArena &arena)
 {
     HIDProperty current_property;
-    std::vector<HIDUsage> current_usages;
+    uint32_t logical_max_unsigned = 0;
+    uint32_t physical_max_unsigned = 0;
     HIDUsageType current_usage_page_type = HIDUsageType::Unknown;
-    std::vector<HIDReport> report;
     uint8_t current_report_id = 0;
+    uint8_t collection_depth = 0;
+
+    //Local usages are staged right after the committed ones, a main item or collection only has to commit them
+    HIDUsage *usages = arena.usages.data();
+    uint16_t usage_count = 0;
+    uint16_t local_count = 0;
+
+    arena.report_count = 0;
+    arena.usage_count = 0;
 
     for (const HIDElement &element : elements)
     {
@@ -160,21 +169,29 @@ std::vector<HIDReport> HIDReportDescriptorUsages::parse(const HIDReportDescripto
                 break;
 
             case HIDElementType::HID_USAGE:
-                current_usages.push_back(HIDUsage(current_usage_page_type, element.GetValueUint32()));
+                if (usage_count + local_count >= HID_MAX_USAGES)
+                    return HIDParseResult::TooManyUsages;
+
+                usages[usage_count + local_count++] = HIDUsage(current_usage_page_type, element.GetValueUint32());
                 break;
 
             case HIDElementType::HID_USAGE_MAXIMUM:
             case HIDElementType::HID_USAGE_MINIMUM:
             {
-                if (current_usages.size() == 0)
-                    current_usages.push_back(HIDUsage(current_usage_page_type));
+                if (local_count == 0)
+                {
+                    if (usage_count >= HID_MAX_USAGES)
+                        return HIDParseResult::TooManyUsages;
 
-                for (HIDUsage &usage : current_usages)
+                    usages[usage_count + local_count++] = HIDUsage(current_usage_page_type);
+                }
+
+                for (uint16_t i = usage_count; i < usage_count + local_count; i++)
                 {
                     if (element.GetType() == HIDElementType::HID_USAGE_MINIMUM)
-                        usage.usage_min = element.GetValueUint32();
+                        usages[i].usage_min = element.GetValueUint32();
                     else if (element.GetType() == HIDElementType::HID_USAGE_MAXIMUM)
-                        usage.usage_max = element.GetValueUint32();
+                        usages[i].usage_max = element.GetValueUint32();
                 }
                 break;
             }
@@ -185,22 +202,20 @@ std::vector<HIDReport> HIDReportDescriptorUsages::parse(const HIDReportDescripto
 
             case HIDElementType::HID_LOGICAL_MINIMUM:
                 current_property.logical_min = element.GetValueInt32();
-                current_property.logical_min_unsigned = element.GetValueUint32();
                 break;
 
             case HIDElementType::HID_LOGICAL_MAXIMUM:
                 current_property.logical_max = element.GetValueInt32();
-                current_property.logical_max_unsigned = element.GetValueUint32();
+                logical_max_unsigned = element.GetValueUint32();
                 break;
 
             case HIDElementType::HID_PHYSICAL_MINIMUM:
                 current_property.physical_min = element.GetValueInt32();
-                current_property.physical_min_unsigned = element.GetValueUint32();
                 break;
 
             case HIDElementType::HID_PHYSICAL_MAXIMUM:
                 current_property.physical_max = element.GetValueInt32();
-                current_property.physical_max_unsigned = element.GetValueUint32();
+                physical_max_unsigned = element.GetValueUint32();
                 break;
 
             case HIDElementType::HID_UNIT_EXPONENT:
@@ -223,8 +238,15 @@ std::vector<HIDReport> HIDReportDescriptorUsages::parse(const HIDReportDescripto
             case HIDElementType::HID_OUTPUT:
             case HIDElementType::HID_FEATURE:
             {
-                if (current_usages.size() == 0)
-                    current_usages.push_back(HIDUsage(HIDUsageType::Padding));
+                if (arena.report_count == 0)
+                    return HIDParseResult::OutsideCollection;
+
+                //Room for the padding usage if there's no local usage, and the report ID if one is pending, can be both
+                if (usage_count + local_count + (local_count == 0) + (current_report_id != 0) > HID_MAX_USAGES)
+                    return HIDParseResult::TooManyUsages;
+
+                if (local_count == 0)
+                    usages[usage_count + local_count++] = HIDUsage(HIDUsageType::Padding);
 
                 HIDUsageIOType io_type = HIDUsageIOType::None;
                 if (element.GetType() == HIDElementType::HID_INPUT)
@@ -234,44 +256,63 @@ std::vector<HIDReport> HIDReportDescriptorUsages::parse(const HIDReportDescripto
                 else if (element.GetType() == HIDElementType::HID_FEATURE)
                     io_type = HIDUsageIOType::Feature;
 
-                for (HIDUsage &usage : current_usages)
-                {
-                        //Fix bug on few controllers, that provide incorrect "Unsigned" values
-                    if (current_property.logical_max < current_property.logical_min)
-                        current_property.logical_max = (int32_t)current_property.logical_max_unsigned;
+                //Fix bug on few controllers, that provide incorrect "Unsigned" values
+                if (current_property.logical_max < current_property.logical_min)
+                    current_property.logical_max = (int32_t)logical_max_unsigned;
 
-                    if (current_property.physical_max < current_property.physical_min)
-                        current_property.physical_max = (int32_t)current_property.physical_max_unsigned;
+                if (current_property.physical_max < current_property.physical_min)
+                    current_property.physical_max = (int32_t)physical_max_unsigned;
 
-                    usage.io_type = io_type;
-                    usage.property = current_property;
-                    usage.property.count = (current_property.count / (uint32_t)current_usages.size());
+                for (uint16_t i = usage_count; i < usage_count + local_count; i++)
+                {
+                    usages[i].io_type = io_type;
+                    usages[i].property = current_property;
+                    usages[i].property.count = (current_property.count / (uint32_t)local_count);
                 }
 
                 if (current_report_id != 0)
                 {
-                    current_usages.insert(current_usages.begin(), HIDUsage(HIDUsageType::ReportId, current_report_id, io_type, HIDProperty(8, 1)));
+                    for (uint16_t i = usage_count + local_count; i > usage_count; i--)
+                        usages[i] = usages[i - 1];
+
+                    usages[usage_count] = HIDUsage(HIDUsageType::ReportId, current_report_id, io_type, HIDProperty(8, 1));
+                    local_count++;
                     current_report_id = 0;
                 }
 
-                report.back().usages.insert(report.back().usages.end(), current_usages.begin(), current_usages.end());
-                current_usages.clear();
+                usage_count += local_count;
+                local_count = 0;
                 break;
             }
 
                 // For now collections are ignored
             case HIDElementType::HID_COLLECTION:
             {
+                if (collection_depth >= HID_MAX_COLLECTION_DEPTH)
+                    return HIDParseResult::CollectionTooDeep;
+
+                collection_depth++;
+
                 if (element.GetValueUint32() == HID_COLLECTION_APPLICATION)
-                    report.push_back(HIDReport());
+                {
+                    if (arena.report_count >= HID_MAX_REPORTS)
+                        return HIDParseResult::TooManyReports;
 
-                report.back().usages.insert(report.back().usages.end(), current_usages.begin(), current_usages.end());
-                current_usages.clear();
+                    arena.reports[arena.report_count++] = HIDReport{usage_count, 0};
+                }
+
+                if (arena.report_count == 0)
+                    return HIDParseResult::OutsideCollection;
+
+                usage_count += local_count;
+                local_count = 0;
                 break;
             }
 
             case HIDElementType::HID_END_COLLECTION:
             {
+                if (collection_depth > 0)
+                    collection_depth--;
                 break;
             }
 
@@ -287,7 +328,15 @@ std::vector<HIDReport> HIDReportDescriptorUsages::parse(const HIDReportDescripto
             case HIDElementType::HID_STRING_MAXIMUM:
                 break;
         }
+
+        //Committed usages always belong to the last report
+        if (arena.report_count > 0)
+        {
+            HIDReport &report = arena.reports[arena.report_count - 1];
+            report.usage_count = usage_count - report.first_usage;
+        }
     }
 
-    return report;
+    arena.usage_count = usage_count;
+    return (arena.report_count > 0) ? HIDParseResult::Ok : HIDParseResult::NoReports;
 }
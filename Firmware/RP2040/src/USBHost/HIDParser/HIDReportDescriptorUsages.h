@@ -24,9 +24,10 @@
 
 #pragma once
 #include "USBHost/HIDParser/HIDReportDescriptorElements.h"
-#include <vector>
 
-enum class HIDUsageIOType 
+class HIDReportArena;
+
+enum class HIDUsageIOType : uint8_t
 {
     None = 0x00,
     Input,
@@ -34,14 +35,16 @@ enum class HIDUsageIOType
     Feature
 };
 
-enum class HIDUsageType 
+enum class HIDUsageType : uint8_t
 {
     Unknown = 0x00,
     ReportId,
     Padding,
     Button,
     GenericDesktop,
-    VendorDefined
+    VendorDefined,
+    Haptics,
+    PhysicalInterface
 };
 
 enum class HIDUsageGenericDesktopSubType 
@@ -72,22 +75,14 @@ class HIDProperty
 {
 public:
     HIDProperty(uint32_t size=0, uint32_t count=0);
-    virtual ~HIDProperty();
+    ~HIDProperty();
 
-    virtual bool is_valid();
+    bool is_valid() const;
 
     int32_t logical_min;
-    uint32_t logical_min_unsigned;
-
     int32_t logical_max;
-    uint32_t logical_max_unsigned;
-
     int32_t physical_min;
-    uint32_t physical_min_unsigned;
-
     int32_t physical_max;
-    uint32_t physical_max_unsigned;
-
     uint32_t unit;
     uint32_t unit_exponent;
     uint32_t size; //Size of the data in bits
@@ -101,25 +96,39 @@ public:
     /// @param type 
     /// @param sub_type will depend on the type, for example, if type is GenericDesktop, sub_type will be HIDUsageGenericDesktopSubType etc.
     /// @param property 
-    HIDUsage(HIDUsageType type, uint32_t sub_type = 0, HIDUsageIOType io_type = HIDUsageIOType::None, HIDProperty property = HIDProperty());
+    HIDUsage(HIDUsageType type = HIDUsageType::Unknown, uint32_t sub_type = 0, HIDUsageIOType io_type = HIDUsageIOType::None, HIDProperty property = HIDProperty());
     ~HIDUsage();
 
     HIDUsageType type; //Input type (Button, X, Y, Hat switch, Padding, etc.)
+    HIDUsageIOType io_type;
     uint32_t sub_type; //Sub type (Button number, etc.)
     uint32_t usage_min;
     uint32_t usage_max;
-    HIDUsageIOType io_type;
     HIDProperty property;
 };
 
+//Usages of one application collection, a range of HIDReportArena::usages
 class HIDReport
 {
 public:
-    std::vector<HIDUsage> usages;
+    uint16_t first_usage;
+    uint16_t usage_count;
+};
+
+enum class HIDParseResult : uint8_t
+{
+    Ok = 0x00,
+    NoReports,          //No application collection
+    TooManyReports,     //More application collections than HID_MAX_REPORTS
+    TooManyUsages,      //More usages than HID_MAX_USAGES
+    TooManyBlocks,      //More report IDs than HID_MAX_BLOCKS
+    CollectionTooDeep,  //Collections nested deeper than HID_MAX_COLLECTION_DEPTH
+    OutsideCollection   //Main item before the first application collection
 };
 
 class HIDReportDescriptorUsages
 {
 public:
-    static std::vector<HIDReport> parse(const HIDReportDescriptorElements &elements);
+    /// @brief Fills arena.reports and arena.usages, nothing is allocated
+    static HIDParseResult parse(const HIDReportDescriptorElements &elements, HIDReportArena &arena);
 };
\ No newline at end of file
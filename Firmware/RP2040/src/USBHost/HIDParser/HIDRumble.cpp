@@ -0,0 +1,167 @@
+#include "USBHost/HIDParser/HIDRumble.h"
+#include "USBHost/HIDParser/HIDUtils.h"
+#include <algorithm>
+
+#define HAPTICS_USAGE_Intensity    0x23
+
+/* ----------------------------------------------- */
+
+HIDRumble::HIDRumble() : m_field_count(0),
+                         m_report_id(0),
+                         m_report_length(0)
+{
+    this->m_report.fill(0);
+}
+
+/* ----------------------------------------------- */
+
+HIDRumble::~HIDRumble()
+{
+}
+
+/* ----------------------------------------------- */
+
+bool HIDRumble::isValid() const
+{
+    return this->m_field_count > 0;
+}
+
+/* ----------------------------------------------- */
+
+uint8_t HIDRumble::getReportId() const
+{
+    return this->m_report_id;
+}
+
+/* ----------------------------------------------- */
+
+const uint8_t *HIDRumble::getReport() const
+{
+    return this->m_report.data() + ((this->m_report_id != 0) ? 1 : 0);
+}
+
+/* ----------------------------------------------- */
+
+uint16_t HIDRumble::getReportLength() const
+{
+    return this->m_report_length - ((this->m_report_id != 0) ? 1 : 0);
+}
+
+/* ----------------------------------------------- */
+
+void HIDRumble::compile(const HIDReportDescriptor &descriptor)
+{
+    this->m_field_count = 0;
+
+    //Fields with a defined meaning win, vendor fields are only looked at if no report has one
+    for (uint8_t pass = 0; pass < (HID_RUMBLE_VENDOR_FIELDS ? 2 : 1); pass++)
+    {
+        for (uint8_t r = 0; r < descriptor.GetReportCount(); r++)
+        {
+            const HIDIOReport &report = descriptor.GetReport(r);
+
+            if (report.report_type != HIDIOReportType::Joystick && report.report_type != HIDIOReportType::GamePad)
+                continue;
+
+            for (uint8_t b = 0; b < report.outputs.count; b++)
+            {
+                if (compileBlock(descriptor, descriptor.GetBlock(report.outputs.first + b), pass == 1))
+                    return;
+            }
+        }
+    }
+}
+
+/* ----------------------------------------------- */
+
+bool HIDRumble::compileBlock(const HIDReportDescriptor &descriptor, const HIDIOBlock &block, bool vendor)
+{
+    this->m_report.fill(0);
+    this->m_field_count = 0;
+    this->m_report_id = 0;
+
+    uint32_t bitOffset = 0;
+
+    for (uint16_t u = 0; u < block.usage_count; u++)
+    {
+        const HIDUsage &usage = descriptor.GetUsage(block, u);
+
+        if (usage.property.size == 0 || usage.property.size > 32)
+        {
+            this->m_field_count = 0;
+            return false; // Can't be prepacked
+        }
+
+        for (uint32_t i = 0; i < usage.property.count; i++)
+        {
+            const HIDInputOutput output(usage, i);
+            const uint32_t fieldOffset = bitOffset;
+            bitOffset += output.size;
+
+            if (bitOffset > MAX_RUMBLE_REPORT_SIZE * 8)
+            {
+                this->m_field_count = 0;
+                return false; // Too big for the OUT endpoint buffer
+            }
+
+            if (output.type == HIDIOType::ReportId)
+            {
+                if (fieldOffset == 0)
+                    this->m_report_id = static_cast<uint8_t>(output.id);
+                HIDUtils::writeBitsLE(this->m_report.data(), fieldOffset, output.size, output.id);
+                continue;
+            }
+
+            const int32_t base = (output.logical_min > 0) ? output.logical_min : ((output.logical_max < 0) ? output.logical_max : 0);
+            HIDUtils::writeBitsLE(this->m_report.data(), fieldOffset, output.size, static_cast<uint32_t>(base));
+
+            //A single usage covers the whole count, a range runs out on its last usage
+            const uint32_t usageId = std::min(usage.usage_min + i, usage.usage_max);
+
+            //PID magnitudes aren't driven, they do nothing until an effect has been created and started
+            bool motor = false;
+            if (output.type == HIDIOType::Haptics)
+                motor = (usageId == HAPTICS_USAGE_Intensity);
+            else if (output.type == HIDIOType::VendorDefined)
+                motor = vendor && (output.size == 8);
+
+            if (!motor || output.logical_max <= base || this->m_field_count >= MAX_RUMBLE_MOTORS)
+                continue;
+
+            HIDRumbleField &field = this->m_fields[this->m_field_count++];
+            field.bit_offset = static_cast<uint16_t>(fieldOffset);
+            field.size = static_cast<uint8_t>(output.size);
+            field.base = base;
+            field.range = static_cast<uint32_t>(output.logical_max - base);
+        }
+    }
+
+    this->m_report_length = static_cast<uint16_t>((bitOffset + 7) / 8);
+    return this->m_field_count > 0;
+}
+
+/* ----------------------------------------------- */
+
+bool HIDRumble::encode(uint8_t strong, uint8_t weak)
+{
+    if (!isValid())
+        return false;
+
+    const uint8_t strengths[MAX_RUMBLE_MOTORS] = { (this->m_field_count == 1) ? std::max(strong, weak) : strong, weak };
+    bool changed = false;
+
+    for (uint8_t f = 0; f < this->m_field_count; f++)
+    {
+        const HIDRumbleField &field = this->m_fields[f];
+        const uint32_t mask = (field.size == 32) ? 0xFFFFFFFF : ((1u << field.size) - 1);
+        const uint32_t value = static_cast<uint32_t>(field.base + static_cast<int32_t>((static_cast<uint64_t>(strengths[f]) * field.range + 127) / 255)) & mask;
+
+        if (HIDUtils::readBitsLE(this->m_report.data(), field.bit_offset, field.size) != value)
+        {
+            HIDUtils::writeBitsLE(this->m_report.data(), field.bit_offset, field.size, value);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "USBHost/HIDParser/HIDReportDescriptor.h"
+#include <array>
+
+#define MAX_RUMBLE_MOTORS 2
+#define MAX_RUMBLE_REPORT_SIZE 64 //Report ID included, same as the host's interrupt OUT buffer
+
+//Vendor defined output fields have no meaning the parser can check, driving them is opt-in.
+//Without it only haptic intensity fields are driven, most generic pads get no rumble
+#ifndef HID_RUMBLE_VENDOR_FIELDS
+#define HID_RUMBLE_VENDOR_FIELDS 0
+#endif
+
+//Where a motor's strength goes, offsets are relative to the start of the report (report ID included)
+struct HIDRumbleField
+{
+    uint16_t bit_offset;
+    uint8_t size;
+    int32_t base;           //Value sent for 0, the in range value closest to zero
+    uint32_t range;         //base + range is sent for 255
+};
+
+class HIDRumble
+{
+public:
+    HIDRumble();
+    ~HIDRumble();
+
+    //Looks for an output report of a joystick/gamepad collection holding haptic intensity fields
+    //(or 8 bit vendor fields with HID_RUMBLE_VENDOR_FIELDS) and prepacks it, every other field holds its in range value closest to zero.
+    //The descriptor (and its arena) isn't needed once this returns
+    void compile(const HIDReportDescriptor &descriptor);
+
+    bool isValid() const;
+    uint8_t getReportId() const;
+
+    //Report without the ID byte, the way tuh_hid_send_report() takes it
+    const uint8_t *getReport() const;
+    uint16_t getReportLength() const;
+
+    /// @brief Writes the motor strengths into the report, a single motor gets the stronger of the two
+    /// @return true if the report changed
+    bool encode(uint8_t strong, uint8_t weak);
+
+private:
+    bool compileBlock(const HIDReportDescriptor &descriptor, const HIDIOBlock &block, bool vendor);
+
+    std::array<uint8_t, MAX_RUMBLE_REPORT_SIZE> m_report;
+    std::array<HIDRumbleField, MAX_RUMBLE_MOTORS> m_fields;
+    uint8_t m_field_count;
+    uint8_t m_report_id;
+    uint16_t m_report_length; //ID byte included
+};
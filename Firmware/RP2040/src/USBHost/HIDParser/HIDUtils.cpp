@@ -24,27 +24,46 @@
 
 #include "USBHost/HIDParser/HIDUtils.h"
 
-uint32_t HIDUtils::readBitsLE(uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength) {
-    // Calculate the starting byte index and bit index within that byte
-    uint32_t byteIndex = bitOffset / 8;
-    uint32_t bitIndex = bitOffset % 8;  // Little endian, LSB is at index 0
-
-    uint32_t result = 0;
-
-    for (uint32_t i = 0; i < bitLength; ++i) {
-        // Check if we need to move to the next byte
-        if (bitIndex > 7) {
-            ++byteIndex;
-            bitIndex = 0;
-        }
-
-        // Get the bit at the current position and add it to the result
-        uint8_t bit = (buffer[byteIndex] >> bitIndex) & 0x01;
-        result |= (bit << i);
-
-        // Move to the next bit
-        ++bitIndex;
+uint32_t HIDUtils::readBitsLE(const uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength) {
+    if (bitLength == 0) {
+        return 0;
     }
+    if (bitLength > 32) {
+        bitLength = 32;
+    }
+
+    // Only the bytes the field touches are read, at most 5 for a 32 bit field
+    const uint8_t *bytes = buffer + (bitOffset / 8);
+    const uint32_t bitIndex = bitOffset % 8;  // Little endian, LSB is at index 0
+    const uint32_t byteCount = (bitIndex + bitLength + 7) / 8;
+
+    uint64_t raw = 0;
+    for (uint32_t i = 0; i < byteCount; ++i) {
+        raw |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+    }
+    raw >>= bitIndex;
+
+    return (bitLength == 32) ? static_cast<uint32_t>(raw) : static_cast<uint32_t>(raw) & ((1u << bitLength) - 1);
+}
 
-    return result;
-}
\ No newline at end of file
+void HIDUtils::writeBitsLE(uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength, uint32_t value) {
+    if (bitLength == 0) {
+        return;
+    }
+    if (bitLength > 32) {
+        bitLength = 32;
+    }
+
+    // Bits around the field are kept, same byte range as readBitsLE
+    uint8_t *bytes = buffer + (bitOffset / 8);
+    const uint32_t bitIndex = bitOffset % 8;
+    const uint32_t byteCount = (bitIndex + bitLength + 7) / 8;
+
+    const uint64_t mask = ((static_cast<uint64_t>(1) << bitLength) - 1) << bitIndex;
+    const uint64_t bits = (static_cast<uint64_t>(value) << bitIndex) & mask;
+
+    for (uint32_t i = 0; i < byteCount; ++i) {
+        const uint8_t byteMask = static_cast<uint8_t>(mask >> (i * 8));
+        bytes[i] = (bytes[i] & ~byteMask) | static_cast<uint8_t>(bits >> (i * 8));
+    }
+}
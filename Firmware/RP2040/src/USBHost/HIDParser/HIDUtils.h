@@ -31,5 +31,6 @@ public:
 	HIDUtils() {}
 	~HIDUtils() {}
 
-	static uint32_t readBitsLE(uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength);
+	static uint32_t readBitsLE(const uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength);
+	static void writeBitsLE(uint8_t *buffer, uint32_t bitOffset, uint32_t bitLength, uint32_t value);
 };
\ No newline at end of file
@@ -2,16 +2,21 @@
 #define _HW_ID_H_
 
 #include <cstdint>
+#include <array>
+#include <algorithm>
+#include <iterator>
 
-#include "USBHost/HostDriver/HostDriver.h"
+#include "USBHost/HostDriver/HostDriverTypes.h"
 
 struct HardwareID
 {
     uint16_t vid;
     uint16_t pid;
+
+    constexpr uint32_t key() const { return (static_cast<uint32_t>(vid) << 16) | pid; }
 };
 
-static const HardwareID DINPUT_IDS[] =
+static constexpr HardwareID DINPUT_IDS[] =
 {
     {0x044F, 0xB324}, // ThrustMaster Dual Trigger (PS3 mode)
     {0x0738, 0x8818}, // MadCatz Street Fighter IV Arcade FightStick
@@ -21,12 +26,12 @@ static const HardwareID DINPUT_IDS[] =
     {0x046D, 0xC218}, // Logitech RumblePad 2
 };
 
-static const HardwareID PS3_IDS[] =
+static constexpr HardwareID PS3_IDS[] =
 {
     {0x054C, 0x0268}, // Sony Batoh (Dualshock 3)
 };
 
-static const HardwareID PS4_IDS[] =
+static constexpr HardwareID PS4_IDS[] =
 {
     {0x054C, 0x05C4}, // DS4
     {0x054C, 0x09CC}, // DS4
@@ -37,25 +42,25 @@ static const HardwareID PS4_IDS[] =
     {0x1F4F, 0x1002}  // ASW GG Xrd controller
 };
 
-static const HardwareID PS5_IDS[] =
+static constexpr HardwareID PS5_IDS[] =
 {
     {0x054C, 0x0CE6}, // dualsense
     {0x054C, 0x0DF2} // dualsense edge
 };
 
-static const HardwareID PSCLASSIC_IDS[] =
+static constexpr HardwareID PSCLASSIC_IDS[] =
 {
     {0x054C, 0x0CDA} // psclassic
 };
 
-static const HardwareID SWITCH_PRO_IDS[] =
+static constexpr HardwareID SWITCH_PRO_IDS[] =
 {
     {0x057E, 0x2009}, // Switch Pro
     {0x057E, 0x0330} // Wii U Pro
     // {0x20D6, 0xA711}, // OpenSteamController, emulated pro controller
 };
 
-static const HardwareID SWITCH_WIRED_IDS[] =
+static constexpr HardwareID SWITCH_WIRED_IDS[] =
 {
     {0x20D6, 0xA719}, // PowerA wired
     {0x20D6, 0xA713}, // PowerA Enhanced wired
@@ -63,7 +68,7 @@ static const HardwareID SWITCH_WIRED_IDS[] =
     {0x0F0D, 0x00C1}, // Hori Pokken Horipad
 };
 
-static const HardwareID N64_IDS[] =
+static constexpr HardwareID N64_IDS[] =
 {
     {0x0079, 0x0006} // Retrolink N64 USB gamepad
 };
@@ -75,16 +80,96 @@ struct HostTypeMap
     HostDriverType type;
 };
 
-static const HostTypeMap HOST_TYPE_MAP[] = 
+static constexpr HostTypeMap HOST_TYPE_MAP[] = 
 {
-    { DINPUT_IDS, sizeof(DINPUT_IDS) / sizeof(HardwareID), HostDriverType::DINPUT },
-    { PS4_IDS, sizeof(PS4_IDS) / sizeof(HardwareID), HostDriverType::PS4 },
-    { PS5_IDS, sizeof(PS5_IDS) / sizeof(HardwareID), HostDriverType::PS5 },
-    { PS3_IDS, sizeof(PS3_IDS) / sizeof(HardwareID), HostDriverType::PS3 },
-    { SWITCH_WIRED_IDS, sizeof(SWITCH_WIRED_IDS) / sizeof(HardwareID), HostDriverType::SWITCH },
-    { SWITCH_PRO_IDS, sizeof(SWITCH_PRO_IDS) / sizeof(HardwareID), HostDriverType::SWITCH_PRO },
-    { PSCLASSIC_IDS, sizeof(PSCLASSIC_IDS) / sizeof(HardwareID), HostDriverType::PSCLASSIC },
-    { N64_IDS, sizeof(N64_IDS) / sizeof(HardwareID), HostDriverType::N64 },
+    { DINPUT_IDS, std::size(DINPUT_IDS), HostDriverType::DINPUT },
+    { PS4_IDS, std::size(PS4_IDS), HostDriverType::PS4 },
+    { PS5_IDS, std::size(PS5_IDS), HostDriverType::PS5 },
+    { PS3_IDS, std::size(PS3_IDS), HostDriverType::PS3 },
+    { SWITCH_WIRED_IDS, std::size(SWITCH_WIRED_IDS), HostDriverType::SWITCH },
+    { SWITCH_PRO_IDS, std::size(SWITCH_PRO_IDS), HostDriverType::SWITCH_PRO },
+    { PSCLASSIC_IDS, std::size(PSCLASSIC_IDS), HostDriverType::PSCLASSIC },
+    { N64_IDS, std::size(N64_IDS), HostDriverType::N64 },
 };
 
+//Flattened copy of HOST_TYPE_MAP sorted by (vid << 16) | pid so lookups are a binary search
+namespace HardwareIDTable
+{
+    struct Entry
+    {
+        uint32_t key;
+        HostDriverType type;
+    };
+
+    template <size_t NumMaps>
+    constexpr size_t count(const HostTypeMap (&maps)[NumMaps])
+    {
+        size_t num_ids = 0;
+        for (const auto& map : maps)
+        {
+            num_ids += map.num_ids;
+        }
+        return num_ids;
+    }
+
+    template <size_t NumIDs, size_t NumMaps>
+    constexpr std::array<Entry, NumIDs> build(const HostTypeMap (&maps)[NumMaps])
+    {
+        std::array<Entry, NumIDs> table{};
+        size_t idx = 0;
+        for (const auto& map : maps)
+        {
+            for (size_t i = 0; i < map.num_ids; ++i)
+            {
+                table[idx++] = { map.ids[i].key(), map.type };
+            }
+        }
+        std::sort(table.begin(), table.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+        return table;
+    }
+
+    //Same ID listed more than once, either for the same type or for different ones
+    template <size_t NumIDs>
+    constexpr bool has_duplicates(const std::array<Entry, NumIDs>& table)
+    {
+        for (size_t i = 1; i < NumIDs; ++i)
+        {
+            if (table[i].key == table[i - 1].key && table[i].type == table[i - 1].type)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    template <size_t NumIDs>
+    constexpr bool has_conflicts(const std::array<Entry, NumIDs>& table)
+    {
+        for (size_t i = 1; i < NumIDs; ++i)
+        {
+            if (table[i].key == table[i - 1].key && table[i].type != table[i - 1].type)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <size_t NumIDs>
+    constexpr HostDriverType find(const std::array<Entry, NumIDs>& table, const HardwareID& ids)
+    {
+        const uint32_t key = ids.key();
+        auto it = std::lower_bound(table.begin(), table.end(), key, 
+            [](const Entry& entry, uint32_t key) { return entry.key < key; });
+
+        return (it != table.end() && it->key == key) ? it->type : HostDriverType::UNKNOWN;
+    }
+
+} // namespace HardwareIDTable
+
+static constexpr auto HARDWARE_ID_TABLE = HardwareIDTable::build<HardwareIDTable::count(HOST_TYPE_MAP)>(HOST_TYPE_MAP);
+
+static_assert(!HardwareIDTable::has_duplicates(HARDWARE_ID_TABLE), "HardwareIDs: VID/PID listed twice");
+static_assert(!HardwareIDTable::has_conflicts(HARDWARE_ID_TABLE), "HardwareIDs: VID/PID mapped to more than one driver type");
+static_assert(HardwareIDTable::find(HARDWARE_ID_TABLE, { 0x054C, 0x0CE6 }) == HostDriverType::PS5, "HardwareIDs: table lookup broken");
+
 #endif // _HW_ID_H_
\ No newline at end of file
@@ -25,45 +25,45 @@ void DInputHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t insta
     switch (in_report->dpad & DInput::DPAD_MASK)
     {
         case DInput::DPad::UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
+            gp_in.dpad |= Gamepad::DPAD_UP;
             break;
         case DInput::DPad::DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
+            gp_in.dpad |= Gamepad::DPAD_DOWN;
             break;
         case DInput::DPad::LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_LEFT;
             break;
         case DInput::DPad::RIGHT: 
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_RIGHT;
             break;
         case DInput::DPad::UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_UP_RIGHT;
             break;
         case DInput::DPad::DOWN_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_RIGHT;
             break;
         case DInput::DPad::DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_LEFT;
             break;
         case DInput::DPad::UP_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_UP_LEFT;
             break;
         default:
             break;
     }
 
-    if (in_report->buttons[0] & DInput::Buttons0::SQUARE)   gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons[0] & DInput::Buttons0::CROSS)    gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[0] & DInput::Buttons0::CIRCLE)   gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[0] & DInput::Buttons0::TRIANGLE) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons[0] & DInput::Buttons0::L1)       gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[0] & DInput::Buttons0::R1)       gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & DInput::Buttons1::L3)       gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[1] & DInput::Buttons1::R3)       gp_in.buttons |= gamepad.MAP_BUTTON_R3; 
-    if (in_report->buttons[1] & DInput::Buttons1::SELECT)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[1] & DInput::Buttons1::START)    gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[1] & DInput::Buttons1::SYS)      gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report->buttons[1] & DInput::Buttons1::TP)       gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
+    if (in_report->buttons[0] & DInput::Buttons0::SQUARE)   gp_in.buttons |= Gamepad::BUTTON_X;
+    if (in_report->buttons[0] & DInput::Buttons0::CROSS)    gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report->buttons[0] & DInput::Buttons0::CIRCLE)   gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report->buttons[0] & DInput::Buttons0::TRIANGLE) gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (in_report->buttons[0] & DInput::Buttons0::L1)       gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report->buttons[0] & DInput::Buttons0::R1)       gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (in_report->buttons[1] & DInput::Buttons1::L3)       gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (in_report->buttons[1] & DInput::Buttons1::R3)       gp_in.buttons |= Gamepad::BUTTON_R3; 
+    if (in_report->buttons[1] & DInput::Buttons1::SELECT)   gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (in_report->buttons[1] & DInput::Buttons1::START)    gp_in.buttons |= Gamepad::BUTTON_START;
+    if (in_report->buttons[1] & DInput::Buttons1::SYS)      gp_in.buttons |= Gamepad::BUTTON_SYS;
+    if (in_report->buttons[1] & DInput::Buttons1::TP)       gp_in.buttons |= Gamepad::BUTTON_MISC;
 
     if (gamepad.analog_enabled())
     {
@@ -99,6 +99,9 @@ void DInputHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t insta
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(in_report->joystick_lx, in_report->joystick_ly);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(in_report->joystick_rx, in_report->joystick_ry);
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_hid_receive_report(address, instance);
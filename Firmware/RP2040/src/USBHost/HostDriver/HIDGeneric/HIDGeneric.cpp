@@ -1,22 +1,33 @@
 #include <cstring>
-#include <memory>
+#include <algorithm>
 
 #include "host/usbh.h"
 #include "class/hid/hid_host.h"
 
+#include "Board/ogxm_log.h"
 #include "USBHost/HIDParser/HIDReportDescriptor.h"
 #include "USBHost/HostDriver/HIDGeneric/HIDGeneric.h"
 
+static_assert(MAX_RUMBLE_REPORT_SIZE <= CFG_TUH_HID_EPOUT_BUFSIZE, "HIDHost: rumble report won't fit the OUT endpoint buffer");
+
+//Only needed while a descriptor is compiled, mounts all run on the host core so one is shared
+static HIDReportArena report_arena;
+
 void HIDHost::initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len)
 {
     if (!report_desc || desc_len == 0)
     {
         return;
     }
-    
-    report_desc_len_ = desc_len;
-    std::memcpy(report_desc_buffer_.data(), report_desc, std::min(static_cast<size_t>(report_desc_len_), report_desc_buffer_.size()));
-    hid_joystick_ = std::make_unique<HIDJoystick>(std::make_shared<HIDReportDescriptor>(report_desc_buffer_.data(), report_desc_len_));
+
+    //Parsed straight from TinyUSB's buffer, it's valid for the whole mount callback
+    HIDReportDescriptor descriptor(report_arena, report_desc, desc_len);
+    if (descriptor.GetResult() != HIDParseResult::Ok)
+    {
+        OGXM_LOG("HID report descriptor rejected: %d\n", static_cast<int>(descriptor.GetResult()));
+    }
+    hid_joystick_.compile(descriptor);
+    hid_rumble_.compile(descriptor);
 
     tuh_hid_receive_report(address, instance);
 }
@@ -30,68 +41,109 @@ void HIDHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     }
 
     std::memcpy(prev_report_in_.data(), report, len);
-    if (!hid_joystick_->parseData(const_cast<uint8_t*>(report), len, &hid_joystick_data_))
+
+    const int8_t player = hid_joystick_.parseData(const_cast<uint8_t*>(report), len, hid_joystick_data_.data(), static_cast<uint8_t>(hid_joystick_data_.size()));
+    Gamepad* player_gamepad = (player == 0) ? &gamepad : ((player > 0) ? players_[player] : nullptr);
+    if (player_gamepad)
     {
-        tuh_hid_receive_report(address, instance);
-        return;
+        update_gamepad(*player_gamepad, hid_joystick_data_[player]);
     }
 
+    tuh_hid_receive_report(address, instance);
+}
+
+void HIDHost::update_gamepad(Gamepad& gamepad, const HIDJoystickData& joystick)
+{
     Gamepad::PadIn gp_in;   
 
-    switch (hid_joystick_data_.hat_switch)
+    switch (joystick.hat_switch)
     {
         case HIDJoystickHatSwitch::UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
+            gp_in.dpad |= Gamepad::DPAD_UP;
             break;
         case HIDJoystickHatSwitch::UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_UP_RIGHT;
             break;
         case HIDJoystickHatSwitch::RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_RIGHT;
             break;
         case HIDJoystickHatSwitch::DOWN_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_RIGHT;
             break;
         case HIDJoystickHatSwitch::DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
+            gp_in.dpad |= Gamepad::DPAD_DOWN;
             break;
         case HIDJoystickHatSwitch::DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_LEFT;
             break;
         case HIDJoystickHatSwitch::LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_LEFT;
             break;
         case HIDJoystickHatSwitch::UP_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_UP_LEFT;
             break;
         default:
             break;
     }
 
-    std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(hid_joystick_data_.X, hid_joystick_data_.Y);
-    std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(hid_joystick_data_.Z, hid_joystick_data_.Rz);
-
-    if (hid_joystick_data_.buttons[1])  gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (hid_joystick_data_.buttons[2])  gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (hid_joystick_data_.buttons[3])  gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (hid_joystick_data_.buttons[4])  gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (hid_joystick_data_.buttons[5])  gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (hid_joystick_data_.buttons[6])  gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (hid_joystick_data_.buttons[7])  gp_in.trigger_l = Range::MAX<uint8_t>;
-    if (hid_joystick_data_.buttons[8])  gp_in.trigger_r = Range::MAX<uint8_t>;
-    if (hid_joystick_data_.buttons[9])  gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (hid_joystick_data_.buttons[10]) gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (hid_joystick_data_.buttons[11]) gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (hid_joystick_data_.buttons[12]) gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (hid_joystick_data_.buttons[13]) gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (hid_joystick_data_.buttons[14]) gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
+    std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(joystick.X, joystick.Y);
+    std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(joystick.Z, joystick.Rz);
 
-    gamepad.set_pad_in(gp_in);
+    if (joystick.buttons[1])  gp_in.buttons |= Gamepad::BUTTON_X;
+    if (joystick.buttons[2])  gp_in.buttons |= Gamepad::BUTTON_A;
+    if (joystick.buttons[3])  gp_in.buttons |= Gamepad::BUTTON_B;
+    if (joystick.buttons[4])  gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (joystick.buttons[5])  gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (joystick.buttons[6])  gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (joystick.buttons[7])  gp_in.trigger_l = Range::MAX<uint8_t>;
+    if (joystick.buttons[8])  gp_in.trigger_r = Range::MAX<uint8_t>;
+    if (joystick.buttons[9])  gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (joystick.buttons[10]) gp_in.buttons |= Gamepad::BUTTON_START;
+    if (joystick.buttons[11]) gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (joystick.buttons[12]) gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (joystick.buttons[13]) gp_in.buttons |= Gamepad::BUTTON_SYS;
+    if (joystick.buttons[14]) gp_in.buttons |= Gamepad::BUTTON_MISC;
 
-    tuh_hid_receive_report(address, instance);
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
+    gamepad.set_pad_in(gp_in);
 }
 
 bool HIDHost::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
+    //Nothing to drive, don't leave the doorbell pending
+    if (!hid_rumble_.isValid())
+    {
+        return true;
+    }
+
+    Gamepad::PadOut gp_out = gamepad.get_pad_out();
+    rumble_pending_ |= hid_rumble_.encode(gp_out.rumble_l, gp_out.rumble_r);
+
+    //Only changes go out, a busy endpoint keeps the report pending for the next call
+    if (rumble_pending_)
+    {
+        if (!tuh_hid_send_report(address, instance, hid_rumble_.getReportId(), hid_rumble_.getReport(), hid_rumble_.getReportLength()))
+        {
+            return false;
+        }
+        rumble_pending_ = false;
+    }
+
+    manage_rumble(gamepad);
     return true;
+}
+
+uint8_t HIDHost::gamepad_count() const
+{
+    return std::min(hid_joystick_.getCount(), static_cast<uint8_t>(MAX_GAMEPADS));
+}
+
+void HIDHost::attach_gamepad(uint8_t player, Gamepad& gamepad)
+{
+    if (player > 0 && player < players_.size())
+    {
+        players_[player] = &gamepad;
+    }
 }
\ No newline at end of file
@@ -3,11 +3,11 @@
 
 #include <cstdint>
 #include <array>
-#include <memory>
 
 #include "tusb_option.h"
 
 #include "USBHost/HIDParser/HIDJoystick.h"
+#include "USBHost/HIDParser/HIDRumble.h"
 #include "USBHost/HostDriver/HostDriver.h"
 
 class HIDHost : public HostDriver
@@ -20,12 +20,19 @@ public:
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
 
+    //One player per joystick/gamepad collection
+    uint8_t gamepad_count() const override;
+    void attach_gamepad(uint8_t player, Gamepad& gamepad) override;
+
 private:
-    std::array<uint8_t, 0x100> report_desc_buffer_;
-    uint16_t report_desc_len_{0};
     std::array<uint8_t, CFG_TUH_HID_EPIN_BUFSIZE> prev_report_in_{0};
-    std::unique_ptr<HIDJoystick> hid_joystick_;
-    HIDJoystickData hid_joystick_data_;
+    HIDJoystick hid_joystick_;
+    HIDRumble hid_rumble_;
+    bool rumble_pending_{false}; //Encoded into hid_rumble_ but not sent yet
+    std::array<HIDJoystickData, MAX_GAMEPADS> hid_joystick_data_;
+    std::array<Gamepad*, MAX_GAMEPADS> players_{}; //Collections after the first, reports for one without a gamepad are dropped
+
+    void update_gamepad(Gamepad& gamepad, const HIDJoystickData& joystick);
 };
 
 #endif // _HID_GENERIC_HOST_H_
\ No newline at end of file
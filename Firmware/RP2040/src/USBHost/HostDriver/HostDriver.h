@@ -21,6 +21,13 @@ public:
     virtual void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) = 0;
     virtual bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) = 0;
 
+    //Minimum time between send_feedback() calls triggered by the rumble doorbell
+    virtual uint32_t feedback_interval_ms() const { return 8; }
+
+    //Players one interface can drive, known after initialize(). HostManager hands each extra one a free gamepad
+    virtual uint8_t gamepad_count() const { return 1; }
+    virtual void attach_gamepad(uint8_t player, Gamepad& gamepad) {};
+
     virtual void connect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) {}; //Wireless specific
     virtual void disconnect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) {}; //Wireless specific
 
@@ -41,9 +48,10 @@ protected:
             gp_out.rumble_r = 0;
             reset = true;
         }
+        //No doorbell, the reset goes out with the next periodic send_feedback() so the rumble lasts that long
         if (reset)
         {
-            gamepad.set_pad_out(gp_out);
+            gamepad.set_pad_out(gp_out, false);
         }
     }
 };
@@ -24,38 +24,38 @@ void N64Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     switch (in_report->buttons & N64::DPAD_MASK)
     {
         case N64::Buttons::DPAD_UP:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP;
+            gp_in.dpad |= Gamepad::DPAD_UP;
             break;
         case N64::Buttons::DPAD_UP_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_UP_RIGHT;
             break;
         case N64::Buttons::DPAD_RIGHT:
-            gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;  
+            gp_in.dpad |= Gamepad::DPAD_RIGHT;  
             break;
         case N64::Buttons::DPAD_RIGHT_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_RIGHT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_RIGHT;
             break;
         case N64::Buttons::DPAD_DOWN:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
+            gp_in.dpad |= Gamepad::DPAD_DOWN;
             break;
         case N64::Buttons::DPAD_DOWN_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_DOWN_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_DOWN_LEFT;
             break;
         case N64::Buttons::DPAD_LEFT:
-            gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_LEFT;
             break;
         case N64::Buttons::DPAD_LEFT_UP:    
-            gp_in.dpad |= gamepad.MAP_DPAD_UP_LEFT;
+            gp_in.dpad |= Gamepad::DPAD_UP_LEFT;
             break;  
         default:
             break;
     }
 
-    if (in_report->buttons & N64::Buttons::A) gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons & N64::Buttons::B) gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons & N64::Buttons::L) gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons & N64::Buttons::R) gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons & N64::Buttons::START) gp_in.buttons |= gamepad.MAP_BUTTON_START;
+    if (in_report->buttons & N64::Buttons::A) gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report->buttons & N64::Buttons::B) gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report->buttons & N64::Buttons::L) gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report->buttons & N64::Buttons::R) gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (in_report->buttons & N64::Buttons::START) gp_in.buttons |= Gamepad::BUTTON_START;
 
     uint8_t joy_ry = N64::JOY_MID;
     uint8_t joy_rx = N64::JOY_MID;
@@ -99,6 +99,9 @@ void N64Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
 
     gp_in.trigger_l = (in_report->buttons & N64::Buttons::L) ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_hid_receive_report(address, instance);
@@ -106,22 +106,22 @@ void PS3Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
 
     Gamepad::PadIn gp_in;   
 
-    if (in_report->buttons[0] & PS3::Buttons0::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons[0] & PS3::Buttons0::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons[0] & PS3::Buttons0::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons[0] & PS3::Buttons0::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-
-    if (in_report->buttons[0] & PS3::Buttons0::SELECT)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[0] & PS3::Buttons0::START)    gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[0] & PS3::Buttons0::L3)       gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[0] & PS3::Buttons0::R3)       gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report->buttons[1] & PS3::Buttons1::L1)       gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[1] & PS3::Buttons1::R1)       gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & PS3::Buttons1::TRIANGLE) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons[1] & PS3::Buttons1::CIRCLE)   gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[1] & PS3::Buttons1::CROSS)    gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[1] & PS3::Buttons1::SQUARE)   gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->buttons[2] & PS3::Buttons2::SYS)      gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
+    if (in_report->buttons[0] & PS3::Buttons0::DPAD_UP)    gp_in.dpad |= Gamepad::DPAD_UP;
+    if (in_report->buttons[0] & PS3::Buttons0::DPAD_DOWN)  gp_in.dpad |= Gamepad::DPAD_DOWN;
+    if (in_report->buttons[0] & PS3::Buttons0::DPAD_LEFT)  gp_in.dpad |= Gamepad::DPAD_LEFT;
+    if (in_report->buttons[0] & PS3::Buttons0::DPAD_RIGHT) gp_in.dpad |= Gamepad::DPAD_RIGHT;
+
+    if (in_report->buttons[0] & PS3::Buttons0::SELECT)   gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (in_report->buttons[0] & PS3::Buttons0::START)    gp_in.buttons |= Gamepad::BUTTON_START;
+    if (in_report->buttons[0] & PS3::Buttons0::L3)       gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (in_report->buttons[0] & PS3::Buttons0::R3)       gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (in_report->buttons[1] & PS3::Buttons1::L1)       gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report->buttons[1] & PS3::Buttons1::R1)       gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (in_report->buttons[1] & PS3::Buttons1::TRIANGLE) gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (in_report->buttons[1] & PS3::Buttons1::CIRCLE)   gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report->buttons[1] & PS3::Buttons1::CROSS)    gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report->buttons[1] & PS3::Buttons1::SQUARE)   gp_in.buttons |= Gamepad::BUTTON_X;
+    if (in_report->buttons[2] & PS3::Buttons2::SYS)      gp_in.buttons |= Gamepad::BUTTON_SYS;
 
     if (gamepad.analog_enabled())
     {
@@ -143,6 +143,9 @@ void PS3Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(in_report->joystick_lx, in_report->joystick_ly);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(in_report->joystick_rx, in_report->joystick_ry);
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_hid_receive_report(address, instance);
@@ -151,25 +154,24 @@ void PS3Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t instance
 
 bool PS3Host::send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance)
 {
-    static uint32_t last_rumble_ms = 0;
-
     uint32_t current_ms = time_us_32() / 1000;
     
-    //Spamming set_report doesn't work, limit the rate
-    if (init_state_.reports_enabled &&
-        current_ms - last_rumble_ms >= 300)
+    //Spamming set_report doesn't work, limit the rate. Nothing sent is a false so a doorbell stays pending
+    if (!init_state_.reports_enabled ||
+        current_ms - last_rumble_ms_ < RUMBLE_INTERVAL_MS)
     {
-        Gamepad::PadOut gp_out = gamepad.get_pad_out();
+        return false;
+    }
 
-        out_report_.rumble.right_duration    = (gp_out.rumble_r > 0) ? 20 : 0;
-        out_report_.rumble.right_motor_on    = (gp_out.rumble_r > 0) ? 1  : 0;
+    Gamepad::PadOut gp_out = gamepad.get_pad_out();
 
-        out_report_.rumble.left_duration     = (gp_out.rumble_l > 0) ? 20 : 0;
-        out_report_.rumble.left_motor_force  = gp_out.rumble_l;
+    out_report_.rumble.right_duration    = (gp_out.rumble_r > 0) ? 20 : 0;
+    out_report_.rumble.right_motor_on    = (gp_out.rumble_r > 0) ? 1  : 0;
 
-        last_rumble_ms = current_ms;
+    out_report_.rumble.left_duration     = (gp_out.rumble_l > 0) ? 20 : 0;
+    out_report_.rumble.left_motor_force  = gp_out.rumble_l;
 
-        return send_control_xfer(address, &PS3Host::RUMBLE_REQUEST, reinterpret_cast<uint8_t*>(&out_report_), nullptr, 0);
-    }
-    return true;
+    last_rumble_ms_ = current_ms;
+
+    return send_control_xfer(address, &PS3Host::RUMBLE_REQUEST, reinterpret_cast<uint8_t*>(&out_report_), nullptr, 0);
 }
\ No newline at end of file
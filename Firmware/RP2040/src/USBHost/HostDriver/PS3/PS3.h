@@ -18,8 +18,12 @@ public:
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    uint32_t feedback_interval_ms() const override { return RUMBLE_INTERVAL_MS + 10; } //Just over the limit in send_feedback()
 
 private:
+    //set_report gets ignored if spammed
+    static constexpr uint32_t RUMBLE_INTERVAL_MS = 300;
+
     enum class InitStage { RESP1, RESP2, RESP3, DONE };
 
     struct InitState
@@ -36,6 +40,7 @@ private:
     PS3::InReport prev_in_report_;
     PS3::OutReport out_report_;
     InitState init_state_;
+    uint32_t last_rumble_ms_{0};
 
     static bool send_control_xfer(uint8_t dev_addr, const tusb_control_request_t* req, uint8_t* buffer, tuh_xfer_cb_t complete_cb, uintptr_t user_data);
     static void get_report_complete_cb(tuh_xfer_s *xfer);
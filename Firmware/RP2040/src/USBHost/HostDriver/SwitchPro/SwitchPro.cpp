@@ -142,23 +142,23 @@ void SwitchProHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t in
 
     Gamepad::PadIn gp_in;   
 
-    if (in_report->buttons[0] & SwitchPro::Buttons0::Y)  gp_in.buttons |= gamepad.MAP_BUTTON_X;   
-    if (in_report->buttons[0] & SwitchPro::Buttons0::B)  gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::A)  gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::X)  gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::L)  gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->buttons[0] & SwitchPro::Buttons0::R)  gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::L3) gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::R3) gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::MINUS)     gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::PLUS)      gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::HOME)      gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report->buttons[1] & SwitchPro::Buttons1::CAPTURE)   gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
-
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
+    if (in_report->buttons[0] & SwitchPro::Buttons0::Y)  gp_in.buttons |= Gamepad::BUTTON_X;   
+    if (in_report->buttons[0] & SwitchPro::Buttons0::B)  gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report->buttons[0] & SwitchPro::Buttons0::A)  gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report->buttons[0] & SwitchPro::Buttons0::X)  gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (in_report->buttons[2] & SwitchPro::Buttons2::L)  gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report->buttons[0] & SwitchPro::Buttons0::R)  gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::L3) gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::R3) gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::MINUS)     gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::PLUS)      gp_in.buttons |= Gamepad::BUTTON_START;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::HOME)      gp_in.buttons |= Gamepad::BUTTON_SYS;
+    if (in_report->buttons[1] & SwitchPro::Buttons1::CAPTURE)   gp_in.buttons |= Gamepad::BUTTON_MISC;
+
+    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_UP)    gp_in.dpad |= Gamepad::DPAD_UP;
+    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_DOWN)  gp_in.dpad |= Gamepad::DPAD_DOWN;
+    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_LEFT)  gp_in.dpad |= Gamepad::DPAD_LEFT;
+    if (in_report->buttons[2] & SwitchPro::Buttons2::DPAD_RIGHT) gp_in.dpad |= Gamepad::DPAD_RIGHT;
 
     gp_in.trigger_l = in_report->buttons[2] & SwitchPro::Buttons2::ZL ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
     gp_in.trigger_r = in_report->buttons[0] & SwitchPro::Buttons0::ZR ? Range::MAX<uint8_t> : Range::MIN<uint8_t>;
@@ -174,6 +174,9 @@ void SwitchProHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t in
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = 
         gamepad.scale_joystick_r(normalize_axis(joy_rx), normalize_axis(joy_ry), true);
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_hid_receive_report(address, instance);
@@ -22,22 +22,22 @@ void Xbox360Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t inst
 
     Gamepad::PadIn gp_in;
 
-    if (in_report_->buttons[0] & XInput::Buttons0::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report_->buttons[0] & XInput::Buttons0::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report_->buttons[0] & XInput::Buttons0::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report_->buttons[0] & XInput::Buttons0::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-
-    if (in_report_->buttons[0] & XInput::Buttons0::START)  gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report_->buttons[0] & XInput::Buttons0::BACK)   gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report_->buttons[0] & XInput::Buttons0::L3)     gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report_->buttons[0] & XInput::Buttons0::R3)     gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (in_report_->buttons[1] & XInput::Buttons1::LB)     gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report_->buttons[1] & XInput::Buttons1::RB)     gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (in_report_->buttons[1] & XInput::Buttons1::HOME)   gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (in_report_->buttons[1] & XInput::Buttons1::A)      gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report_->buttons[1] & XInput::Buttons1::B)      gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report_->buttons[1] & XInput::Buttons1::X)      gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report_->buttons[1] & XInput::Buttons1::Y)      gp_in.buttons |= gamepad.MAP_BUTTON_Y;
+    if (in_report_->buttons[0] & XInput::Buttons0::DPAD_UP)    gp_in.dpad |= Gamepad::DPAD_UP;
+    if (in_report_->buttons[0] & XInput::Buttons0::DPAD_DOWN)  gp_in.dpad |= Gamepad::DPAD_DOWN;
+    if (in_report_->buttons[0] & XInput::Buttons0::DPAD_LEFT)  gp_in.dpad |= Gamepad::DPAD_LEFT;
+    if (in_report_->buttons[0] & XInput::Buttons0::DPAD_RIGHT) gp_in.dpad |= Gamepad::DPAD_RIGHT;
+
+    if (in_report_->buttons[0] & XInput::Buttons0::START)  gp_in.buttons |= Gamepad::BUTTON_START;
+    if (in_report_->buttons[0] & XInput::Buttons0::BACK)   gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (in_report_->buttons[0] & XInput::Buttons0::L3)     gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (in_report_->buttons[0] & XInput::Buttons0::R3)     gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (in_report_->buttons[1] & XInput::Buttons1::LB)     gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report_->buttons[1] & XInput::Buttons1::RB)     gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (in_report_->buttons[1] & XInput::Buttons1::HOME)   gp_in.buttons |= Gamepad::BUTTON_SYS;
+    if (in_report_->buttons[1] & XInput::Buttons1::A)      gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report_->buttons[1] & XInput::Buttons1::B)      gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report_->buttons[1] & XInput::Buttons1::X)      gp_in.buttons |= Gamepad::BUTTON_X;
+    if (in_report_->buttons[1] & XInput::Buttons1::Y)      gp_in.buttons |= Gamepad::BUTTON_Y;
 
     gp_in.trigger_l = gamepad.scale_trigger_l(in_report_->trigger_l);
     gp_in.trigger_r = gamepad.scale_trigger_r(in_report_->trigger_r);
@@ -45,6 +45,9 @@ void Xbox360Host::process_report(Gamepad& gamepad, uint8_t address, uint8_t inst
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(in_report_->joystick_lx, in_report_->joystick_ly, true);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(in_report_->joystick_rx, in_report_->joystick_ry, true);
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_xinput::receive_report(address, instance);
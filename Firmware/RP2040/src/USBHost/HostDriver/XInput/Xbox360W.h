@@ -17,6 +17,7 @@ public:
     void initialize(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report_desc, uint16_t desc_len) override;
     void process_report(Gamepad& gamepad, uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len) override;
     bool send_feedback(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
+    uint32_t feedback_interval_ms() const override { return 16; } //Shares the wireless link with the other pads on the receiver
 
     void connect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
     void disconnect_cb(Gamepad& gamepad, uint8_t address, uint8_t instance) override;
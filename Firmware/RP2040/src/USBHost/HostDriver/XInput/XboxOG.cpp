@@ -23,22 +23,22 @@ void XboxOGHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t insta
 
     Gamepad::PadIn gp_in;
 
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
+    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_UP)    gp_in.dpad |= Gamepad::DPAD_UP;
+    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_DOWN)  gp_in.dpad |= Gamepad::DPAD_DOWN;
+    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_LEFT)  gp_in.dpad |= Gamepad::DPAD_LEFT;
+    if (in_report->buttons & XboxOG::GP::Buttons::DPAD_RIGHT) gp_in.dpad |= Gamepad::DPAD_RIGHT;
 
-    if (in_report->a) gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (in_report->b) gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (in_report->x) gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (in_report->y) gp_in.buttons |= gamepad.MAP_BUTTON_Y;
-    if (in_report->black) gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (in_report->white) gp_in.buttons |= gamepad.MAP_BUTTON_RB;
+    if (in_report->a) gp_in.buttons |= Gamepad::BUTTON_A;
+    if (in_report->b) gp_in.buttons |= Gamepad::BUTTON_B;
+    if (in_report->x) gp_in.buttons |= Gamepad::BUTTON_X;
+    if (in_report->y) gp_in.buttons |= Gamepad::BUTTON_Y;
+    if (in_report->black) gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (in_report->white) gp_in.buttons |= Gamepad::BUTTON_RB;
 
-    if (in_report->buttons & XboxOG::GP::Buttons::START)   gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (in_report->buttons & XboxOG::GP::Buttons::BACK)    gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (in_report->buttons & XboxOG::GP::Buttons::L3)      gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (in_report->buttons & XboxOG::GP::Buttons::R3)      gp_in.buttons |= gamepad.MAP_BUTTON_R3;
+    if (in_report->buttons & XboxOG::GP::Buttons::START)   gp_in.buttons |= Gamepad::BUTTON_START;
+    if (in_report->buttons & XboxOG::GP::Buttons::BACK)    gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (in_report->buttons & XboxOG::GP::Buttons::L3)      gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (in_report->buttons & XboxOG::GP::Buttons::R3)      gp_in.buttons |= Gamepad::BUTTON_R3;
 
     if (gamepad.analog_enabled())
     {
@@ -60,6 +60,9 @@ void XboxOGHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t insta
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(in_report->joystick_lx, in_report->joystick_ly, true);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(in_report->joystick_rx, in_report->joystick_ry, true);
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_xinput::receive_report(address, instance);
@@ -22,23 +22,23 @@ void XboxOneHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t inst
     Gamepad::PadIn gp_in;
 
     const uint16_t b = in_report->buttons;
-    if (b & XboxOne::GamepadButtons::DPAD_UP)    gp_in.dpad |= gamepad.MAP_DPAD_UP;
-    if (b & XboxOne::GamepadButtons::DPAD_DOWN)  gp_in.dpad |= gamepad.MAP_DPAD_DOWN;
-    if (b & XboxOne::GamepadButtons::DPAD_LEFT)  gp_in.dpad |= gamepad.MAP_DPAD_LEFT;
-    if (b & XboxOne::GamepadButtons::DPAD_RIGHT) gp_in.dpad |= gamepad.MAP_DPAD_RIGHT;
-
-    if (b & XboxOne::GamepadButtons::LEFT_THUMB)  gp_in.buttons |= gamepad.MAP_BUTTON_L3;
-    if (b & XboxOne::GamepadButtons::RIGHT_THUMB) gp_in.buttons |= gamepad.MAP_BUTTON_R3;
-    if (b & XboxOne::GamepadButtons::LEFT_SHOULDER)  gp_in.buttons |= gamepad.MAP_BUTTON_LB;
-    if (b & XboxOne::GamepadButtons::RIGHT_SHOULDER) gp_in.buttons |= gamepad.MAP_BUTTON_RB;
-    if (b & XboxOne::GamepadButtons::VIEW)  gp_in.buttons |= gamepad.MAP_BUTTON_BACK;
-    if (b & XboxOne::GamepadButtons::MENU) gp_in.buttons |= gamepad.MAP_BUTTON_START;
-    if (b & XboxOne::GamepadButtons::SYNC)  gp_in.buttons |= gamepad.MAP_BUTTON_MISC;
-    if (in_report->guide_pressed) gp_in.buttons |= gamepad.MAP_BUTTON_SYS;
-    if (b & XboxOne::GamepadButtons::A)     gp_in.buttons |= gamepad.MAP_BUTTON_A;
-    if (b & XboxOne::GamepadButtons::B)     gp_in.buttons |= gamepad.MAP_BUTTON_B;
-    if (b & XboxOne::GamepadButtons::X)     gp_in.buttons |= gamepad.MAP_BUTTON_X;
-    if (b & XboxOne::GamepadButtons::Y)     gp_in.buttons |= gamepad.MAP_BUTTON_Y;
+    if (b & XboxOne::GamepadButtons::DPAD_UP)    gp_in.dpad |= Gamepad::DPAD_UP;
+    if (b & XboxOne::GamepadButtons::DPAD_DOWN)  gp_in.dpad |= Gamepad::DPAD_DOWN;
+    if (b & XboxOne::GamepadButtons::DPAD_LEFT)  gp_in.dpad |= Gamepad::DPAD_LEFT;
+    if (b & XboxOne::GamepadButtons::DPAD_RIGHT) gp_in.dpad |= Gamepad::DPAD_RIGHT;
+
+    if (b & XboxOne::GamepadButtons::LEFT_THUMB)  gp_in.buttons |= Gamepad::BUTTON_L3;
+    if (b & XboxOne::GamepadButtons::RIGHT_THUMB) gp_in.buttons |= Gamepad::BUTTON_R3;
+    if (b & XboxOne::GamepadButtons::LEFT_SHOULDER)  gp_in.buttons |= Gamepad::BUTTON_LB;
+    if (b & XboxOne::GamepadButtons::RIGHT_SHOULDER) gp_in.buttons |= Gamepad::BUTTON_RB;
+    if (b & XboxOne::GamepadButtons::VIEW)  gp_in.buttons |= Gamepad::BUTTON_BACK;
+    if (b & XboxOne::GamepadButtons::MENU) gp_in.buttons |= Gamepad::BUTTON_START;
+    if (b & XboxOne::GamepadButtons::SYNC)  gp_in.buttons |= Gamepad::BUTTON_MISC;
+    if (in_report->guide_pressed) gp_in.buttons |= Gamepad::BUTTON_SYS;
+    if (b & XboxOne::GamepadButtons::A)     gp_in.buttons |= Gamepad::BUTTON_A;
+    if (b & XboxOne::GamepadButtons::B)     gp_in.buttons |= Gamepad::BUTTON_B;
+    if (b & XboxOne::GamepadButtons::X)     gp_in.buttons |= Gamepad::BUTTON_X;
+    if (b & XboxOne::GamepadButtons::Y)     gp_in.buttons |= Gamepad::BUTTON_Y;
 
     gp_in.trigger_l = gamepad.scale_trigger_l(static_cast<uint8_t>(in_report->trigger_l >> 2));
     gp_in.trigger_r = gamepad.scale_trigger_r(static_cast<uint8_t>(in_report->trigger_r >> 2));
@@ -46,6 +46,9 @@ void XboxOneHost::process_report(Gamepad& gamepad, uint8_t address, uint8_t inst
     std::tie(gp_in.joystick_lx, gp_in.joystick_ly) = gamepad.scale_joystick_l(in_report->joystick_lx, in_report->joystick_ly, true);
     std::tie(gp_in.joystick_rx, gp_in.joystick_ry) = gamepad.scale_joystick_r(in_report->joystick_rx, in_report->joystick_ry, true);
 
+    gp_in.dpad = gamepad.map_dpad(gp_in.dpad);
+    gp_in.buttons = gamepad.map_buttons(gp_in.buttons);
+
     gamepad.set_pad_in(gp_in);
 
     tuh_xinput::receive_report(address, instance);
@@ -2,7 +2,9 @@
 #define _HOST_MANAGER_H_
 
 #include <cstdint>
-#include <memory>	
+#include <variant>
+#include <atomic>
+#include <hardware/timer.h>
 #include <hardware/regs/usb.h>
 #include <hardware/irq.h>
 #include <hardware/structs/usb.h>
@@ -40,6 +42,14 @@ class HostManager
 public:
 	enum class DriverClass { NONE, HID, XINPUT };
 
+	//Every host driver fits in one of these, sized by the largest
+	using DriverStorage = std::variant<	std::monostate, PS5Host, PS4Host, PS3Host, DInputHost, SwitchWiredHost, SwitchProHost, 
+										N64Host, PSClassicHost, XboxOGHost, XboxOneHost, Xbox360Host, Xbox360WHost, HIDHost>;
+
+	//Worst case static footprint of the host drivers
+	static constexpr size_t DRIVER_POOL_SIZE = sizeof(DriverStorage) * MAX_GAMEPADS;
+	static_assert(sizeof(DriverStorage) <= 1536, "HostManager: a host driver grew past the pool budget");
+
 	HostManager(HostManager const&) = delete;
 	void operator=(HostManager const&)  = delete;
 
@@ -54,14 +64,15 @@ public:
 		for (size_t i = 0; i < MAX_GAMEPADS; ++i)
 		{
 			gamepads_[i] = &gamepads[i];
+			gamepads_[i]->set_pad_out_doorbell(ring_feedback_doorbell, static_cast<uint8_t>(i));
 		}
+		debug_printf("Host driver pool: %d bytes, %d per gamepad\n", static_cast<int>(DRIVER_POOL_SIZE), static_cast<int>(sizeof(DriverStorage)));
 	}
 
 	//XInput doesn't need report_desc or desc_len
 	inline bool setup_driver(const HostDriverType driver_type, const uint8_t address, const uint8_t instance, uint8_t const* report_desc = nullptr, uint16_t desc_len = 0)
 	{
-		uint8_t gp_idx = find_free_gamepad();
-		if (gp_idx == INVALID_IDX || instance >= MAX_INTERFACES)
+		if (instance >= MAX_INTERFACES || address > MAX_DEVICE_ADDRESS)
 		{
 			return false;
 		}
@@ -77,62 +88,71 @@ public:
 		Device& device_slot = device_slots_[dev_idx];
 		Interface& interface = device_slot.interfaces[instance];
 
+		//Mounted again without an unmount in between, free its gamepads so they're handed out again
+		release_interface(address, instance, interface);
+
+		uint8_t gp_idx = find_free_gamepad();
+		if (gp_idx == INVALID_IDX)
+		{
+			return false;
+		}
+
 		debug_printf("Attempting to allocate driver for index %d\n", gp_idx);
 
 		switch (driver_type)
 		{
 			case HostDriverType::PS5:
 				debug_printf("PS5 Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<PS5Host>(gp_idx);
+				interface.driver = emplace_driver<PS5Host>(gp_idx);
 				break;
 			case HostDriverType::PS4:
 				debug_printf("PS4 Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<PS4Host>(gp_idx);
+				interface.driver = emplace_driver<PS4Host>(gp_idx);
 				break;
 			case HostDriverType::PS3:
 				debug_printf("PS3 Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<PS3Host>(gp_idx);
+				interface.driver = emplace_driver<PS3Host>(gp_idx);
 				break;
 			case HostDriverType::DINPUT:
 				debug_printf("DINPUT Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<DInputHost>(gp_idx);
+				interface.driver = emplace_driver<DInputHost>(gp_idx);
 				break;
 			case HostDriverType::SWITCH:
 				debug_printf("SWITCH Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<SwitchWiredHost>(gp_idx);
+				interface.driver = emplace_driver<SwitchWiredHost>(gp_idx);
 				break;
 			case HostDriverType::SWITCH_PRO:
 				debug_printf("SWITCH PRO Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<SwitchProHost>(gp_idx);
+				interface.driver = emplace_driver<SwitchProHost>(gp_idx);
 				break;
 			case HostDriverType::N64:
 				debug_printf("N64 Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<N64Host>(gp_idx);
+				interface.driver = emplace_driver<N64Host>(gp_idx);
 				break;
 			case HostDriverType::PSCLASSIC:
 				debug_printf("PSCLASSIC Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<PSClassicHost>(gp_idx);
+				interface.driver = emplace_driver<PSClassicHost>(gp_idx);
 				break;
 			case HostDriverType::XBOXOG:
 				debug_printf("XBOXOG Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<XboxOGHost>(gp_idx);
+				interface.driver = emplace_driver<XboxOGHost>(gp_idx);
 				break;
 			case HostDriverType::XBOXONE:
 				debug_printf("XBOXONE Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<XboxOneHost>(gp_idx);
+				interface.driver = emplace_driver<XboxOneHost>(gp_idx);
 				break;
 			case HostDriverType::XBOX360:
 				debug_printf("XBOX360 Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<Xbox360Host>(gp_idx);
+				interface.driver = emplace_driver<Xbox360Host>(gp_idx);
 				break;
 			case HostDriverType::XBOX360W: //Composite device, takes up all 4 gamepads when mounted
 				debug_printf("XBOX360W Loaded\n"); fflush(stdout);
-				interface.driver = std::make_unique<Xbox360WHost>(gp_idx);
+				interface.driver = emplace_driver<Xbox360WHost>(gp_idx);
 				break;
 			default:
 				if (is_hid_gamepad(report_desc, desc_len))
 				{
-					interface.driver = std::make_unique<HIDHost>(gp_idx);
+					interface.driver = emplace_driver<HIDHost>(gp_idx);
 					debug_printf("HIDHOST Loaded\n"); fflush(stdout);
 				}
 				else
@@ -151,49 +171,97 @@ public:
 		interface.gamepad->set_stick_y_positive_is_up(xbox_stick_y);
 		interface.driver->initialize(*interface.gamepad, device_slot.address, instance, report_desc, desc_len);
 
+		//Extra players (a HID device with several joystick collections) take whatever gamepads are left
+		for (uint8_t player = 1; player < interface.driver->gamepad_count(); ++player)
+		{
+			const uint8_t extra_idx = find_free_gamepad();
+			if (extra_idx == INVALID_IDX)
+			{
+				break;
+			}
+			debug_printf("Player %d of interface %d on gamepad %d\n", player, instance, extra_idx);
+			interface.extra_gamepads |= (1u << extra_idx);
+			gamepads_[extra_idx]->set_stick_y_positive_is_up(xbox_stick_y);
+			interface.driver->attach_gamepad(player, *gamepads_[extra_idx]);
+		}
+
+		interface_map_[address][instance] = &interface;
 		return true;
 	}
 
 	inline void process_report(uint8_t address, uint8_t instance, const uint8_t* report, uint16_t len)
 	{
-		for (auto& device_slot : device_slots_)
+		if (Interface* interface = find_interface(address, instance))
 		{
-			if (device_slot.address == address && 
-				device_slot.interfaces[instance].driver &&
-				device_slot.interfaces[instance].gamepad)
-			{
-				device_slot.interfaces[instance].driver->process_report(*device_slot.interfaces[instance].gamepad, address, instance, report, len);
-			}
+			interface->driver->process_report(*interface->gamepad, address, instance, report, len);
 		}
 	}
 
 	inline void connect_cb(uint8_t address, uint8_t instance)
 	{
-		for (auto& device_slot : device_slots_)
+		if (Interface* interface = find_interface(address, instance))
 		{
-			if (device_slot.address == address && 
-				device_slot.interfaces[instance].driver &&
-				device_slot.interfaces[instance].gamepad)
-			{
-				device_slot.interfaces[instance].driver->connect_cb(*device_slot.interfaces[instance].gamepad, address, instance);
-			}
+			interface->driver->connect_cb(*interface->gamepad, address, instance);
 		}
 	}
 
 	inline void disconnect_cb(uint8_t address, uint8_t instance)
 	{
+		if (Interface* interface = find_interface(address, instance))
+		{
+			interface->driver->disconnect_cb(*interface->gamepad, address, instance);
+		}
+	}
+
+	//Call from the host loop, forwards rumble rung in by Gamepad::set_pad_out() without waiting for send_feedback().
+	//Interfaces still inside their driver's feedback_interval_ms(), or whose endpoint was busy, stay pending.
+	inline void process_feedback()
+	{
+		uint32_t pending = feedback_pending_.exchange(0);
+		if (!pending)
+		{
+			return;
+		}
+
+		const uint64_t now = time_us_64();
+		uint32_t deferred = 0;
+
 		for (auto& device_slot : device_slots_)
 		{
-			if (device_slot.address == address && 
-				device_slot.interfaces[instance].driver &&
-				device_slot.interfaces[instance].gamepad)
+			if (device_slot.address == INVALID_IDX)
 			{
-				device_slot.interfaces[instance].driver->disconnect_cb(*device_slot.interfaces[instance].gamepad, address, instance);
+				continue;
+			}
+			for (uint8_t i = 0; i < MAX_INTERFACES; ++i)
+			{
+				Interface& interface = device_slot.interfaces[i];
+				if (!interface.driver)
+				{
+					continue;
+				}
+				//Extra players ring their own gamepad's bit, their feedback goes out through the interface feeding them
+				const uint32_t rung = pending & ((1u << interface.gamepad_idx) | interface.extra_gamepads);
+				if (!rung)
+				{
+					continue;
+				}
+				if (now < interface.next_feedback_us ||
+					!interface.driver->send_feedback(*interface.gamepad, device_slot.address, i))
+				{
+					deferred |= rung;
+					continue;
+				}
+				interface.next_feedback_us = now + static_cast<uint64_t>(interface.driver->feedback_interval_ms()) * 1000;
+				tuh_task();
 			}
 		}
+		if (deferred)
+		{
+			feedback_pending_.fetch_or(deferred);
+		}
 	}
 
-	//Call on a timer
+	//Call on a timer, catches pad out changes that don't ring the doorbell
 	inline void send_feedback()
 	{
 		for (auto& device_slot : device_slots_)
@@ -219,24 +287,28 @@ public:
 		{
 			if (device_slot.address == address)
 			{
+				for (auto& interface : device_slot.interfaces)
+				{
+					if (interface.gamepad_idx != INVALID_IDX)
+					{
+						driver_pool_[interface.gamepad_idx].emplace<std::monostate>();
+					}
+				}
 				device_slot.reset();
 			}
 		}
-	}
-
-	static inline HostDriverType get_type(const HardwareID& ids)
-	{
-		for (const auto& map : HOST_TYPE_MAP)
+		if (address <= MAX_DEVICE_ADDRESS)
 		{
-			for (size_t i = 0; i < map.num_ids; i++)
+			for (auto& interface : interface_map_[address])
 			{
-				if (ids.pid == map.ids[i].pid && ids.vid == map.ids[i].vid)
-				{
-					return map.type;
-				}
+				interface = nullptr;
 			}
 		}
-		return HostDriverType::UNKNOWN;
+	}
+
+	static inline HostDriverType get_type(const HardwareID& ids)
+	{
+		return HardwareIDTable::find(HARDWARE_ID_TABLE, ids);
 	}
 
 	static inline HostDriverType get_type(const tuh_xinput::DevType xinput_type)
@@ -260,14 +332,8 @@ public:
 
 	inline uint8_t get_gamepad_idx(DriverClass driver_class, uint8_t address, uint8_t instance)
 	{
-		for (auto& device_slot : device_slots_)
-		{
-			if (device_slot.address == address && instance < MAX_INTERFACES)
-			{
-				return device_slot.interfaces[instance].gamepad_idx;
-			}
-		}
-		return INVALID_IDX;
+		const Interface* interface = find_interface(address, instance);
+		return interface ? interface->gamepad_idx : INVALID_IDX;
 	}
 
 	inline bool any_mounted() 
@@ -284,12 +350,16 @@ public:
 
 private:
 	static constexpr uint8_t INVALID_IDX = 0xFF;
+	//TinyUSB hands out addresses 1 to CFG_TUH_DEVICE_MAX for devices, hubs take the ones after
+	static constexpr uint8_t MAX_DEVICE_ADDRESS = CFG_TUH_DEVICE_MAX + CFG_TUH_HUB;
 
 	struct Interface
 	{
-		std::unique_ptr<HostDriver> driver{nullptr};
+		HostDriver* driver{nullptr}; //Lives in driver_pool_[gamepad_idx]
 		Gamepad* gamepad{nullptr};
 		uint8_t gamepad_idx{INVALID_IDX};
+		uint32_t extra_gamepads{0}; //Bit per gamepad index fed by this interface besides gamepad_idx, no driver of their own
+		uint64_t next_feedback_us{0};
 	};
 	struct Device
 	{
@@ -301,9 +371,11 @@ private:
 			address = INVALID_IDX;
 			for (auto& interface : interfaces)
 			{
-				interface.driver.reset();
+				interface.driver = nullptr;
 				interface.gamepad_idx = INVALID_IDX;
 				interface.gamepad = nullptr;
+				interface.extra_gamepads = 0;
+				interface.next_feedback_us = 0;
 			}
 		}
 	};
@@ -311,6 +383,16 @@ private:
 	Device device_slots_[MAX_GAMEPADS];
 	Gamepad* gamepads_[MAX_GAMEPADS];
 
+	//Bit per gamepad index, set from either core by the pad out doorbell
+	std::atomic<uint32_t> feedback_pending_{0};
+	static_assert(MAX_GAMEPADS <= 32, "HostManager: feedback_pending_ holds one bit per gamepad");
+
+	//Each gamepad has at most one driver, it's constructed in place here so mounting/unmounting never touches the heap
+	DriverStorage driver_pool_[MAX_GAMEPADS];
+
+	//Points at the mounted Interface for each address/instance so reports don't have to search device_slots_
+	Interface* interface_map_[MAX_DEVICE_ADDRESS + 1][MAX_INTERFACES]{};
+
     HostManager() {}
 
 	inline uint8_t find_free_device_slot()
@@ -325,9 +407,25 @@ private:
 		return INVALID_IDX;
 	}
 
+	//Destroys the interface's driver and gives back its gamepads
+	inline void release_interface(uint8_t address, uint8_t instance, Interface& interface)
+	{
+		if (interface.gamepad_idx != INVALID_IDX)
+		{
+			driver_pool_[interface.gamepad_idx].emplace<std::monostate>();
+		}
+		interface.driver = nullptr;
+		interface.gamepad_idx = INVALID_IDX;
+		interface.gamepad = nullptr;
+		interface.extra_gamepads = 0;
+		interface.next_feedback_us = 0;
+		interface_map_[address][instance] = nullptr;
+	}
+
+	//Lowest gamepad index not held by a mounted interface, the driver pool entry for it is free too
 	inline uint8_t find_free_gamepad()
 	{
-		uint8_t count = 0;
+		uint32_t in_use = 0;
 
 		for (auto& device_slot : device_slots_)
 		{
@@ -335,20 +433,52 @@ private:
 			{
 				if (interface.gamepad_idx != INVALID_IDX)
 				{
-					++count;
+					in_use |= (1u << interface.gamepad_idx);
 				}
+				in_use |= interface.extra_gamepads;
 			}
 		}
-		return (count < MAX_GAMEPADS) ? count : INVALID_IDX;
+		for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+		{
+			if (!(in_use & (1u << i)))
+			{
+				return i;
+			}
+		}
+		return INVALID_IDX;
+	}
+
+	static void ring_feedback_doorbell(uint8_t gamepad_idx)
+	{
+		get_instance().feedback_pending_.fetch_or(1u << gamepad_idx);
 	}
 
+	template <typename DriverType>
+	inline HostDriver* emplace_driver(uint8_t gamepad_idx)
+	{
+		return &driver_pool_[gamepad_idx].emplace<DriverType>(gamepad_idx);
+	}
+
+	//Devices behind a hub can have any address, the slot is wherever setup_driver() put it
 	inline uint8_t get_device_slot(uint8_t address)
 	{
-		if (address > MAX_GAMEPADS)
+		for (uint8_t i = 0; i < MAX_GAMEPADS; ++i)
+		{
+			if (device_slots_[i].address == address)
+			{
+				return i;
+			}
+		}
+		return INVALID_IDX;
+	}
+
+	inline Interface* find_interface(uint8_t address, uint8_t instance)
+	{
+		if (address > MAX_DEVICE_ADDRESS || instance >= MAX_INTERFACES)
 		{
-			return INVALID_IDX;
+			return nullptr;
 		}
-		return address - 1;
+		return interface_map_[address][instance];
 	}
 
 	// inline DriverClass determine_driver_class(HostDriver::Type host_type)
@@ -390,7 +520,7 @@ private:
 			{
 				if (interface.gamepad_idx == gamepad_idx)
 				{
-					return interface.driver.get();
+					return interface.driver;
 				}
 			}
 		}
@@ -162,7 +162,8 @@ private:
 
         flash_range_erase(sector_offset, FLASH_SECTOR_SIZE);
 
-        Entry* entry_to_write = reinterpret_cast<Entry*>(sector_buffer.data() + entry_offset);
+        //Offset within the sector copy, entries past the first sector would land outside the buffer
+        Entry* entry_to_write = reinterpret_cast<Entry*>(sector_buffer.data() + (NVS_START_OFFSET + entry_offset - sector_offset));
 
         *entry_to_write = Entry();
         std::strncpy(entry_to_write->key, key.c_str(), key.size());
@@ -7,6 +7,7 @@
 
 #include "Board/ogxm_log.h"
 #include "Board/board_api.h"
+#include "USBDevice/poll_rate.h"
 #include "UserSettings/UserSettings.h"
 
 static constexpr uint32_t BUTTON_COMBO(const uint16_t& buttons, const uint8_t& dpad = 0) {
@@ -105,6 +106,11 @@ const std::string UserSettings::DATETIME_KEY()
     return std::string("datetime");
 }
 
+const std::string UserSettings::POLL_INTERVAL_KEY(DeviceDriverType driver)
+{
+    return std::string("poll_ms_") + std::to_string(static_cast<uint8_t>(driver));
+}
+
 DeviceDriverType UserSettings::DEFAULT_DRIVER()
 {
     return VALID_DRIVER_TYPES[0];
@@ -113,7 +119,8 @@ DeviceDriverType UserSettings::DEFAULT_DRIVER()
 //Checks if button combo has been held for 3 seconds, returns true if mode has been changed
 bool UserSettings::check_for_driver_change(Gamepad& gamepad)
 {
-    Gamepad::PadIn gp_in = gamepad.get_pad_in();
+    //Peek so the device driver doesn't miss the new_pad_in() flag
+    Gamepad::PadIn gp_in = gamepad.peek_pad_in();
     static uint32_t last_button_combo = BUTTON_COMBO(gp_in.buttons, gp_in.dpad);
     static uint8_t call_count = 0;
 
@@ -234,6 +241,37 @@ void UserSettings::store_driver_type(DeviceDriverType new_driver)
     board_api::reboot();
 }
 
+//Disconnects usb and resets pico, the new descriptor is only seen on enumeration. Call from core0
+bool UserSettings::store_poll_interval(DeviceDriverType driver, uint8_t interval_ms)
+{
+    if (!is_valid_driver(driver) || !poll_rate::is_allowed(driver, interval_ms))
+    {
+        return false;
+    }
+
+    board_api::usb::disconnect_all();
+
+    nvs_tool_.write(POLL_INTERVAL_KEY(driver), &interval_ms, sizeof(uint8_t));
+
+    board_api::reboot();
+
+    return true;
+}
+
+uint8_t UserSettings::get_poll_interval(DeviceDriverType driver)
+{
+    //Stays 0, the descriptor's own rate, if nothing was stored
+    uint8_t interval_ms = 0;
+    nvs_tool_.read(POLL_INTERVAL_KEY(driver), &interval_ms, sizeof(uint8_t));
+
+    if (!poll_rate::is_allowed(driver, interval_ms))
+    {
+        OGXM_LOG("UserSettings::get_poll_interval: Interval not allowed for driver\n");
+        return 0;
+    }
+    return interval_ms;
+}
+
 uint8_t UserSettings::get_active_profile_id(const uint8_t index)
 {
     if (index > MAX_GAMEPADS - 1)
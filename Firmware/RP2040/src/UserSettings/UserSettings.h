@@ -35,10 +35,13 @@ public:
     UserProfile get_profile_by_index(const uint8_t index);
     UserProfile get_profile_by_id(const uint8_t profile_id);
     uint8_t get_active_profile_id(const uint8_t index);
+    //IN endpoint bInterval in ms for a driver, 0 if it uses its descriptor's
+    uint8_t get_poll_interval(DeviceDriverType driver);
 
     void store_driver_type(DeviceDriverType new_driver_type);
     bool store_profile(uint8_t index, const UserProfile& profile);
     bool store_profile_and_driver_type(DeviceDriverType new_driver_type, uint8_t index, const UserProfile& profile);
+    bool store_poll_interval(DeviceDriverType driver, uint8_t interval_ms);
 
 private:
     UserSettings() = default;
@@ -59,6 +62,7 @@ private:
     const std::string ACTIVE_PROFILE_KEY(const uint8_t index);
     const std::string DRIVER_TYPE_KEY();
     const std::string DATETIME_KEY();
+    const std::string POLL_INTERVAL_KEY(DeviceDriverType driver);
 };
 
 #endif // _USER_SETTINGS_H_
\ No newline at end of file
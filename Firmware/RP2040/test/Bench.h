@@ -0,0 +1,59 @@
+#ifndef _OGXM_BENCH_H_
+#define _OGXM_BENCH_H_
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+
+//Google Benchmark style output without the dependency:
+//  name                       ns/op     iterations
+//Run a benchmark binary with --iterations N for stable numbers, ctest runs it with a small count
+//only to keep it building and running.
+
+namespace bench
+{
+    inline uint64_t iterations = 1000000;
+
+    inline void init(int argc, char** argv)
+    {
+        for (int i = 1; i + 1 < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--iterations") == 0)
+            {
+                iterations = std::strtoull(argv[i + 1], nullptr, 10);
+            }
+        }
+        std::printf("%-48s %12s %12s\n", "Benchmark", "ns/op", "Iterations");
+    }
+
+    //Keeps the compiler from dropping a result
+    template <typename T>
+    inline void do_not_optimize(const T& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    //fn(i) is called iterations times, i lets it vary its input
+    template <typename Fn>
+    inline double run(const char* name, Fn&& fn, uint64_t count = 0)
+    {
+        if (count == 0)
+        {
+            count = iterations;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            fn(i);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(count);
+        std::printf("%-48s %12.2f %12llu\n", name, ns, static_cast<unsigned long long>(count));
+        return ns;
+    }
+}
+
+#endif // _OGXM_BENCH_H_
@@ -0,0 +1,158 @@
+#include <cstdint>
+#include <array>
+
+#include "Test.h"
+#include "Gamepad/Gamepad.h"
+
+//map_buttons()/map_dpad() against the per button MAP_* lookups host drivers did before the tables,
+//every button and dpad mask for a set of profiles
+
+static constexpr uint16_t BUTTONS[] =
+{
+    Gamepad::BUTTON_A, Gamepad::BUTTON_B, Gamepad::BUTTON_X, Gamepad::BUTTON_Y,
+    Gamepad::BUTTON_L3, Gamepad::BUTTON_R3, Gamepad::BUTTON_BACK, Gamepad::BUTTON_START,
+    Gamepad::BUTTON_LB, Gamepad::BUTTON_RB, Gamepad::BUTTON_SYS, Gamepad::BUTTON_MISC
+};
+
+static uint16_t map_buttons_reference(const Gamepad& gamepad, uint16_t buttons)
+{
+    const uint16_t maps[] =
+    {
+        gamepad.MAP_BUTTON_A, gamepad.MAP_BUTTON_B, gamepad.MAP_BUTTON_X, gamepad.MAP_BUTTON_Y,
+        gamepad.MAP_BUTTON_L3, gamepad.MAP_BUTTON_R3, gamepad.MAP_BUTTON_BACK, gamepad.MAP_BUTTON_START,
+        gamepad.MAP_BUTTON_LB, gamepad.MAP_BUTTON_RB, gamepad.MAP_BUTTON_SYS, gamepad.MAP_BUTTON_MISC
+    };
+    uint16_t mapped = 0;
+    for (size_t i = 0; i < std::size(BUTTONS); ++i)
+    {
+        if (buttons & BUTTONS[i])
+        {
+            mapped |= maps[i];
+        }
+    }
+    return mapped;
+}
+
+//Host drivers set one of the 8 directions or none
+static uint8_t map_dpad_reference(const Gamepad& gamepad, uint8_t dpad)
+{
+    switch (dpad)
+    {
+        case Gamepad::DPAD_UP:         return gamepad.MAP_DPAD_UP;
+        case Gamepad::DPAD_DOWN:       return gamepad.MAP_DPAD_DOWN;
+        case Gamepad::DPAD_LEFT:       return gamepad.MAP_DPAD_LEFT;
+        case Gamepad::DPAD_RIGHT:      return gamepad.MAP_DPAD_RIGHT;
+        case Gamepad::DPAD_UP_LEFT:    return gamepad.MAP_DPAD_UP_LEFT;
+        case Gamepad::DPAD_UP_RIGHT:   return gamepad.MAP_DPAD_UP_RIGHT;
+        case Gamepad::DPAD_DOWN_LEFT:  return gamepad.MAP_DPAD_DOWN_LEFT;
+        case Gamepad::DPAD_DOWN_RIGHT: return gamepad.MAP_DPAD_DOWN_RIGHT;
+        default:                       return gamepad.MAP_DPAD_NONE;
+    }
+}
+
+static void check_profile(const UserProfile& profile)
+{
+    Gamepad gamepad;
+    gamepad.set_profile(profile);
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < (1u << std::size(BUTTONS)); ++i)
+    {
+        const uint16_t buttons = static_cast<uint16_t>(i);
+        mismatches += gamepad.map_buttons(buttons) != map_buttons_reference(gamepad, buttons);
+    }
+    CHECK_EQ(mismatches, 0u);
+
+    //Bits above MISC aren't buttons, they map to nothing
+    for (uint32_t i = (1u << std::size(BUTTONS)); i <= 0xFFFF; i += (1u << std::size(BUTTONS)))
+    {
+        CHECK_EQ(gamepad.map_buttons(static_cast<uint16_t>(i)), 0);
+    }
+
+    const uint8_t DIRECTIONS[] =
+    {
+        Gamepad::DPAD_NONE, Gamepad::DPAD_UP, Gamepad::DPAD_DOWN, Gamepad::DPAD_LEFT, Gamepad::DPAD_RIGHT,
+        Gamepad::DPAD_UP_LEFT, Gamepad::DPAD_UP_RIGHT, Gamepad::DPAD_DOWN_LEFT, Gamepad::DPAD_DOWN_RIGHT
+    };
+    for (const uint8_t dpad : DIRECTIONS)
+    {
+        CHECK_EQ(gamepad.map_dpad(dpad), map_dpad_reference(gamepad, dpad));
+    }
+}
+
+static void test_default_profile()
+{
+    Gamepad gamepad;
+    gamepad.set_profile(UserProfile());
+
+    for (uint32_t i = 0; i < (1u << std::size(BUTTONS)); ++i)
+    {
+        CHECK_EQ(gamepad.map_buttons(static_cast<uint16_t>(i)), static_cast<uint16_t>(i));
+    }
+    for (uint8_t dpad = 0; dpad < 16; ++dpad)
+    {
+        CHECK_EQ(gamepad.map_dpad(dpad), dpad);
+    }
+    check_profile(UserProfile());
+}
+
+static void test_remapped_profiles()
+{
+    //Face buttons rotated, shoulders swapped, dpad mirrored
+    UserProfile rotated;
+    rotated.button_a = Gamepad::BUTTON_B;
+    rotated.button_b = Gamepad::BUTTON_Y;
+    rotated.button_y = Gamepad::BUTTON_X;
+    rotated.button_x = Gamepad::BUTTON_A;
+    rotated.button_lb = Gamepad::BUTTON_RB;
+    rotated.button_rb = Gamepad::BUTTON_LB;
+    rotated.dpad_up = Gamepad::DPAD_DOWN;
+    rotated.dpad_down = Gamepad::DPAD_UP;
+    rotated.dpad_left = Gamepad::DPAD_RIGHT;
+    rotated.dpad_right = Gamepad::DPAD_LEFT;
+    check_profile(rotated);
+
+    //Several buttons on one, one button on several, and unmapped buttons
+    UserProfile merged;
+    merged.button_a = Gamepad::BUTTON_A | Gamepad::BUTTON_START;
+    merged.button_b = Gamepad::BUTTON_A;
+    merged.button_l3 = 0;
+    merged.button_sys = Gamepad::BUTTON_MISC;
+    merged.button_misc = Gamepad::BUTTON_SYS | Gamepad::BUTTON_BACK;
+    merged.dpad_left = Gamepad::DPAD_UP;
+    merged.dpad_right = 0;
+    check_profile(merged);
+
+    //Every button's mapping taken from a pseudo random 12 bit mask
+    uint32_t state = 0x2545F491;
+    for (int round = 0; round < 32; ++round)
+    {
+        UserProfile random;
+        uint16_t* const targets[] =
+        {
+            &random.button_a, &random.button_b, &random.button_x, &random.button_y,
+            &random.button_l3, &random.button_r3, &random.button_back, &random.button_start,
+            &random.button_lb, &random.button_rb, &random.button_sys, &random.button_misc
+        };
+        for (uint16_t* target : targets)
+        {
+            state = state * 1664525u + 1013904223u;
+            *target = static_cast<uint16_t>((state >> 16) & 0x0FFF);
+        }
+        uint8_t* const dpad_targets[] = { &random.dpad_up, &random.dpad_down, &random.dpad_left, &random.dpad_right };
+        for (uint8_t* target : dpad_targets)
+        {
+            state = state * 1664525u + 1013904223u;
+            *target = static_cast<uint8_t>((state >> 16) & 0x0F);
+        }
+        check_profile(random);
+    }
+}
+
+int main()
+{
+    test_default_profile();
+    test_remapped_profiles();
+
+    return TEST_RESULT();
+}
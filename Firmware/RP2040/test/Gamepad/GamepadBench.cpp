@@ -0,0 +1,180 @@
+#include <cstdint>
+#include <array>
+
+#include "Bench.h"
+#include "Gamepad/Gamepad.h"
+#include "Gamepad/GamepadTestAccess.h"
+
+//Inputs are walked through a table so the compiler can't fold the scaling into a constant
+
+static std::array<int16_t, 1024> make_int16_inputs()
+{
+    std::array<int16_t, 1024> inputs;
+    uint32_t state = 0x12345678;
+    for (auto& input : inputs)
+    {
+        state = state * 1664525u + 1013904223u;
+        input = static_cast<int16_t>(state >> 16);
+    }
+    return inputs;
+}
+
+static UserProfile make_tuned_profile()
+{
+    UserProfile profile;
+    //Same fields the WebApp writes, a deadzone, curve and anti deadzone so every stage of the pipeline runs
+    profile.joystick_settings_l.dz_inner = fix16_from_float(0.1f);
+    profile.joystick_settings_l.curve = fix16_from_float(1.5f);
+    profile.joystick_settings_l.anti_dz_circle = fix16_from_float(0.05f);
+    profile.joystick_settings_r = profile.joystick_settings_l;
+    profile.trigger_settings_l.dz_inner = fix16_from_float(0.1f);
+    profile.trigger_settings_l.curve = fix16_from_float(1.5f);
+    profile.trigger_settings_r = profile.trigger_settings_l;
+    return profile;
+}
+
+//Native button bytes laid out like the DInput host's report
+namespace native
+{
+    static constexpr uint8_t SQUARE   = 0x01;
+    static constexpr uint8_t CROSS    = 0x02;
+    static constexpr uint8_t CIRCLE   = 0x04;
+    static constexpr uint8_t TRIANGLE = 0x08;
+    static constexpr uint8_t L1       = 0x10;
+    static constexpr uint8_t R1       = 0x20;
+    static constexpr uint8_t SELECT   = 0x01;
+    static constexpr uint8_t START    = 0x02;
+    static constexpr uint8_t L3       = 0x04;
+    static constexpr uint8_t R3       = 0x08;
+    static constexpr uint8_t SYS      = 0x10;
+    static constexpr uint8_t TP       = 0x20;
+}
+
+//How the host drivers built the mask before the tables, a profile load per pressed button
+static uint16_t remap_per_button(const Gamepad& gamepad, uint8_t buttons0, uint8_t buttons1)
+{
+    uint16_t buttons = 0;
+    if (buttons0 & native::SQUARE)   buttons |= gamepad.MAP_BUTTON_X;
+    if (buttons0 & native::CROSS)    buttons |= gamepad.MAP_BUTTON_A;
+    if (buttons0 & native::CIRCLE)   buttons |= gamepad.MAP_BUTTON_B;
+    if (buttons0 & native::TRIANGLE) buttons |= gamepad.MAP_BUTTON_Y;
+    if (buttons0 & native::L1)       buttons |= gamepad.MAP_BUTTON_LB;
+    if (buttons0 & native::R1)       buttons |= gamepad.MAP_BUTTON_RB;
+    if (buttons1 & native::L3)       buttons |= gamepad.MAP_BUTTON_L3;
+    if (buttons1 & native::R3)       buttons |= gamepad.MAP_BUTTON_R3;
+    if (buttons1 & native::SELECT)   buttons |= gamepad.MAP_BUTTON_BACK;
+    if (buttons1 & native::START)    buttons |= gamepad.MAP_BUTTON_START;
+    if (buttons1 & native::SYS)      buttons |= gamepad.MAP_BUTTON_SYS;
+    if (buttons1 & native::TP)       buttons |= gamepad.MAP_BUTTON_MISC;
+    return buttons;
+}
+
+//How they build it now, default bits then one table remap
+static uint16_t remap_table(const Gamepad& gamepad, uint8_t buttons0, uint8_t buttons1)
+{
+    uint16_t buttons = 0;
+    if (buttons0 & native::SQUARE)   buttons |= Gamepad::BUTTON_X;
+    if (buttons0 & native::CROSS)    buttons |= Gamepad::BUTTON_A;
+    if (buttons0 & native::CIRCLE)   buttons |= Gamepad::BUTTON_B;
+    if (buttons0 & native::TRIANGLE) buttons |= Gamepad::BUTTON_Y;
+    if (buttons0 & native::L1)       buttons |= Gamepad::BUTTON_LB;
+    if (buttons0 & native::R1)       buttons |= Gamepad::BUTTON_RB;
+    if (buttons1 & native::L3)       buttons |= Gamepad::BUTTON_L3;
+    if (buttons1 & native::R3)       buttons |= Gamepad::BUTTON_R3;
+    if (buttons1 & native::SELECT)   buttons |= Gamepad::BUTTON_BACK;
+    if (buttons1 & native::START)    buttons |= Gamepad::BUTTON_START;
+    if (buttons1 & native::SYS)      buttons |= Gamepad::BUTTON_SYS;
+    if (buttons1 & native::TP)       buttons |= Gamepad::BUTTON_MISC;
+    return gamepad.map_buttons(buttons);
+}
+
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    const auto inputs = make_int16_inputs();
+    auto input = [&inputs](uint64_t i) { return inputs[i & (inputs.size() - 1)]; };
+
+    bench::run("Range::scale<uint8_t>(int16_t)", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(Range::scale<uint8_t>(input(i))); 
+    });
+    bench::run("Range::scale<int16_t>(uint16_t)", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(Range::scale<int16_t>(static_cast<uint16_t>(input(i)))); 
+    });
+    bench::run("Range::scale_from_bits<int16_t, 10>", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(Range::scale_from_bits<int16_t, 10>(static_cast<int16_t>(input(i) >> 6))); 
+    });
+    bench::run("Range::scale_from_bits<uint8_t, 10>", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(Range::scale_from_bits<uint8_t, 10>(static_cast<uint16_t>(input(i)) >> 6)); 
+    });
+
+    Gamepad gamepad;
+    gamepad.set_profile(UserProfile());
+
+    bench::run("scale_joystick_l default", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(gamepad.scale_joystick_l(input(i), input(i + 1))); 
+    });
+    bench::run("scale_joystick_r<10> default", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(gamepad.scale_joystick_r<10>(static_cast<int16_t>(input(i) >> 6), static_cast<int16_t>(input(i + 1) >> 6), true)); 
+    });
+    bench::run("scale_trigger_l default", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(gamepad.scale_trigger_l(static_cast<uint8_t>(input(i)))); 
+    });
+    bench::run("scale_trigger_r<10> default", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(gamepad.scale_trigger_r<10>(static_cast<uint16_t>(input(i)) >> 6)); 
+    });
+
+    gamepad.set_profile(make_tuned_profile());
+
+    bench::run("scale_joystick_l tuned", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(gamepad.scale_joystick_l(input(i), input(i + 1))); 
+    });
+    bench::run("scale_joystick_r tuned", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(gamepad.scale_joystick_r(input(i), input(i + 1), true)); 
+    });
+    //What scale_joystick_l did per report before the table
+    bench::run("apply_joystick_settings tuned", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(GamepadTestAccess::apply_joystick_settings(input(i), input(i + 1), GamepadTestAccess::joy_settings_l(gamepad), false)); 
+    });
+    bench::run("scale_trigger_l tuned", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(gamepad.scale_trigger_l(static_cast<uint8_t>(input(i)))); 
+    });
+    bench::run("scale_trigger_r tuned", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(gamepad.scale_trigger_r(static_cast<uint8_t>(input(i)))); 
+    });
+    bench::run("apply_trigger_settings tuned", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(GamepadTestAccess::apply_trigger_settings(gamepad, static_cast<uint8_t>(input(i)), GamepadTestAccess::trig_settings_l(gamepad))); 
+    });
+
+    UserProfile remapped;
+    remapped.button_a = Gamepad::BUTTON_B;
+    remapped.button_b = Gamepad::BUTTON_A;
+    remapped.button_lb = Gamepad::BUTTON_RB;
+    remapped.button_rb = Gamepad::BUTTON_LB;
+    gamepad.set_profile(remapped);
+
+    bench::run("remap buttons per button", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(remap_per_button(gamepad, static_cast<uint8_t>(input(i)), static_cast<uint8_t>(input(i) >> 8))); 
+    });
+    bench::run("remap buttons table", [&](uint64_t i) 
+    { 
+        bench::do_not_optimize(remap_table(gamepad, static_cast<uint8_t>(input(i)), static_cast<uint8_t>(input(i) >> 8))); 
+    });
+
+    return 0;
+}
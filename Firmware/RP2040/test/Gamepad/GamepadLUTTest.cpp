@@ -0,0 +1,321 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+#include "Test.h"
+#include "Gamepad/Gamepad.h"
+#include "Gamepad/GamepadTestAccess.h"
+
+//The lookup tables set_profile() builds against the functions they're sampled from.
+//Bounds are relative to the direct function's own values, so they hold for libfixmath and the floating point fallback alike.
+
+static constexpr int32_t STICK_STRIDE = 127;
+//1% of full scale
+static constexpr int32_t STICK_FAR = Range::MAX<int16_t> / 100;
+
+struct JoystickCase
+{
+    const char* name;
+    JoystickSettingsRaw raw;
+    //Percent of points allowed more than 1% of full scale off, those sit in cells a discontinuity runs through
+    double far_limit;
+};
+
+static JoystickSettingsRaw make_joystick_raw(float dz_inner, float curve, float anti_dz_circle, 
+                                             float anti_dz_square, float axis_restrict, float angle_restrict, bool uncap_radius)
+{
+    JoystickSettingsRaw raw;
+    raw.dz_inner = fix16_from_float(dz_inner);
+    raw.curve = fix16_from_float(curve);
+    raw.anti_dz_circle = fix16_from_float(anti_dz_circle);
+    raw.anti_dz_square = fix16_from_float(anti_dz_square);
+    //Gamepad multiplies these by 100 when the profile is loaded
+    raw.axis_restrict = fix16_from_float(axis_restrict / 100.0f);
+    raw.angle_restrict = fix16_from_float(angle_restrict / 100.0f);
+    raw.uncap_radius = uncap_radius;
+    return raw;
+}
+
+struct StickError
+{
+    uint64_t points{0};
+    uint64_t total{0};
+    int32_t max{0};
+    int32_t max_x{0};
+    int32_t max_y{0};
+    uint64_t far{0};
+};
+
+//Spread of the direct function over the corners of the table cell (x, y) falls in, 
+//bilinear interpolation can't leave it by more than rounding
+static std::pair<int32_t, int32_t> cell_spread(int16_t x, int16_t y, const JoystickSettings& set, bool invert_y)
+{
+    const int32_t sign_x = (x < 0) ? -1 : 1;
+    const int32_t sign_y = (y < 0) ? -1 : 1;
+    const int32_t ix = std::min(std::abs(static_cast<int32_t>(x)), static_cast<int32_t>(Range::MAX<int16_t>)) >> GamepadTestAccess::JOY_CELL_BITS;
+    const int32_t iy = std::min(std::abs(static_cast<int32_t>(y)), static_cast<int32_t>(Range::MAX<int16_t>)) >> GamepadTestAccess::JOY_CELL_BITS;
+
+    int32_t min_x = INT32_MAX, max_x = INT32_MIN;
+    int32_t min_y = INT32_MAX, max_y = INT32_MIN;
+    auto include = [&](int32_t cx, int32_t cy) 
+    {
+        auto [out_x, out_y] = GamepadTestAccess::apply_joystick_settings(static_cast<int16_t>(cx), static_cast<int16_t>(cy), set, invert_y);
+        min_x = std::min<int32_t>(min_x, out_x);
+        max_x = std::max<int32_t>(max_x, out_x);
+        min_y = std::min<int32_t>(min_y, out_y);
+        max_y = std::max<int32_t>(max_y, out_y);
+    };
+    for (int32_t cy = iy; cy <= iy + 1; ++cy)
+    {
+        for (int32_t cx = ix; cx <= ix + 1; ++cx)
+        {
+            include(sign_x * GamepadTestAccess::joy_sample_pos(cx, GamepadTestAccess::JOY_AXIS_MIN_X), 
+                    sign_y * GamepadTestAccess::joy_sample_pos(cy, GamepadTestAccess::JOY_AXIS_MIN_Y));
+        }
+    }
+    include(x, y);
+    return { max_x - min_x, max_y - min_y };
+}
+
+static void check_stick(const char* name, Gamepad& gamepad, bool left, bool invert_y, double far_limit)
+{
+    const JoystickSettings& set = left ? GamepadTestAccess::joy_settings_l(gamepad) : GamepadTestAccess::joy_settings_r(gamepad);
+    StickError error;
+    uint32_t outside = 0;
+    uint32_t sign_flips = 0;
+
+    for (int32_t y = Range::MIN<int16_t>; y <= Range::MAX<int16_t>; y += STICK_STRIDE)
+    {
+        for (int32_t x = Range::MIN<int16_t>; x <= Range::MAX<int16_t>; x += STICK_STRIDE)
+        {
+            const int16_t in_x = static_cast<int16_t>(x);
+            const int16_t in_y = static_cast<int16_t>(y);
+
+            auto [lut_x, lut_y] = left  ? gamepad.scale_joystick_l(in_x, in_y, invert_y) 
+                                        : gamepad.scale_joystick_r(in_x, in_y, invert_y);
+            auto [direct_x, direct_y] = GamepadTestAccess::apply_joystick_settings(in_x, in_y, set, invert_y);
+
+            const int32_t err_x = std::abs(lut_x - direct_x);
+            const int32_t err_y = std::abs(lut_y - direct_y);
+
+            ++error.points;
+            error.total += static_cast<uint64_t>(err_x + err_y);
+            if (std::max(err_x, err_y) > error.max)
+            {
+                error.max = std::max(err_x, err_y);
+                error.max_x = x;
+                error.max_y = y;
+            }
+
+            //Signs always match the direct output's
+            if (((lut_x != 0) && (direct_x != 0) && ((lut_x < 0) != (direct_x < 0))) ||
+                ((lut_y != 0) && (direct_y != 0) && ((lut_y < 0) != (direct_y < 0))))
+            {
+                ++sign_flips;
+            }
+            if (std::max(err_x, err_y) > STICK_FAR)
+            {
+                ++error.far;
+            }
+
+            if (err_x > 2 || err_y > 2)
+            {
+                auto [spread_x, spread_y] = cell_spread(in_x, in_y, set, invert_y);
+                if (err_x > spread_x + 2 || err_y > spread_y + 2)
+                {
+                    if (outside++ < 8)
+                    {
+                        std::printf("%s: (%d, %d) lut (%d, %d) direct (%d, %d) cell spread (%d, %d)\n", 
+                            name, x, y, lut_x, lut_y, direct_x, direct_y, spread_x, spread_y);
+                    }
+                }
+            }
+        }
+    }
+
+    const double mean = static_cast<double>(error.total) / static_cast<double>(2 * error.points);
+    const double far = 100.0 * static_cast<double>(error.far) / static_cast<double>(error.points);
+    std::printf("%-30s mean %5.2f, %5.2f%% over 1%%, max %4d at (%d, %d)\n", name, mean, far, error.max, error.max_x, error.max_y);
+
+    CHECK_EQ(sign_flips, 0u);
+    CHECK_EQ(outside, 0u);
+    //Well under 1% of full scale on average
+    CHECK(mean < 32.0);
+    CHECK(far < far_limit);
+}
+
+static void test_joystick_lut()
+{
+    const JoystickCase CASES[] =
+    {
+        { "deadzone",                   make_joystick_raw(0.10f, 1.0f, 0.00f, 0.00f, 0.0f, 0.0f, true), 1.0 },
+        { "deadzone curve",             make_joystick_raw(0.10f, 1.5f, 0.00f, 0.00f, 0.0f, 0.0f, true), 1.0 },
+        { "deadzone curve < 1",         make_joystick_raw(0.05f, 0.6f, 0.00f, 0.00f, 0.0f, 0.0f, true), 1.0 },
+        { "anti deadzone circle",       make_joystick_raw(0.10f, 1.5f, 0.05f, 0.00f, 0.0f, 0.0f, true), 1.0 },
+        { "anti deadzone square",       make_joystick_raw(0.08f, 1.0f, 0.00f, 0.10f, 0.0f, 0.0f, true), 1.0 },
+        { "axis restrict",              make_joystick_raw(0.00f, 1.0f, 0.00f, 0.00f, 0.1f, 0.0f, true), 1.0 },
+        { "angle restrict",             make_joystick_raw(0.05f, 1.0f, 0.00f, 0.00f, 0.0f, 10.0f, true), 5.0 }, //Snaps to the axes along two rays
+        { "capped radius",              make_joystick_raw(0.10f, 1.2f, 0.00f, 0.00f, 0.0f, 0.0f, false), 1.0 },
+    };
+
+    for (const auto& c : CASES)
+    {
+        UserProfile profile;
+        profile.joystick_settings_l = c.raw;
+        profile.joystick_settings_r = c.raw;
+        profile.joystick_settings_r.invert_x = true;
+
+        Gamepad gamepad;
+        gamepad.set_profile(profile);
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s L", c.name);
+        check_stick(name, gamepad, true, false, c.far_limit);
+        std::snprintf(name, sizeof(name), "%s R invert", c.name);
+        check_stick(name, gamepad, false, true, c.far_limit);
+    }
+}
+
+//Tables come from a static pool of JOYSTICK_LUT_POOL_SIZE, identical settings share one 
+//and a stick that finds the pool full uses the direct function
+static void test_joystick_lut_pool()
+{
+    static_assert(JOYSTICK_LUT_POOL_SIZE == 2, "Host tests build with MAX_GAMEPADS 1");
+
+    UserProfile shared;
+    shared.joystick_settings_l = make_joystick_raw(0.10f, 1.5f, 0.00f, 0.00f, 0.0f, 0.0f, true);
+    shared.joystick_settings_r = shared.joystick_settings_l;
+    //Inversion is applied before the lookup, it still shares the table
+    shared.joystick_settings_r.invert_x = true;
+
+    UserProfile other;
+    other.joystick_settings_l = make_joystick_raw(0.05f, 0.6f, 0.00f, 0.00f, 0.0f, 0.0f, true);
+    other.joystick_settings_r = make_joystick_raw(0.08f, 1.0f, 0.00f, 0.10f, 0.0f, 0.0f, true);
+
+    {
+        Gamepad gamepad_a;
+        Gamepad gamepad_b;
+        gamepad_a.set_profile(shared);
+        gamepad_b.set_profile(shared);
+
+        CHECK(GamepadTestAccess::joy_lut_l(gamepad_a) != nullptr);
+        CHECK(GamepadTestAccess::joy_lut_l(gamepad_a) == GamepadTestAccess::joy_lut_r(gamepad_a));
+        CHECK(GamepadTestAccess::joy_lut_l(gamepad_a) == GamepadTestAccess::joy_lut_l(gamepad_b));
+        check_stick("pool shared R invert", gamepad_a, false, false, 1.0);
+
+        //One table left for two new settings, the right stick falls back
+        Gamepad gamepad_c;
+        gamepad_c.set_profile(other);
+        CHECK(GamepadTestAccess::joy_lut_l(gamepad_c) != nullptr);
+        CHECK(GamepadTestAccess::joy_lut_l(gamepad_c) != GamepadTestAccess::joy_lut_l(gamepad_a));
+        CHECK(GamepadTestAccess::joy_lut_r(gamepad_c) == nullptr);
+
+        const JoystickSettings& set_r = GamepadTestAccess::joy_settings_r(gamepad_c);
+        uint32_t mismatches = 0;
+        for (int32_t i = Range::MIN<int16_t>; i <= Range::MAX<int16_t>; i += STICK_STRIDE)
+        {
+            const int16_t x = static_cast<int16_t>(i);
+            const int16_t y = static_cast<int16_t>(-i / 2);
+            mismatches += gamepad_c.scale_joystick_r(x, y, true) != GamepadTestAccess::apply_joystick_settings(x, y, set_r, true);
+        }
+        CHECK_EQ(mismatches, 0u);
+
+        //Reloading a profile hands its tables back first
+        gamepad_a.set_profile(UserProfile());
+        gamepad_b.set_profile(UserProfile());
+        CHECK(GamepadTestAccess::joy_lut_l(gamepad_a) == nullptr);
+        gamepad_c.set_profile(other);
+        CHECK(GamepadTestAccess::joy_lut_l(gamepad_c) != nullptr);
+        CHECK(GamepadTestAccess::joy_lut_r(gamepad_c) != nullptr);
+    }
+
+    //Destroyed gamepads release theirs
+    Gamepad gamepad;
+    gamepad.set_profile(other);
+    CHECK(GamepadTestAccess::joy_lut_l(gamepad) != nullptr);
+    CHECK(GamepadTestAccess::joy_lut_r(gamepad) != nullptr);
+}
+
+static TriggerSettingsRaw make_trigger_raw(float dz_inner, float dz_outer, float anti_dz_inner, float anti_dz_outer, float curve)
+{
+    TriggerSettingsRaw raw;
+    raw.dz_inner = fix16_from_float(dz_inner);
+    raw.dz_outer = fix16_from_float(dz_outer);
+    raw.anti_dz_inner = fix16_from_float(anti_dz_inner);
+    raw.anti_dz_outer = fix16_from_float(anti_dz_outer);
+    raw.curve = fix16_from_float(curve);
+    return raw;
+}
+
+//The trigger table is the direct function evaluated at every input, so it has to match it exactly,
+//through every input width the host drivers scale from
+static void test_trigger_lut()
+{
+    const TriggerSettingsRaw CASES[] =
+    {
+        make_trigger_raw(0.10f, 1.00f, 0.00f, 1.00f, 1.0f),
+        make_trigger_raw(0.10f, 1.00f, 0.00f, 1.00f, 1.5f),
+        make_trigger_raw(0.00f, 0.90f, 0.00f, 1.00f, 0.5f),
+        make_trigger_raw(0.05f, 1.00f, 0.20f, 1.00f, 1.0f),
+        make_trigger_raw(0.05f, 1.00f, 0.00f, 0.80f, 2.0f),
+        make_trigger_raw(0.20f, 0.80f, 0.10f, 0.90f, 0.8f),
+    };
+
+    for (const auto& raw : CASES)
+    {
+        UserProfile profile;
+        profile.trigger_settings_l = raw;
+        profile.trigger_settings_r = raw;
+        profile.trigger_settings_r.curve = fix16_from_float(1.2f);
+
+        Gamepad gamepad;
+        gamepad.set_profile(profile);
+        const TriggerSettings& set_l = GamepadTestAccess::trig_settings_l(gamepad);
+        const TriggerSettings& set_r = GamepadTestAccess::trig_settings_r(gamepad);
+
+        uint32_t mismatches = 0;
+        for (int32_t i = 0; i <= Range::MAX<uint8_t>; ++i)
+        {
+            const uint8_t value = static_cast<uint8_t>(i);
+            mismatches += gamepad.scale_trigger_l(value) != GamepadTestAccess::apply_trigger_settings(gamepad, value, set_l);
+            mismatches += gamepad.scale_trigger_r(value) != GamepadTestAccess::apply_trigger_settings(gamepad, value, set_r);
+        }
+        for (int32_t i = 0; i < (1 << 10); ++i)
+        {
+            const uint16_t value = static_cast<uint16_t>(i);
+            const uint8_t scaled = Range::scale_from_bits<uint8_t, 10>(value);
+            mismatches += gamepad.scale_trigger_l<10>(value) != GamepadTestAccess::apply_trigger_settings(gamepad, scaled, set_l);
+            mismatches += gamepad.scale_trigger_r<10>(value) != GamepadTestAccess::apply_trigger_settings(gamepad, scaled, set_r);
+        }
+        for (int32_t i = 0; i <= Range::MAX<uint16_t>; ++i)
+        {
+            const uint16_t value = static_cast<uint16_t>(i);
+            const uint8_t scaled = Range::scale<uint8_t>(value);
+            mismatches += gamepad.scale_trigger_l(value) != GamepadTestAccess::apply_trigger_settings(gamepad, scaled, set_l);
+            mismatches += gamepad.scale_trigger_r(value) != GamepadTestAccess::apply_trigger_settings(gamepad, scaled, set_r);
+        }
+        CHECK_EQ(mismatches, 0u);
+    }
+
+    //Settings left at the defaults pass the value straight through
+    Gamepad gamepad;
+    gamepad.set_profile(UserProfile());
+    uint32_t mismatches = 0;
+    for (int32_t i = 0; i <= Range::MAX<uint8_t>; ++i)
+    {
+        const uint8_t value = static_cast<uint8_t>(i);
+        mismatches += gamepad.scale_trigger_l(value) != value;
+        mismatches += gamepad.scale_trigger_r(value) != value;
+    }
+    CHECK_EQ(mismatches, 0u);
+}
+
+int main()
+{
+    test_joystick_lut();
+    test_joystick_lut_pool();
+    test_trigger_lut();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,183 @@
+#include <cstdint>
+#include <utility>
+
+#include "Test.h"
+#include "Gamepad/Gamepad.h"
+
+//Golden vectors for the integer scaling every host driver runs its sticks and triggers through.
+//Expected values are truncating integer division, the same on any compiler, so these are exact.
+
+template <typename From, typename To>
+struct Vector
+{
+    From in;
+    To out;
+};
+
+static void test_range_scale()
+{
+    static constexpr Vector<int16_t, uint8_t> INT16_TO_UINT8[] =
+    {
+        { -32768, 0 }, { -32767, 0 }, { -256, 126 }, { -129, 127 }, { -128, 127 }, { -1, 127 }, 
+        { 0, 127 }, { 1, 127 }, { 127, 127 }, { 128, 128 }, { 255, 128 }, { 256, 128 }, { 32767, 255 }
+    };
+    for (const auto& v : INT16_TO_UINT8)
+    {
+        CHECK_EQ(Range::scale<uint8_t>(v.in), v.out);
+    }
+
+    static constexpr Vector<uint8_t, int16_t> UINT8_TO_INT16[] =
+    {
+        { 0, -32768 }, { 1, -32511 }, { 127, -129 }, { 128, 128 }, { 129, 385 }, { 254, 32510 }, { 255, 32767 }
+    };
+    for (const auto& v : UINT8_TO_INT16)
+    {
+        CHECK_EQ(Range::scale<int16_t>(v.in), v.out);
+    }
+
+    static constexpr Vector<uint16_t, int16_t> UINT16_TO_INT16[] =
+    {
+        { 0, -32768 }, { 1, -32767 }, { 32767, -1 }, { 32768, 0 }, { 65534, 32766 }, { 65535, 32767 }
+    };
+    for (const auto& v : UINT16_TO_INT16)
+    {
+        CHECK_EQ(Range::scale<int16_t>(v.in), v.out);
+    }
+
+    static constexpr Vector<uint16_t, uint8_t> UINT16_TO_UINT8[] =
+    {
+        { 0, 0 }, { 255, 0 }, { 256, 0 }, { 257, 1 }, { 32768, 127 }, { 65279, 254 }, { 65280, 254 }, { 65535, 255 }
+    };
+    for (const auto& v : UINT16_TO_UINT8)
+    {
+        CHECK_EQ(Range::scale<uint8_t>(v.in), v.out);
+    }
+
+    static constexpr Vector<int16_t, uint16_t> INT16_TO_UINT16[] =
+    {
+        { -32768, 0 }, { 0, 32768 }, { 32767, 65535 }
+    };
+    for (const auto& v : INT16_TO_UINT16)
+    {
+        CHECK_EQ(Range::scale<uint16_t>(v.in), v.out);
+    }
+
+    //Full range round trip through the wider type is lossless
+    for (int32_t i = 0; i <= Range::MAX<uint8_t>; ++i)
+    {
+        const uint8_t value = static_cast<uint8_t>(i);
+        CHECK_EQ(Range::scale<uint8_t>(Range::scale<uint16_t>(value)), value);
+    }
+}
+
+static void test_range_scale_from_bits()
+{
+    static constexpr Vector<int16_t, int16_t> INT10_TO_INT16[] =
+    {
+        { -600, -32768 }, { -512, -32768 }, { -511, -32704 }, { -1, -33 }, { 0, 31 }, 
+        { 1, 95 }, { 255, 16367 }, { 510, 32702 }, { 511, 32767 }, { 600, 32767 }
+    };
+    for (const auto& v : INT10_TO_INT16)
+    {
+        CHECK_EQ((Range::scale_from_bits<int16_t, 10>(v.in)), v.out);
+    }
+
+    static constexpr Vector<uint16_t, uint8_t> UINT10_TO_UINT8[] =
+    {
+        { 0, 0 }, { 3, 0 }, { 4, 0 }, { 5, 1 }, { 511, 127 }, { 512, 127 }, 
+        { 1019, 254 }, { 1020, 254 }, { 1022, 254 }, { 1023, 255 }, { 2000, 255 }
+    };
+    for (const auto& v : UINT10_TO_UINT8)
+    {
+        CHECK_EQ((Range::scale_from_bits<uint8_t, 10>(v.in)), v.out);
+    }
+
+    static constexpr Vector<uint16_t, int16_t> UINT12_TO_INT16[] =
+    {
+        { 0, -32768 }, { 1, -32752 }, { 2047, -9 }, { 2048, 7 }, { 4095, 32767 }, { 5000, 32767 }
+    };
+    for (const auto& v : UINT12_TO_INT16)
+    {
+        CHECK_EQ((Range::scale_from_bits<int16_t, 12>(v.in)), v.out);
+    }
+
+    static constexpr Vector<int16_t, int16_t> INT8_TO_INT16[] =
+    {
+        { -128, -32768 }, { -1, -129 }, { 0, 128 }, { 127, 32767 }
+    };
+    for (const auto& v : INT8_TO_INT16)
+    {
+        CHECK_EQ((Range::scale_from_bits<int16_t, 8>(v.in)), v.out);
+    }
+}
+
+static void test_range_invert()
+{
+    CHECK_EQ(Range::invert<int16_t>(0), 0);
+    CHECK_EQ(Range::invert<int16_t>(1), -1);
+    CHECK_EQ(Range::invert<int16_t>(32767), -32767);
+    CHECK_EQ(Range::invert<int16_t>(-32768), 32767);
+    CHECK_EQ(Range::invert<uint8_t>(0), 255);
+    CHECK_EQ(Range::invert<uint8_t>(128), 127);
+    CHECK_EQ(Range::invert<uint8_t>(255), 0);
+}
+
+//With a default profile the sticks and triggers only go through Range, the settings tables are off
+static void test_gamepad_default_profile()
+{
+    Gamepad gamepad;
+    gamepad.set_profile(UserProfile());
+
+    static constexpr Vector<int16_t, int16_t> INT10_TO_INT16[] =
+    {
+        { -512, -32768 }, { -1, -33 }, { 0, 31 }, { 511, 32767 }
+    };
+    for (const auto& vx : INT10_TO_INT16)
+    {
+        for (const auto& vy : INT10_TO_INT16)
+        {
+            auto [lx, ly] = gamepad.scale_joystick_l<10>(vx.in, vy.in);
+            CHECK_EQ(lx, vx.out);
+            CHECK_EQ(ly, vy.out);
+
+            auto [rx, ry] = gamepad.scale_joystick_r<10>(vx.in, vy.in, true);
+            CHECK_EQ(rx, vx.out);
+            CHECK_EQ(ry, Range::invert(vy.out));
+        }
+    }
+
+    //Unsigned axes, centered the same way as the DInput/Switch hosts read them
+    auto [x, y] = gamepad.scale_joystick_l(static_cast<uint8_t>(0), static_cast<uint8_t>(255));
+    CHECK_EQ(x, -32768);
+    CHECK_EQ(y, 32767);
+
+    auto [x16, y16] = gamepad.scale_joystick_r(static_cast<int16_t>(-32768), static_cast<int16_t>(1234), true);
+    CHECK_EQ(x16, -32768);
+    CHECK_EQ(y16, -1234);
+
+    static constexpr Vector<uint16_t, uint8_t> UINT10_TO_UINT8[] =
+    {
+        { 0, 0 }, { 5, 1 }, { 512, 127 }, { 1023, 255 }
+    };
+    for (const auto& v : UINT10_TO_UINT8)
+    {
+        CHECK_EQ(gamepad.scale_trigger_l<10>(v.in), v.out);
+        CHECK_EQ(gamepad.scale_trigger_r<10>(v.in), v.out);
+    }
+    for (int32_t i = 0; i <= Range::MAX<uint8_t>; ++i)
+    {
+        CHECK_EQ(gamepad.scale_trigger_l(static_cast<uint8_t>(i)), i);
+        CHECK_EQ(gamepad.scale_trigger_r(static_cast<uint8_t>(i)), i);
+    }
+    CHECK_EQ(gamepad.scale_trigger_l(static_cast<int16_t>(0)), 127);
+    CHECK_EQ(gamepad.scale_trigger_r(static_cast<uint16_t>(65535)), 255);
+}
+
+int main()
+{
+    test_range_scale();
+    test_range_scale_from_bits();
+    test_range_invert();
+    test_gamepad_default_profile();
+    return TEST_RESULT();
+}
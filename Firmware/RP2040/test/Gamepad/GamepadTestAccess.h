@@ -0,0 +1,43 @@
+#ifndef _OGXM_GAMEPAD_TEST_ACCESS_H_
+#define _OGXM_GAMEPAD_TEST_ACCESS_H_
+
+#include <cstdint>
+#include <utility>
+
+#include "Gamepad/Gamepad.h"
+
+//Gamepad's private response functions and the settings set_profile() left them, friend of Gamepad under OGXM_HOST_TEST
+struct GamepadTestAccess
+{
+    static constexpr uint8_t JOY_CELL_BITS = Gamepad::JoystickLUT::CELL_BITS;
+    static constexpr int32_t JOY_AXIS_MIN_X = Gamepad::JoystickLUT::AXIS_MIN_X;
+    static constexpr int32_t JOY_AXIS_MIN_Y = Gamepad::JoystickLUT::AXIS_MIN_Y;
+
+    static const JoystickSettings& joy_settings_l(const Gamepad& gamepad) { return gamepad.joy_settings_l_; }
+    static const JoystickSettings& joy_settings_r(const Gamepad& gamepad) { return gamepad.joy_settings_r_; }
+
+    //Table each stick got from the pool, nullptr if it fell back to the direct function
+    static const void* joy_lut_l(const Gamepad& gamepad) { return gamepad.joy_lut_l_; }
+    static const void* joy_lut_r(const Gamepad& gamepad) { return gamepad.joy_lut_r_; }
+
+    static const TriggerSettings& trig_settings_l(const Gamepad& gamepad) { return gamepad.trig_settings_l_; }
+    static const TriggerSettings& trig_settings_r(const Gamepad& gamepad) { return gamepad.trig_settings_r_; }
+
+    static uint8_t apply_trigger_settings(const Gamepad& gamepad, uint8_t value, const TriggerSettings& set)
+    {
+        return gamepad.apply_trigger_settings(value, set);
+    }
+
+    static std::pair<int16_t, int16_t> apply_joystick_settings(int16_t x, int16_t y, const JoystickSettings& set, bool invert_y)
+    {
+        return Gamepad::apply_joystick_settings(x, y, set, invert_y);
+    }
+
+    //Position of the table sample at idx, the first one sits just off the axis
+    static int32_t joy_sample_pos(int32_t idx, int32_t axis_min)
+    {
+        return Gamepad::JoystickLUT::sample_pos(idx, axis_min);
+    }
+};
+
+#endif // _OGXM_GAMEPAD_TEST_ACCESS_H_
@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <mutex>
+
+#include "Bench.h"
+#include "Gamepad/Gamepad.h"
+#include "Gamepad/SeqLock.h"
+
+//Uncontended cost of one PadIn handoff, SeqLock against the mutex protected copy it replaced
+//(pico mutexes are std::recursive_mutex in the host stubs)
+
+struct MutexPadIn
+{
+    std::recursive_mutex mutex;
+    Gamepad::PadIn pad_in;
+
+    void store(const Gamepad::PadIn& value)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        pad_in = value;
+    }
+    Gamepad::PadIn load()
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex);
+        return pad_in;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    static SeqLock<Gamepad::PadIn> seqlock;
+    static MutexPadIn mutex;
+    static Gamepad gamepad;
+    Gamepad::PadIn pad_in;
+
+    bench::run("mutex store + load", [&](uint64_t i) 
+    {
+        pad_in.joystick_lx = static_cast<int16_t>(i);
+        mutex.store(pad_in);
+        bench::do_not_optimize(mutex.load());
+    });
+    bench::run("SeqLock store + load", [&](uint64_t i) 
+    {
+        pad_in.joystick_lx = static_cast<int16_t>(i);
+        seqlock.store(pad_in);
+        bench::do_not_optimize(seqlock.load());
+    });
+    bench::run("Gamepad set_pad_in + get_pad_in", [&](uint64_t i) 
+    {
+        pad_in.joystick_lx = static_cast<int16_t>(i);
+        gamepad.set_pad_in(pad_in);
+        bench::do_not_optimize(gamepad.get_pad_in());
+    });
+    bench::run("Gamepad set_pad_in unchanged", [&](uint64_t) 
+    {
+        gamepad.set_pad_in(pad_in);
+    });
+
+    return 0;
+}
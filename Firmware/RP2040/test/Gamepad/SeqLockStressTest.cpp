@@ -0,0 +1,198 @@
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+#include "Gamepad/Gamepad.h"
+#include "Gamepad/SeqLock.h"
+
+//Writers and readers on their own std::threads, the host stub's spinlocks are real test-and-set locks.
+//Every value is built from one (writer, count) pair, a torn copy shows up as bytes that don't match it.
+
+static constexpr uint32_t WRITERS = 2;
+static constexpr uint32_t READERS = 2;
+static constexpr uint32_t STORES_PER_WRITER = 200000;
+
+struct Payload
+{
+    uint32_t writer;
+    uint32_t count;
+    //Large so a preempted copy is likely even on a single CPU runner
+    std::array<uint8_t, 2048> fill;
+};
+
+static uint8_t fill_byte(uint32_t writer, uint32_t count, size_t i)
+{
+    return static_cast<uint8_t>((count * 31u) ^ (writer * 97u) ^ static_cast<uint32_t>(i * 13u));
+}
+
+static Payload make_payload(uint32_t writer, uint32_t count)
+{
+    Payload payload;
+    payload.writer = writer;
+    payload.count = count;
+    for (size_t i = 0; i < payload.fill.size(); ++i)
+    {
+        payload.fill[i] = fill_byte(writer, count, i);
+    }
+    return payload;
+}
+
+static bool consistent(const Payload& payload)
+{
+    if (payload.writer >= WRITERS)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < payload.fill.size(); ++i)
+    {
+        if (payload.fill[i] != fill_byte(payload.writer, payload.count, i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Several writers, readers check every copy is whole and no writer's count goes backwards
+static void test_seqlock()
+{
+    static SeqLock<Payload> shared;
+    shared.store(make_payload(0, 0));
+
+    std::atomic<uint32_t> writers_done{0};
+    std::atomic<uint32_t> torn{0};
+    std::atomic<uint32_t> went_back{0};
+    std::atomic<uint64_t> loads{0};
+
+    std::vector<std::thread> threads;
+    for (uint32_t w = 0; w < WRITERS; ++w)
+    {
+        threads.emplace_back([w, &writers_done] 
+        {
+            for (uint32_t count = 1; count <= STORES_PER_WRITER; ++count)
+            {
+                shared.store(make_payload(w, count));
+            }
+            writers_done.fetch_add(1);
+        });
+    }
+    for (uint32_t r = 0; r < READERS; ++r)
+    {
+        threads.emplace_back([&] 
+        {
+            std::array<uint32_t, WRITERS> last_count{};
+            uint64_t local_loads = 0;
+            while (writers_done.load() < WRITERS)
+            {
+                const Payload payload = shared.load();
+                ++local_loads;
+                if (!consistent(payload))
+                {
+                    torn.fetch_add(1);
+                    continue;
+                }
+                if (payload.count < last_count[payload.writer])
+                {
+                    went_back.fetch_add(1);
+                }
+                last_count[payload.writer] = payload.count;
+            }
+            loads.fetch_add(local_loads);
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK_EQ(torn.load(), 0u);
+    CHECK_EQ(went_back.load(), 0u);
+    CHECK(loads.load() > 0);
+
+    //Once the writers stop the reader sees the last store of one of them
+    const Payload last = shared.load();
+    CHECK(consistent(last));
+    CHECK_EQ(last.count, STORES_PER_WRITER);
+}
+
+//Host core publishing through Gamepad::set_pad_in() while the device core reads with get_pad_in()
+static void test_gamepad_pad_in()
+{
+    static Gamepad gamepad;
+    std::atomic<bool> done{false};
+    uint32_t torn = 0;
+    uint32_t went_back = 0;
+
+    //Clear the reset value's flag, it isn't built like the writer's
+    gamepad.get_pad_in();
+
+    std::thread writer([&] 
+    {
+        Gamepad::PadIn pad_in;
+        for (uint32_t count = 1; count <= STORES_PER_WRITER; ++count)
+        {
+            pad_in.joystick_lx = static_cast<int16_t>(count);
+            pad_in.joystick_ly = static_cast<int16_t>(count >> 16);
+            pad_in.joystick_rx = static_cast<int16_t>(~count);
+            pad_in.joystick_ry = static_cast<int16_t>(~count >> 16);
+            pad_in.buttons = static_cast<uint16_t>(count & 0x0FFF);
+            pad_in.trigger_l = static_cast<uint8_t>(count);
+            pad_in.trigger_r = static_cast<uint8_t>(~count);
+            gamepad.set_pad_in(pad_in);
+        }
+        done.store(true);
+    });
+
+    uint32_t last_count = 0;
+    while (!done.load())
+    {
+        if (!gamepad.new_pad_in())
+        {
+            continue;
+        }
+        const Gamepad::PadIn pad_in = gamepad.get_pad_in();
+        const uint32_t count = static_cast<uint16_t>(pad_in.joystick_lx) | (static_cast<uint32_t>(static_cast<uint16_t>(pad_in.joystick_ly)) << 16);
+
+        if (static_cast<uint16_t>(pad_in.joystick_rx) != static_cast<uint16_t>(~count) ||
+            static_cast<uint16_t>(pad_in.joystick_ry) != static_cast<uint16_t>(~count >> 16) ||
+            pad_in.buttons != (count & 0x0FFF) ||
+            pad_in.trigger_l != static_cast<uint8_t>(count) ||
+            pad_in.trigger_r != static_cast<uint8_t>(~count))
+        {
+            ++torn;
+            continue;
+        }
+        if (count < last_count)
+        {
+            ++went_back;
+        }
+        last_count = count;
+    }
+    writer.join();
+
+    CHECK_EQ(torn, 0u);
+    CHECK_EQ(went_back, 0u);
+
+    //Flag is still up for the last store if the reader missed it
+    if (last_count != STORES_PER_WRITER)
+    {
+        CHECK(gamepad.new_pad_in());
+    }
+    CHECK_EQ(gamepad.get_pad_in().joystick_lx, static_cast<int16_t>(STORES_PER_WRITER));
+
+    const Gamepad::PadInStats stats = gamepad.get_pad_in_stats();
+    CHECK_EQ(stats.published, STORES_PER_WRITER);
+    CHECK_EQ(stats.suppressed, 0u);
+}
+
+int main()
+{
+    test_seqlock();
+    test_gamepad_pad_in();
+
+    return TEST_RESULT();
+}
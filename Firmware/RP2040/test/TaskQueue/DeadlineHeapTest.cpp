@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <array>
+#include <optional>
+
+#include "Test.h"
+#include "TaskQueue/DeadlineHeap.h"
+
+//Random push/remove/update/for_each against a plain array of deadlines per slot.
+//Deadlines sit around 2^32 so ordering across the old 32 bit timer wrap is covered.
+
+static constexpr uint8_t CAPACITY = 16;
+static constexpr uint64_t WRAP = 1ull << 32;
+
+using Heap = DeadlineHeap<CAPACITY>;
+using Model = std::array<std::optional<uint64_t>, CAPACITY>;
+
+struct Rng
+{
+    uint32_t state;
+    uint32_t next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+};
+
+static std::optional<uint64_t> model_min(const Model& model)
+{
+    std::optional<uint64_t> min;
+    for (const auto& deadline : model)
+    {
+        if (deadline && (!min || *deadline < *min))
+        {
+            min = deadline;
+        }
+    }
+    return min;
+}
+
+static bool matches(const Heap& heap, const Model& model)
+{
+    uint8_t size = 0;
+    for (uint8_t slot = 0; slot < CAPACITY; ++slot)
+    {
+        if (heap.contains(slot) != model[slot].has_value())
+        {
+            return false;
+        }
+        size += model[slot].has_value();
+    }
+    if (heap.size() != size)
+    {
+        return false;
+    }
+    if (size == 0)
+    {
+        return heap.empty();
+    }
+    //Ties can put any of the earliest slots on top
+    return  heap.top_deadline() == *model_min(model) && 
+            model[heap.top_slot()] == heap.top_deadline();
+}
+
+static void test_random_ops()
+{
+    Heap heap;
+    Model model{};
+    Rng rng{ 0x1234ABCD };
+    uint32_t mismatches = 0;
+
+    for (uint32_t op = 0; op < 200000; ++op)
+    {
+        const uint8_t slot = static_cast<uint8_t>(rng.next() % CAPACITY);
+        //Few distinct values so ties are common
+        const uint64_t deadline = WRAP - 64 + (rng.next() % 128);
+
+        switch (rng.next() % 6)
+        {
+            case 0:
+            case 1:
+                if (!model[slot])
+                {
+                    heap.push(slot, deadline);
+                    model[slot] = deadline;
+                }
+                break;
+            case 2:
+                heap.remove(slot);
+                model[slot].reset();
+                break;
+            case 3:
+                if (model[slot])
+                {
+                    heap.update(slot, deadline);
+                    model[slot] = deadline;
+                }
+                break;
+            case 4:
+                //Run the earliest, repeating ones go back in further out
+                if (!heap.empty())
+                {
+                    const uint8_t top = heap.top_slot();
+                    if (rng.next() & 1)
+                    {
+                        heap.update(top, heap.top_deadline() + 100);
+                        model[top] = *model[top] + 100;
+                    }
+                    else
+                    {
+                        heap.remove(top);
+                        model[top].reset();
+                    }
+                }
+                break;
+            default:
+                //Bulk shift, what resume does after a suspend, skewed per slot to reorder them
+                heap.for_each([&model](uint8_t s, uint64_t& d) 
+                { 
+                    d += s * 7;
+                    model[s] = *model[s] + s * 7;
+                });
+                break;
+        }
+        mismatches += !matches(heap, model);
+    }
+    CHECK_EQ(mismatches, 0u);
+}
+
+static void test_full_and_drain()
+{
+    Heap heap;
+    Rng rng{ 42 };
+
+    for (uint8_t slot = 0; slot < CAPACITY; ++slot)
+    {
+        heap.push(slot, WRAP - 8 + (rng.next() % 16));
+    }
+    CHECK_EQ(heap.size(), CAPACITY);
+
+    //Removing a missing slot is a no-op
+    heap.remove(0);
+    heap.remove(0);
+    CHECK_EQ(heap.size(), CAPACITY - 1);
+
+    uint64_t last = 0;
+    uint32_t out_of_order = 0;
+    while (!heap.empty())
+    {
+        const uint64_t deadline = heap.top_deadline();
+        out_of_order += deadline < last;
+        last = deadline;
+        heap.remove(heap.top_slot());
+    }
+    CHECK_EQ(out_of_order, 0u);
+
+    //Far apart deadlines, one past 2^32 must come after one just before it
+    heap.push(3, WRAP + 5);
+    heap.push(7, WRAP - 5);
+    heap.push(1, 0xFFFFFFFFFFFFFFF0ull);
+    CHECK_EQ(heap.top_slot(), 7);
+    heap.remove(7);
+    CHECK_EQ(heap.top_slot(), 3);
+    heap.remove(3);
+    CHECK_EQ(heap.top_slot(), 1);
+}
+
+int main()
+{
+    test_random_ops();
+    test_full_and_drain();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,151 @@
+#include <cstdint>
+#include <array>
+#include <utility>
+
+#include "Test.h"
+#include "TaskQueue/InplaceFunction.h"
+
+//Ownership of the stored callable through construction, moves, reset and destruction.
+//Capture counts its live copies, every test ends with none left.
+
+struct Capture
+{
+    static inline int32_t live = 0;
+
+    int32_t* calls;
+    uint32_t tag;
+
+    Capture(int32_t* calls, uint32_t tag) : calls(calls), tag(tag) { ++live; }
+    Capture(const Capture& other) : calls(other.calls), tag(other.tag) { ++live; }
+    Capture(Capture&& other) noexcept : calls(other.calls), tag(other.tag) { ++live; }
+    ~Capture() { --live; }
+
+    void operator()() { *calls += static_cast<int32_t>(tag); }
+};
+
+using Function = InplaceFunction<24>;
+
+static void test_invoke_and_destroy()
+{
+    int32_t calls = 0;
+    {
+        Function function(Capture(&calls, 1));
+        CHECK(static_cast<bool>(function));
+        CHECK_EQ(Capture::live, 1);
+        function();
+        function();
+        CHECK_EQ(calls, 2);
+    }
+    CHECK_EQ(Capture::live, 0);
+
+    Function empty;
+    CHECK(!empty);
+    Function null_function(nullptr);
+    CHECK(!null_function);
+}
+
+static void test_move()
+{
+    int32_t calls = 0;
+    Function a(Capture(&calls, 1));
+
+    //Construct, the source is left empty and only one copy is alive
+    Function b(std::move(a));
+    CHECK(!a);
+    CHECK(static_cast<bool>(b));
+    CHECK_EQ(Capture::live, 1);
+    b();
+    CHECK_EQ(calls, 1);
+
+    //Assign over a live callable destroys it first
+    Function c(Capture(&calls, 10));
+    CHECK_EQ(Capture::live, 2);
+    c = std::move(b);
+    CHECK_EQ(Capture::live, 1);
+    CHECK(!b);
+    c();
+    CHECK_EQ(calls, 2);
+
+    //Self move keeps it
+    Function& self = c;
+    c = std::move(self);
+    CHECK(static_cast<bool>(c));
+    CHECK_EQ(Capture::live, 1);
+
+    //Empty into live
+    c = std::move(a);
+    CHECK(!c);
+    CHECK_EQ(Capture::live, 0);
+}
+
+static void test_reset()
+{
+    int32_t calls = 0;
+    Function function(Capture(&calls, 1));
+    function.reset();
+    CHECK(!function);
+    CHECK_EQ(Capture::live, 0);
+    function.reset();
+    CHECK_EQ(Capture::live, 0);
+
+    function = Function(Capture(&calls, 1));
+    CHECK_EQ(Capture::live, 1);
+    function = nullptr;
+    CHECK(!function);
+    CHECK_EQ(Capture::live, 0);
+}
+
+//What a ring of them does, many moves through slots that get reused
+static void test_slot_reuse()
+{
+    int32_t calls = 0;
+    std::array<Function, 4> slots;
+
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        Function& slot = slots[i % slots.size()];
+        if (slot)
+        {
+            Function taken = std::move(slot);
+            taken();
+        }
+        slot = Function(Capture(&calls, 1));
+        CHECK(Capture::live <= static_cast<int32_t>(slots.size()));
+    }
+    for (auto& slot : slots)
+    {
+        slot.reset();
+    }
+    CHECK_EQ(calls, 1000 - static_cast<int32_t>(slots.size()));
+    CHECK_EQ(Capture::live, 0);
+}
+
+//Captures up to the capacity are stored, the whole capture is kept
+static void test_capacity()
+{
+    struct Exact { uint64_t a, b, c; };
+    Exact exact{ 1, 2, 3 };
+    uint64_t sum = 0;
+
+    auto sum_exact = [exact, &sum]() { sum = exact.a + exact.b + exact.c; };
+    using ExactOnly = decltype([exact]() { (void)exact; });
+
+    static_assert(InplaceFunction<sizeof(Exact)>::fits<ExactOnly>, "capture the size of the capacity should fit");
+    static_assert(!InplaceFunction<sizeof(Exact) - 1>::fits<ExactOnly>, "capture over the capacity shouldn't fit");
+    static_assert(!Function::fits<decltype(sum_exact)> && InplaceFunction<32>::fits<decltype(sum_exact)>, "capture is 32 bytes");
+
+    InplaceFunction<32> function(sum_exact);
+    function();
+    CHECK_EQ(sum, 6u);
+}
+
+int main()
+{
+    test_invoke_and_destroy();
+    test_move();
+    test_reset();
+    test_slot_reuse();
+    test_capacity();
+
+    return TEST_RESULT();
+}
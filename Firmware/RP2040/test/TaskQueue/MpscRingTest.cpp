@@ -0,0 +1,184 @@
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+#include "TaskQueue/MpscRing.h"
+
+//Full/empty handling, sequence counter wrap, and several producer threads against one consumer
+
+struct MpscRingTestAccess
+{
+    //Empty ring with head and tail at pos, cells numbered the way they would be after pos pushes and pops
+    template <typename T, uint32_t Depth>
+    static void start_at(MpscRing<T, Depth>& ring, uint32_t pos)
+    {
+        for (uint32_t i = 0; i < Depth; ++i)
+        {
+            const uint32_t cell_pos = pos + i;
+            ring.cells_[cell_pos & (Depth - 1)].seq.store(cell_pos, std::memory_order_relaxed);
+        }
+        ring.tail_.store(pos, std::memory_order_relaxed);
+        ring.head_ = pos;
+    }
+};
+
+static constexpr uint32_t DEPTH = 8;
+
+//Full ring refuses and leaves the value with the caller, items come out in order
+static void check_fill_and_drain(MpscRing<std::unique_ptr<uint32_t>, DEPTH>& ring, uint32_t first)
+{
+    for (uint32_t i = 0; i < DEPTH; ++i)
+    {
+        CHECK(ring.push(std::make_unique<uint32_t>(first + i)));
+    }
+    CHECK_EQ(ring.size(), DEPTH);
+
+    auto rejected = std::make_unique<uint32_t>(0xDEAD);
+    CHECK(!ring.push(std::move(rejected)));
+    CHECK(rejected != nullptr);
+
+    std::unique_ptr<uint32_t> value;
+    for (uint32_t i = 0; i < DEPTH; ++i)
+    {
+        CHECK(ring.pop(value));
+        CHECK(value && *value == first + i);
+    }
+    CHECK(!ring.pop(value));
+    CHECK_EQ(ring.size(), 0u);
+}
+
+static void test_full_and_empty()
+{
+    MpscRing<std::unique_ptr<uint32_t>, DEPTH> ring;
+    std::unique_ptr<uint32_t> value;
+    CHECK(!ring.pop(value));
+
+    //Several laps so every cell is reused
+    for (uint32_t lap = 0; lap < 4; ++lap)
+    {
+        check_fill_and_drain(ring, lap * 100);
+    }
+
+    //Interleaved, never more than half full
+    uint32_t next_in = 0;
+    uint32_t next_out = 0;
+    uint32_t out_of_order = 0;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        CHECK(ring.push(std::make_unique<uint32_t>(next_in++)));
+        if (i & 1)
+        {
+            for (int j = 0; j < 2; ++j)
+            {
+                CHECK(ring.pop(value));
+                out_of_order += (*value != next_out++);
+            }
+        }
+    }
+    CHECK_EQ(out_of_order, 0u);
+}
+
+//Head, tail and the cell sequence numbers are 32 bit and wrap after 2^32 tasks
+static void test_counter_wrap()
+{
+    MpscRing<std::unique_ptr<uint32_t>, DEPTH> ring;
+    MpscRingTestAccess::start_at(ring, 0xFFFFFFFFu - DEPTH - 3);
+
+    //Fill and drain laps crossing the wrap part way
+    for (uint32_t lap = 0; lap < 4; ++lap)
+    {
+        check_fill_and_drain(ring, lap * 100);
+    }
+
+    //Same with the ring partly full as the counters wrap
+    MpscRingTestAccess::start_at(ring, 0xFFFFFFFFu - 2);
+    std::unique_ptr<uint32_t> value;
+    uint32_t next_out = 0;
+    uint32_t out_of_order = 0;
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        CHECK(ring.push(std::make_unique<uint32_t>(i)));
+        if (ring.size() == DEPTH / 2)
+        {
+            CHECK(ring.pop(value));
+            out_of_order += (*value != next_out++);
+        }
+    }
+    while (ring.pop(value))
+    {
+        out_of_order += (*value != next_out++);
+    }
+    CHECK_EQ(out_of_order, 0u);
+    CHECK_EQ(next_out, 64u);
+}
+
+//Producers retry while full, the consumer checks each producer's items arrive once and in order
+static void test_threads()
+{
+    static constexpr uint32_t PRODUCERS = 3;
+    static constexpr uint32_t ITEMS = 200000;
+
+    static MpscRing<uint32_t, DEPTH> ring;
+    MpscRingTestAccess::start_at(ring, 0xFFFFFFFFu - 1000);
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([p] 
+        {
+            for (uint32_t i = 0; i < ITEMS; ++i)
+            {
+                uint32_t item = (p << 24) | i;
+                while (!ring.push(std::move(item)))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::array<uint32_t, PRODUCERS> next{};
+    uint32_t received = 0;
+    uint32_t out_of_order = 0;
+    uint32_t item = 0;
+    while (received < PRODUCERS * ITEMS)
+    {
+        if (!ring.pop(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const uint32_t p = item >> 24;
+        if (p >= PRODUCERS || (item & 0xFFFFFF) != next[p])
+        {
+            ++out_of_order;
+            continue;
+        }
+        ++next[p];
+        ++received;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    CHECK_EQ(out_of_order, 0u);
+    CHECK(!ring.pop(item));
+    for (uint32_t p = 0; p < PRODUCERS; ++p)
+    {
+        CHECK_EQ(next[p], ITEMS);
+    }
+}
+
+int main()
+{
+    test_full_and_empty();
+    test_counter_wrap();
+    test_threads();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,167 @@
+#include <cstdint>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <hardware/sync.h>
+
+#include "Bench.h"
+#include "TaskQueue/InplaceFunction.h"
+#include "TaskQueue/DeadlineHeap.h"
+#include "TaskQueue/MpscRing.h"
+
+//TaskQueue's building blocks against what they replaced.
+//Captures are the size of a typical queued lambda, a pointer and a few values.
+
+struct Payload
+{
+    uint64_t* sink;
+    uint32_t a;
+    uint32_t b;
+    uint64_t c;
+};
+
+static constexpr uint8_t DELAYED_TASKS = 16;
+
+//Delayed task table before the heap, the earliest is found by scanning every slot
+struct DelayedTask
+{
+    uint64_t target_time;
+    bool active;
+};
+
+//Task queue before the ring, a spinlocked array of std::function scanned for a free slot
+struct SlotQueue
+{
+    spin_lock_t* spinlock = spin_lock_instance(static_cast<uint>(spin_lock_claim_unused(true)));
+    std::array<std::function<void()>, 8> tasks;
+
+    bool queue_task(const std::function<void()>& function)
+    {
+        uint32_t irq_state = spin_lock_blocking(spinlock);
+        for (auto& task : tasks)
+        {
+            if (!task)
+            {
+                task = function;
+                spin_unlock(spinlock, irq_state);
+                return true;
+            }
+        }
+        spin_unlock(spinlock, irq_state);
+        return false;
+    }
+
+    void process_tasks()
+    {
+        uint32_t irq_state = spin_lock_blocking(spinlock);
+        for (auto& task : tasks)
+        {
+            if (!task)
+            {
+                break;
+            }
+            auto function = task;
+            task = nullptr;
+            spin_unlock(spinlock, irq_state);
+
+            function();
+
+            irq_state = spin_lock_blocking(spinlock);
+        }
+        spin_unlock(spinlock, irq_state);
+    }
+};
+
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    uint64_t sink = 0;
+
+    //Create, hand off to the queue, move out to run, same as queue_task then process_tasks
+    bench::run("std::function create + move + call", [&](uint64_t i) 
+    {
+        const Payload payload{ &sink, static_cast<uint32_t>(i), 2, 3 };
+        std::function<void()> queued = [payload]() { *payload.sink += payload.a + payload.b + payload.c; };
+        std::function<void()> taken = std::move(queued);
+        taken();
+    });
+    bench::run("InplaceFunction<24> create + move + call", [&](uint64_t i) 
+    {
+        const Payload payload{ &sink, static_cast<uint32_t>(i), 2, 3 };
+        InplaceFunction<24> queued = [payload]() { *payload.sink += payload.a + payload.b + payload.c; };
+        InplaceFunction<24> taken = std::move(queued);
+        taken();
+    });
+    bench::do_not_optimize(sink);
+
+    //One task queued and run per iteration, then a burst of 4 before the consumer gets to them
+    SlotQueue slot_queue;
+    MpscRing<InplaceFunction<24>, 16> ring;
+    InplaceFunction<24> task;
+
+    bench::run("queue_task + process slot array", [&](uint64_t i) 
+    {
+        const Payload payload{ &sink, static_cast<uint32_t>(i), 2, 3 };
+        slot_queue.queue_task([payload]() { *payload.sink += payload.a + payload.b + payload.c; });
+        slot_queue.process_tasks();
+    });
+    bench::run("queue_task + process MpscRing", [&](uint64_t i) 
+    {
+        const Payload payload{ &sink, static_cast<uint32_t>(i), 2, 3 };
+        ring.push([payload]() { *payload.sink += payload.a + payload.b + payload.c; });
+        while (ring.pop(task))
+        {
+            task();
+        }
+    });
+    bench::run("4x queue_task + process slot array", [&](uint64_t i) 
+    {
+        for (uint32_t n = 0; n < 4; ++n)
+        {
+            const Payload payload{ &sink, static_cast<uint32_t>(i), n, 3 };
+            slot_queue.queue_task([payload]() { *payload.sink += payload.a + payload.b + payload.c; });
+        }
+        slot_queue.process_tasks();
+    });
+    bench::run("4x queue_task + process MpscRing", [&](uint64_t i) 
+    {
+        for (uint32_t n = 0; n < 4; ++n)
+        {
+            const Payload payload{ &sink, static_cast<uint32_t>(i), n, 3 };
+            ring.push([payload]() { *payload.sink += payload.a + payload.b + payload.c; });
+        }
+        while (ring.pop(task))
+        {
+            task();
+        }
+    });
+    bench::do_not_optimize(sink);
+
+    //A full table of repeating tasks, each run finds the earliest and moves it one interval out
+    std::array<DelayedTask, DELAYED_TASKS> table;
+    DeadlineHeap<DELAYED_TASKS> heap;
+    for (uint8_t slot = 0; slot < DELAYED_TASKS; ++slot)
+    {
+        table[slot] = { 1000u * (slot + 1), true };
+        heap.push(slot, 1000u * (slot + 1));
+    }
+
+    bench::run("delayed tasks linear scan, 16", [&](uint64_t) 
+    {
+        auto it = std::min_element(table.begin(), table.end(), [](const DelayedTask& a, const DelayedTask& b) 
+        {
+            return a.active && (!b.active || a.target_time < b.target_time);
+        });
+        it->target_time += 1000u * ((it - table.begin()) + 1);
+        bench::do_not_optimize(it->target_time);
+    });
+    bench::run("delayed tasks DeadlineHeap, 16", [&](uint64_t) 
+    {
+        const uint8_t slot = heap.top_slot();
+        heap.update(slot, heap.top_deadline() + 1000u * (slot + 1));
+        bench::do_not_optimize(heap.top_deadline());
+    });
+
+    return 0;
+}
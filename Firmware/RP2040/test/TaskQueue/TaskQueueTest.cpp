@@ -0,0 +1,282 @@
+#include <cstdint>
+#include <array>
+
+#include "Test.h"
+#include "TaskQueue/TaskQueue.h"
+
+//TaskQueue on the simulated clock in TaskQueuePlatform.h, alarm IRQs run from inside fake::advance_to().
+//Both cores' queues are process wide singletons, every test leaves them empty with nothing scheduled.
+
+namespace fake = task_queue_platform::fake;
+
+//Advances in chunk_us pieces and runs process_tasks() after each, so a task runs at most chunk_us after it's due
+static void run_until(uint64_t time_us, uint64_t chunk_us = 100, uint32_t step_us = 1)
+{
+    while (fake::now_us < time_us)
+    {
+        fake::advance_to(std::min(fake::now_us + chunk_us, time_us), step_us);
+        TaskQueue::Core0::process_tasks();
+        TaskQueue::Core1::process_tasks();
+    }
+}
+
+struct Runs
+{
+    uint32_t count{0};
+    uint64_t first_us{0};
+    uint64_t last_us{0};
+
+    void record()
+    {
+        if (count++ == 0)
+        {
+            first_us = fake::now_us;
+        }
+        last_us = fake::now_us;
+    }
+};
+
+static void test_immediate_and_overflow()
+{
+    std::array<uint32_t, TASK_QUEUE_DEPTH + 3> order{};
+    uint32_t ran = 0;
+    const uint32_t dropped_before = TaskQueue::Core0::dropped_tasks();
+
+    uint32_t accepted = 0;
+    for (uint32_t i = 0; i < order.size(); ++i)
+    {
+        accepted += TaskQueue::Core0::queue_task([&order, &ran, i]() { order[ran++] = i; });
+    }
+    CHECK_EQ(accepted, static_cast<uint32_t>(TASK_QUEUE_DEPTH));
+    CHECK_EQ(TaskQueue::Core0::dropped_tasks() - dropped_before, 3u);
+
+    TaskQueue::Core0::process_tasks();
+    CHECK_EQ(ran, static_cast<uint32_t>(TASK_QUEUE_DEPTH));
+    for (uint32_t i = 0; i < TASK_QUEUE_DEPTH; ++i)
+    {
+        CHECK_EQ(order[i], i);
+    }
+
+#if defined(CONFIG_OGXM_TASK_STATS)
+    const TaskStats stats = TaskQueue::Core0::get_stats();
+    CHECK_EQ(stats.queue_high_water, static_cast<uint32_t>(TASK_QUEUE_DEPTH));
+    CHECK_EQ(stats.rejected_tasks, TaskQueue::Core0::dropped_tasks());
+#endif
+
+    //A task that keeps queueing itself can't hold process_tasks() for more than a ring's worth
+    static uint32_t requeued = 0;
+    struct Requeue
+    {
+        static void queue()
+        {
+            TaskQueue::Core0::queue_task([]() 
+            { 
+                if (++requeued < 3 * TASK_QUEUE_DEPTH)
+                {
+                    queue();
+                }
+            });
+        }
+    };
+    Requeue::queue();
+    TaskQueue::Core0::process_tasks();
+    CHECK_EQ(requeued, static_cast<uint32_t>(TASK_QUEUE_DEPTH));
+    TaskQueue::Core0::process_tasks();
+    CHECK_EQ(requeued, 2u * TASK_QUEUE_DEPTH);
+    TaskQueue::Core0::process_tasks();
+    TaskQueue::Core0::process_tasks();
+    CHECK_EQ(requeued, 3u * TASK_QUEUE_DEPTH);
+
+    //Room again once drained, and the other core's queue is separate
+    CHECK(TaskQueue::Core1::queue_task([&ran]() { ++ran; }));
+    TaskQueue::Core0::process_tasks();
+    CHECK_EQ(ran, static_cast<uint32_t>(TASK_QUEUE_DEPTH));
+    TaskQueue::Core1::process_tasks();
+    CHECK_EQ(ran, static_cast<uint32_t>(TASK_QUEUE_DEPTH) + 1);
+}
+
+static void test_one_shot_and_repeating()
+{
+    Runs one_shot;
+    Runs repeating;
+    const uint64_t start = fake::now_us;
+
+    const uint32_t one_shot_id = TaskQueue::Core0::get_new_task_id();
+    const uint32_t repeating_id = TaskQueue::Core0::get_new_task_id();
+    CHECK(TaskQueue::Core0::queue_delayed_task(one_shot_id, 10, false, [&one_shot]() { one_shot.record(); }));
+    CHECK(TaskQueue::Core0::queue_delayed_task(repeating_id, 5, true, [&repeating]() { repeating.record(); }));
+    //Same id twice is refused
+    CHECK(!TaskQueue::Core0::queue_delayed_task(repeating_id, 5, true, []() {}));
+
+    run_until(start + 9999, 1);
+    CHECK_EQ(one_shot.count, 0u);
+    run_until(start + 10000, 1);
+    CHECK_EQ(one_shot.count, 1u);
+    CHECK_EQ(one_shot.first_us, start + 10000);
+
+    run_until(start + 50000, 1);
+    CHECK_EQ(one_shot.count, 1u);
+    CHECK_EQ(repeating.count, 10u);
+    CHECK_EQ(repeating.first_us, start + 5000);
+    CHECK_EQ(repeating.last_us, start + 50000);
+
+    //One shot's slot and id are free again
+    CHECK(TaskQueue::Core0::queue_delayed_task(one_shot_id, 1, false, [&one_shot]() { one_shot.record(); }));
+    run_until(start + 52000, 1);
+    CHECK_EQ(one_shot.count, 2u);
+
+    TaskQueue::Core0::cancel_delayed_task(repeating_id);
+    run_until(start + 100000);
+    CHECK_EQ(repeating.count, 10u);
+}
+
+//Alarm compare is the low 32 bits of the clock, deadlines either side of 2^32 us (71.6 minutes) still fire on time
+static void test_clock_wrap()
+{
+    fake::now_us = (1ull << 32) - 2500;
+    const uint64_t start = fake::now_us;
+
+    Runs one_shot;
+    Runs repeating;
+    Runs core1;
+    const uint32_t repeating_id = TaskQueue::Core0::get_new_task_id();
+    CHECK(TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), 5, false, [&one_shot]() { one_shot.record(); }));
+    CHECK(TaskQueue::Core0::queue_delayed_task(repeating_id, 1, true, [&repeating]() { repeating.record(); }));
+    CHECK(TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), 3, false, [&core1]() { core1.record(); }));
+
+    run_until(start + 20000, 1);
+    CHECK_EQ(one_shot.count, 1u);
+    CHECK_EQ(one_shot.first_us, start + 5000);
+    CHECK_EQ(core1.count, 1u);
+    CHECK_EQ(core1.first_us, start + 3000);
+    CHECK_EQ(repeating.count, 20u);
+    CHECK_EQ(repeating.first_us, start + 1000);
+    CHECK_EQ(repeating.last_us, start + 20000);
+
+    TaskQueue::Core0::cancel_delayed_task(repeating_id);
+}
+
+//Counts alarm IRQs by wrapping the handlers TaskQueue installed, alarm 0 is core0's and 1 is core1's
+struct IrqCounter
+{
+    static inline uint32_t count = 0;
+    static inline std::array<void (*)(), 2> handlers{};
+
+    static void install()
+    {
+        for (uint8_t i = 0; i < handlers.size(); ++i)
+        {
+            handlers[i] = fake::alarms[i].handler;
+        }
+        fake::alarms[0].handler = []() { ++count; handlers[0](); };
+        fake::alarms[1].handler = []() { ++count; handlers[1](); };
+    }
+    static void uninstall()
+    {
+        for (uint8_t i = 0; i < handlers.size(); ++i)
+        {
+            fake::alarms[i].handler = handlers[i];
+        }
+    }
+};
+
+//Longer than the alarm can be set in one go (2^31 us) and longer than the 32 bit compare wraps (2^32 us)
+static void test_long_one_shots()
+{
+    static constexpr uint64_t CHUNK_US = 100000;
+    const uint64_t start = fake::now_us;
+    IrqCounter::install();
+
+    Runs half_hour;
+    Runs hour;
+    Runs three_hours;
+    CHECK(TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), 40 * 60 * 1000, false, [&half_hour]() { half_hour.record(); }));
+    CHECK(TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), 75 * 60 * 1000, false, [&hour]() { hour.record(); }));
+    CHECK(TaskQueue::Core1::queue_delayed_task(TaskQueue::Core1::get_new_task_id(), 180 * 60 * 1000, false, [&three_hours]() { three_hours.record(); }));
+
+    run_until(start + 40ull * 60 * 1000000 - CHUNK_US, CHUNK_US, 1000);
+    CHECK_EQ(half_hour.count, 0u);
+    run_until(start + 40ull * 60 * 1000000, CHUNK_US, 1000);
+    CHECK_EQ(half_hour.count, 1u);
+
+    run_until(start + 75ull * 60 * 1000000 - CHUNK_US, CHUNK_US, 1000);
+    CHECK_EQ(hour.count, 0u);
+    run_until(start + 75ull * 60 * 1000000, CHUNK_US, 1000);
+    CHECK_EQ(hour.count, 1u);
+
+    run_until(start + 180ull * 60 * 1000000 - CHUNK_US, CHUNK_US, 1000);
+    CHECK_EQ(three_hours.count, 0u);
+    run_until(start + 180ull * 60 * 1000000, CHUNK_US, 1000);
+    CHECK_EQ(three_hours.count, 1u);
+    CHECK_EQ(half_hour.count, 1u);
+    CHECK_EQ(hour.count, 1u);
+
+    //Waits are armed in steps of at most 2^31 us, a few alarms each and no IRQ storm while waiting
+    CHECK(IrqCounter::count <= 16);
+    IrqCounter::uninstall();
+}
+
+static void test_delayed_overflow_and_cancel()
+{
+    const uint64_t start = fake::now_us;
+    std::array<uint32_t, 16> ids{};
+    uint32_t ran = 0;
+
+    for (auto& id : ids)
+    {
+        id = TaskQueue::Core0::get_new_task_id();
+        CHECK(TaskQueue::Core0::queue_delayed_task(id, 10, false, [&ran]() { ++ran; }));
+    }
+    CHECK(!TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), 10, false, [&ran]() { ++ran; }));
+
+    //Cancelling the earliest moves the alarm to the next one
+    TaskQueue::Core0::cancel_delayed_task(ids[0]);
+    TaskQueue::Core0::cancel_delayed_task(ids[5]);
+    run_until(start + 10000, 1);
+    CHECK_EQ(ran, 14u);
+
+    //A repeating task cancelling itself while it runs
+    static uint32_t self_cancel_id = 0;
+    static uint32_t self_cancel_runs = 0;
+    self_cancel_id = TaskQueue::Core0::get_new_task_id();
+    CHECK(TaskQueue::Core0::queue_delayed_task(self_cancel_id, 1, true, []() 
+    { 
+        if (++self_cancel_runs == 3)
+        {
+            TaskQueue::Core0::cancel_delayed_task(self_cancel_id);
+        }
+    }));
+    run_until(start + 20000, 1);
+    CHECK_EQ(self_cancel_runs, 3u);
+}
+
+static void test_suspend_resume()
+{
+    const uint64_t start = fake::now_us;
+    Runs runs;
+    CHECK(TaskQueue::Core0::queue_delayed_task(TaskQueue::Core0::get_new_task_id(), 10, false, [&runs]() { runs.record(); }));
+
+    run_until(start + 4000, 1);
+    TaskQueue::suspend_delayed_tasks();
+    run_until(start + 30000);
+    CHECK_EQ(runs.count, 0u);
+
+    //Picks up with the 6ms it had left
+    TaskQueue::resume_delayed_tasks();
+    run_until(start + 30000 + 5999, 1);
+    CHECK_EQ(runs.count, 0u);
+    run_until(start + 30000 + 6000, 1);
+    CHECK_EQ(runs.count, 1u);
+}
+
+int main()
+{
+    test_immediate_and_overflow();
+    test_one_shot_and_repeating();
+    test_clock_wrap();
+    test_long_one_shots();
+    test_delayed_overflow_and_cancel();
+    test_suspend_resume();
+
+    return TEST_RESULT();
+}
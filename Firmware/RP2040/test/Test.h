@@ -0,0 +1,52 @@
+#ifndef _OGXM_TEST_H_
+#define _OGXM_TEST_H_
+
+#include <cstdio>
+#include <cstdint>
+#include <cinttypes>
+
+//Minimal checks for the host tests, a failed check prints and keeps going,
+//main() returns TEST_RESULT() so ctest sees the failure.
+
+namespace test
+{
+    inline uint32_t checks = 0;
+    inline uint32_t failures = 0;
+
+    inline bool report(bool passed, const char* expr, const char* file, int line)
+    {
+        ++checks;
+        if (!passed)
+        {
+            ++failures;
+            std::printf("%s:%d: CHECK failed: %s\n", file, line, expr);
+        }
+        return passed;
+    }
+
+    template <typename A, typename B>
+    inline bool report_eq(const A& a, const B& b, const char* expr_a, const char* expr_b, const char* file, int line)
+    {
+        ++checks;
+        if (!(a == b))
+        {
+            ++failures;
+            std::printf("%s:%d: CHECK_EQ failed: %s == %s (%" PRId64 " vs %" PRId64 ")\n", 
+                file, line, expr_a, expr_b, static_cast<int64_t>(a), static_cast<int64_t>(b));
+            return false;
+        }
+        return true;
+    }
+
+    inline int result(const char* name)
+    {
+        std::printf("%s: %u checks, %u failed\n", name, checks, failures);
+        return (failures == 0) ? 0 : 1;
+    }
+}
+
+#define CHECK(x) test::report(static_cast<bool>(x), #x, __FILE__, __LINE__)
+#define CHECK_EQ(a, b) test::report_eq((a), (b), #a, #b, __FILE__, __LINE__)
+#define TEST_RESULT() test::result(__FILE__)
+
+#endif // _OGXM_TEST_H_
@@ -0,0 +1,93 @@
+#include <cstdint>
+#include <array>
+#include <vector>
+
+#include "Test.h"
+#include "USBDevice/poll_rate.h"
+
+//Whitelists and the configuration descriptor patch, the measurement needs the device stack and isn't built here
+
+static void test_whitelist()
+{
+    for (uint8_t interval = 0; interval < 255; ++interval)
+    {
+        const bool listed = (interval == 1 || interval == 2 || interval == 4 || interval == 8);
+        CHECK_EQ(poll_rate::is_allowed(DeviceDriverType::XINPUT, interval), interval == 0 || listed);
+        CHECK_EQ(poll_rate::is_allowed(DeviceDriverType::PSCLASSIC, interval), interval == 0 || listed || interval == 10);
+
+        //Drivers without a whitelist only take their descriptor's rate
+        CHECK_EQ(poll_rate::is_allowed(DeviceDriverType::XBOXOG_SB, interval), interval == 0);
+        CHECK_EQ(poll_rate::is_allowed(DeviceDriverType::WEBAPP, interval), interval == 0);
+    }
+
+    const poll_rate::Choices choices = poll_rate::get_choices(DeviceDriverType::PSCLASSIC);
+    CHECK_EQ(choices[4], 10u);
+    CHECK_EQ(choices[5], 0u);
+    CHECK(poll_rate::get_choices(DeviceDriverType::XBOXOG_XR) == poll_rate::Choices{});
+}
+
+//Configuration, interface, HID and three endpoints: interrupt IN, interrupt OUT and bulk IN
+static std::vector<uint8_t> make_configuration()
+{
+    std::vector<uint8_t> desc =
+    {
+        0x09, TUSB_DESC_CONFIGURATION, 0x00, 0x00, 0x01, 0x01, 0x00, 0x80, 0xFA,
+        0x09, TUSB_DESC_INTERFACE, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x00,
+        0x09, 0x21, 0x11, 0x01, 0x00, 0x01, 0x22, 0x40, 0x00,
+        0x07, TUSB_DESC_ENDPOINT, 0x81, TUSB_XFER_INTERRUPT, 0x40, 0x00, 0x04,
+        0x07, TUSB_DESC_ENDPOINT, 0x02, TUSB_XFER_INTERRUPT, 0x40, 0x00, 0x04,
+        0x07, TUSB_DESC_ENDPOINT, 0x83, TUSB_XFER_BULK, 0x40, 0x00, 0x00,
+    };
+    desc[2] = static_cast<uint8_t>(desc.size());
+    return desc;
+}
+
+static void test_patch_configuration()
+{
+    const std::vector<uint8_t> desc = make_configuration();
+
+    //0 leaves the driver's own descriptor in place
+    CHECK(poll_rate::patch_configuration(desc.data(), 0) == desc.data());
+    CHECK(poll_rate::patch_configuration(nullptr, 1) == nullptr);
+
+    const uint8_t* patched = poll_rate::patch_configuration(desc.data(), 1);
+    CHECK(patched != desc.data());
+
+    //Only the interrupt IN endpoint's bInterval changes
+    const size_t in_interval = 9 + 9 + 9 + 6;
+    for (size_t i = 0; i < desc.size(); ++i)
+    {
+        CHECK_EQ(patched[i], (i == in_interval) ? 1u : desc[i]);
+    }
+    CHECK_EQ(desc[in_interval], 4u);
+}
+
+static void test_malformed_configuration()
+{
+    //Too long to copy, handed back unpatched
+    std::vector<uint8_t> desc = make_configuration();
+    desc.resize(300);
+    desc[2] = static_cast<uint8_t>(desc.size() & 0xFF);
+    desc[3] = static_cast<uint8_t>(desc.size() >> 8);
+    CHECK(poll_rate::patch_configuration(desc.data(), 1) == desc.data());
+
+    //A zero length descriptor stops the walk, the endpoint after it is left alone
+    desc = make_configuration();
+    desc[18] = 0;
+    const uint8_t* patched = poll_rate::patch_configuration(desc.data(), 1);
+    CHECK_EQ(patched[9 + 9 + 9 + 6], 4u);
+
+    //An endpoint cut off by wTotalLength isn't written past it, the copy above left 4 there
+    desc = make_configuration();
+    desc[2] = 9 + 9 + 9 + 5;
+    patched = poll_rate::patch_configuration(desc.data(), 1);
+    CHECK_EQ(patched[9 + 9 + 9 + 6], 4u);
+}
+
+int main()
+{
+    test_whitelist();
+    test_patch_configuration();
+    test_malformed_configuration();
+    return TEST_RESULT();
+}
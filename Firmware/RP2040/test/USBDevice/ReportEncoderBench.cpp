@@ -0,0 +1,49 @@
+#include <cstdint>
+#include <array>
+
+#include "Bench.h"
+#include "USBDevice/ReportEncoderLayouts.h"
+
+using namespace encoder_layouts;
+
+//Random frames walked through a table so neither encoder sees a constant input
+
+static std::array<Gamepad::PadIn, 1024> make_frames()
+{
+    std::array<Gamepad::PadIn, 1024> frames;
+    uint32_t state = 0x12345678;
+    for (auto& frame : frames)
+    {
+        state = state * 1664525u + 1013904223u;
+        frame.buttons = static_cast<uint16_t>((state >> 8) & 0x0FFF);
+        frame.dpad = static_cast<uint8_t>((state >> 20) & 0x0F);
+        frame.trigger_l = (state & 0x10000000) ? 255 : 0;
+        frame.trigger_r = (state & 0x20000000) ? 255 : 0;
+    }
+    return frames;
+}
+
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    const auto frames = make_frames();
+    auto frame = [&frames](uint64_t i) -> const Gamepad::PadIn& { return frames[i & (frames.size() - 1)]; };
+
+    bench::run("Switch if/switch chains", [&](uint64_t i) 
+    {
+        bench::do_not_optimize(Switch::reference_buttons(frame(i)));
+        bench::do_not_optimize(Switch::reference_dpad(frame(i)));
+    });
+    bench::run("Switch ReportEncoder", [&](uint64_t i) 
+    {
+        bench::do_not_optimize(Switch::ENCODER.buttons(frame(i)));
+        bench::do_not_optimize(Switch::ENCODER.dpad(frame(i)));
+    });
+    bench::run("XInput if/switch chains", [&](uint64_t i) { bench::do_not_optimize(XInput::reference(frame(i))); });
+    bench::run("XInput ReportEncoder", [&](uint64_t i) { bench::do_not_optimize(XInput::ENCODER.encode(frame(i))); });
+    bench::run("3 byte if chains", [&](uint64_t i) { bench::do_not_optimize(ThreeByte::reference(frame(i))); });
+    bench::run("3 byte ReportEncoder", [&](uint64_t i) { bench::do_not_optimize(ThreeByte::ENCODER.encode(frame(i))); });
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+#ifndef _REPORT_ENCODER_LAYOUTS_H_
+#define _REPORT_ENCODER_LAYOUTS_H_
+
+#include <cstdint>
+
+#include "Gamepad/Gamepad.h"
+#include "USBDevice/DeviceDriver/ReportEncoder.h"
+
+//Report layouts of the Switch and XInput drivers and a 3 byte PS3 style field, with the if/switch chains
+//the drivers used before ReportEncoder. The values are copied from Descriptors/, which need TinyUSB to include.
+namespace encoder_layouts
+{
+    namespace Switch
+    {
+        static constexpr uint8_t UP = 0, UP_RIGHT = 1, RIGHT = 2, DOWN_RIGHT = 3, DOWN = 4, DOWN_LEFT = 5, LEFT = 6, UP_LEFT = 7, CENTER = 8;
+
+        static constexpr uint16_t Y = 1 << 0, B = 1 << 1, A = 1 << 2, X = 1 << 3, L = 1 << 4, R = 1 << 5, ZL = 1 << 6, ZR = 1 << 7;
+        static constexpr uint16_t MINUS = 1 << 8, PLUS = 1 << 9, L3 = 1 << 10, R3 = 1 << 11, HOME = 1 << 12, CAPTURE = 1 << 13;
+
+        static constexpr ReportEncoder::ButtonBit BUTTONS[] =
+        {
+            { Gamepad::BUTTON_X, Y }, { Gamepad::BUTTON_A, B }, { Gamepad::BUTTON_Y, X }, { Gamepad::BUTTON_B, A },
+            { Gamepad::BUTTON_LB, L }, { Gamepad::BUTTON_RB, R }, { Gamepad::BUTTON_BACK, MINUS }, { Gamepad::BUTTON_START, PLUS },
+            { Gamepad::BUTTON_L3, L3 }, { Gamepad::BUTTON_R3, R3 }, { Gamepad::BUTTON_SYS, HOME }, { Gamepad::BUTTON_MISC, CAPTURE },
+        };
+        static constexpr auto ENCODER = ReportEncoder::make<uint16_t>(BUTTONS,
+            { UP, DOWN, LEFT, RIGHT, UP_LEFT, UP_RIGHT, DOWN_LEFT, DOWN_RIGHT, CENTER }, ZL, ZR);
+
+        inline uint8_t reference_dpad(const Gamepad::PadIn& gp_in)
+        {
+            switch (gp_in.dpad)
+            {
+                case Gamepad::DPAD_UP:         return UP;
+                case Gamepad::DPAD_DOWN:       return DOWN;
+                case Gamepad::DPAD_LEFT:       return LEFT;
+                case Gamepad::DPAD_RIGHT:      return RIGHT;
+                case Gamepad::DPAD_UP_LEFT:    return UP_LEFT;
+                case Gamepad::DPAD_UP_RIGHT:   return UP_RIGHT;
+                case Gamepad::DPAD_DOWN_LEFT:  return DOWN_LEFT;
+                case Gamepad::DPAD_DOWN_RIGHT: return DOWN_RIGHT;
+                default:                       return CENTER;
+            }
+        }
+
+        inline uint16_t reference_buttons(const Gamepad::PadIn& gp_in)
+        {
+            uint16_t buttons = 0;
+            if (gp_in.buttons & Gamepad::BUTTON_X)     buttons |= Y;
+            if (gp_in.buttons & Gamepad::BUTTON_A)     buttons |= B;
+            if (gp_in.buttons & Gamepad::BUTTON_Y)     buttons |= X;
+            if (gp_in.buttons & Gamepad::BUTTON_B)     buttons |= A;
+            if (gp_in.buttons & Gamepad::BUTTON_LB)    buttons |= L;
+            if (gp_in.buttons & Gamepad::BUTTON_RB)    buttons |= R;
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)  buttons |= MINUS;
+            if (gp_in.buttons & Gamepad::BUTTON_START) buttons |= PLUS;
+            if (gp_in.buttons & Gamepad::BUTTON_L3)    buttons |= L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)    buttons |= R3;
+            if (gp_in.buttons & Gamepad::BUTTON_SYS)   buttons |= HOME;
+            if (gp_in.buttons & Gamepad::BUTTON_MISC)  buttons |= CAPTURE;
+            if (gp_in.trigger_l) buttons |= ZL;
+            if (gp_in.trigger_r) buttons |= ZR;
+            return buttons;
+        }
+    }
+
+    //Dpad bits in the first of two button bytes
+    namespace XInput
+    {
+        static constexpr uint8_t DPAD_UP = 1 << 0, DPAD_DOWN = 1 << 1, DPAD_LEFT = 1 << 2, DPAD_RIGHT = 1 << 3;
+        static constexpr uint8_t START = 1 << 4, BACK = 1 << 5, L3 = 1 << 6, R3 = 1 << 7;
+        static constexpr uint8_t LB = 1 << 0, RB = 1 << 1, HOME = 1 << 2, A = 1 << 4, B = 1 << 5, X = 1 << 6, Y = 1 << 7;
+
+        static constexpr ReportEncoder::ButtonBit BUTTONS[] =
+        {
+            { Gamepad::BUTTON_BACK,  ReportEncoder::at(0, BACK)  },
+            { Gamepad::BUTTON_START, ReportEncoder::at(0, START) },
+            { Gamepad::BUTTON_L3,    ReportEncoder::at(0, L3)    },
+            { Gamepad::BUTTON_R3,    ReportEncoder::at(0, R3)    },
+            { Gamepad::BUTTON_X,     ReportEncoder::at(1, X)     },
+            { Gamepad::BUTTON_A,     ReportEncoder::at(1, A)     },
+            { Gamepad::BUTTON_Y,     ReportEncoder::at(1, Y)     },
+            { Gamepad::BUTTON_B,     ReportEncoder::at(1, B)     },
+            { Gamepad::BUTTON_LB,    ReportEncoder::at(1, LB)    },
+            { Gamepad::BUTTON_RB,    ReportEncoder::at(1, RB)    },
+            { Gamepad::BUTTON_SYS,   ReportEncoder::at(1, HOME)  },
+        };
+        static constexpr auto ENCODER = ReportEncoder::make<uint16_t>(BUTTONS,
+            ReportEncoder::dpad_bits(DPAD_UP, DPAD_DOWN, DPAD_LEFT, DPAD_RIGHT));
+
+        inline uint16_t reference(const Gamepad::PadIn& gp_in)
+        {
+            uint8_t buttons[2] = { 0, 0 };
+            switch (gp_in.dpad)
+            {
+                case Gamepad::DPAD_UP:         buttons[0] = DPAD_UP;                break;
+                case Gamepad::DPAD_DOWN:       buttons[0] = DPAD_DOWN;              break;
+                case Gamepad::DPAD_LEFT:       buttons[0] = DPAD_LEFT;              break;
+                case Gamepad::DPAD_RIGHT:      buttons[0] = DPAD_RIGHT;             break;
+                case Gamepad::DPAD_UP_LEFT:    buttons[0] = DPAD_UP | DPAD_LEFT;    break;
+                case Gamepad::DPAD_UP_RIGHT:   buttons[0] = DPAD_UP | DPAD_RIGHT;   break;
+                case Gamepad::DPAD_DOWN_LEFT:  buttons[0] = DPAD_DOWN | DPAD_LEFT;  break;
+                case Gamepad::DPAD_DOWN_RIGHT: buttons[0] = DPAD_DOWN | DPAD_RIGHT; break;
+                default:                                                            break;
+            }
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)  buttons[0] |= BACK;
+            if (gp_in.buttons & Gamepad::BUTTON_START) buttons[0] |= START;
+            if (gp_in.buttons & Gamepad::BUTTON_L3)    buttons[0] |= L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)    buttons[0] |= R3;
+            if (gp_in.buttons & Gamepad::BUTTON_X)     buttons[1] |= X;
+            if (gp_in.buttons & Gamepad::BUTTON_A)     buttons[1] |= A;
+            if (gp_in.buttons & Gamepad::BUTTON_Y)     buttons[1] |= Y;
+            if (gp_in.buttons & Gamepad::BUTTON_B)     buttons[1] |= B;
+            if (gp_in.buttons & Gamepad::BUTTON_LB)    buttons[1] |= LB;
+            if (gp_in.buttons & Gamepad::BUTTON_RB)    buttons[1] |= RB;
+            if (gp_in.buttons & Gamepad::BUTTON_SYS)   buttons[1] |= HOME;
+            return static_cast<uint16_t>(buttons[0] | (buttons[1] << 8));
+        }
+    }
+
+    //Three button bytes with the dpad and digital triggers in the first two, PS3 style
+    namespace ThreeByte
+    {
+        static constexpr uint8_t SELECT = 1 << 0, L3 = 1 << 1, R3 = 1 << 2, START = 1 << 3;
+        static constexpr uint8_t UP = 1 << 4, RIGHT = 1 << 5, DOWN = 1 << 6, LEFT = 1 << 7;
+        static constexpr uint8_t L2 = 1 << 0, R2 = 1 << 1, L1 = 1 << 2, R1 = 1 << 3;
+        static constexpr uint8_t TRIANGLE = 1 << 4, CIRCLE = 1 << 5, CROSS = 1 << 6, SQUARE = 1 << 7;
+        static constexpr uint8_t PS = 1 << 0, TP = 1 << 1;
+
+        static constexpr ReportEncoder::ButtonBit BUTTONS[] =
+        {
+            { Gamepad::BUTTON_BACK,  ReportEncoder::at(0, SELECT)   },
+            { Gamepad::BUTTON_L3,    ReportEncoder::at(0, L3)       },
+            { Gamepad::BUTTON_R3,    ReportEncoder::at(0, R3)       },
+            { Gamepad::BUTTON_START, ReportEncoder::at(0, START)    },
+            { Gamepad::BUTTON_LB,    ReportEncoder::at(1, L1)       },
+            { Gamepad::BUTTON_RB,    ReportEncoder::at(1, R1)       },
+            { Gamepad::BUTTON_Y,     ReportEncoder::at(1, TRIANGLE) },
+            { Gamepad::BUTTON_B,     ReportEncoder::at(1, CIRCLE)   },
+            { Gamepad::BUTTON_A,     ReportEncoder::at(1, CROSS)    },
+            { Gamepad::BUTTON_X,     ReportEncoder::at(1, SQUARE)   },
+            { Gamepad::BUTTON_SYS,   ReportEncoder::at(2, PS)       },
+            { Gamepad::BUTTON_MISC,  ReportEncoder::at(2, TP)       },
+        };
+        static constexpr auto ENCODER = ReportEncoder::make<uint32_t>(BUTTONS,
+            ReportEncoder::dpad_bits(UP, DOWN, LEFT, RIGHT), ReportEncoder::at(1, L2), ReportEncoder::at(1, R2));
+
+        inline uint32_t reference(const Gamepad::PadIn& gp_in)
+        {
+            uint8_t buttons[3] = { 0, 0, 0 };
+            if (gp_in.dpad == Gamepad::DPAD_UP || gp_in.dpad == Gamepad::DPAD_UP_LEFT || gp_in.dpad == Gamepad::DPAD_UP_RIGHT)             buttons[0] |= UP;
+            if (gp_in.dpad == Gamepad::DPAD_DOWN || gp_in.dpad == Gamepad::DPAD_DOWN_LEFT || gp_in.dpad == Gamepad::DPAD_DOWN_RIGHT)       buttons[0] |= DOWN;
+            if (gp_in.dpad == Gamepad::DPAD_LEFT || gp_in.dpad == Gamepad::DPAD_UP_LEFT || gp_in.dpad == Gamepad::DPAD_DOWN_LEFT)         buttons[0] |= LEFT;
+            if (gp_in.dpad == Gamepad::DPAD_RIGHT || gp_in.dpad == Gamepad::DPAD_UP_RIGHT || gp_in.dpad == Gamepad::DPAD_DOWN_RIGHT)      buttons[0] |= RIGHT;
+            if (gp_in.buttons & Gamepad::BUTTON_BACK)  buttons[0] |= SELECT;
+            if (gp_in.buttons & Gamepad::BUTTON_L3)    buttons[0] |= L3;
+            if (gp_in.buttons & Gamepad::BUTTON_R3)    buttons[0] |= R3;
+            if (gp_in.buttons & Gamepad::BUTTON_START) buttons[0] |= START;
+            if (gp_in.buttons & Gamepad::BUTTON_LB)    buttons[1] |= L1;
+            if (gp_in.buttons & Gamepad::BUTTON_RB)    buttons[1] |= R1;
+            if (gp_in.buttons & Gamepad::BUTTON_Y)     buttons[1] |= TRIANGLE;
+            if (gp_in.buttons & Gamepad::BUTTON_B)     buttons[1] |= CIRCLE;
+            if (gp_in.buttons & Gamepad::BUTTON_A)     buttons[1] |= CROSS;
+            if (gp_in.buttons & Gamepad::BUTTON_X)     buttons[1] |= SQUARE;
+            if (gp_in.buttons & Gamepad::BUTTON_SYS)   buttons[2] |= PS;
+            if (gp_in.buttons & Gamepad::BUTTON_MISC)  buttons[2] |= TP;
+            if (gp_in.trigger_l) buttons[1] |= L2;
+            if (gp_in.trigger_r) buttons[1] |= R2;
+            return buttons[0] | (buttons[1] << 8) | (buttons[2] << 16);
+        }
+    }
+
+} // namespace encoder_layouts
+
+#endif // _REPORT_ENCODER_LAYOUTS_H_
@@ -0,0 +1,79 @@
+#include <cstdint>
+
+#include "Test.h"
+#include "USBDevice/ReportEncoderLayouts.h"
+
+using namespace encoder_layouts;
+
+//Every button combination, dpad value (the impossible ones included) and trigger state against the if/switch chains
+static void test_exhaustive()
+{
+    uint32_t switch_mismatches = 0;
+    uint32_t xinput_mismatches = 0;
+    uint32_t three_byte_mismatches = 0;
+
+    Gamepad::PadIn gp_in;
+    for (uint32_t buttons = 0; buttons < 0x1000; ++buttons)
+    {
+        for (uint8_t dpad = 0; dpad < 16; ++dpad)
+        {
+            for (uint8_t triggers = 0; triggers < 4; ++triggers)
+            {
+                gp_in.buttons = static_cast<uint16_t>(buttons);
+                gp_in.dpad = dpad;
+                gp_in.trigger_l = (triggers & 1) ? 200 : 0;
+                gp_in.trigger_r = (triggers & 2) ? 1 : 0;
+
+                if (Switch::ENCODER.buttons(gp_in) != Switch::reference_buttons(gp_in) ||
+                    Switch::ENCODER.dpad(gp_in) != Switch::reference_dpad(gp_in))
+                {
+                    ++switch_mismatches;
+                }
+                if (XInput::ENCODER.encode(gp_in) != XInput::reference(gp_in))
+                {
+                    ++xinput_mismatches;
+                }
+                if (ThreeByte::ENCODER.encode(gp_in) != ThreeByte::reference(gp_in))
+                {
+                    ++three_byte_mismatches;
+                }
+            }
+        }
+    }
+    CHECK_EQ(switch_mismatches, 0u);
+    CHECK_EQ(xinput_mismatches, 0u);
+    CHECK_EQ(three_byte_mismatches, 0u);
+}
+
+//A few frames by hand, so a reference with the same mistake as a table can't hide it
+static void test_known_frames()
+{
+    Gamepad::PadIn gp_in;
+    gp_in.buttons = Gamepad::BUTTON_A | Gamepad::BUTTON_START;
+    gp_in.dpad = Gamepad::DPAD_DOWN_RIGHT;
+    gp_in.trigger_l = 0;
+    gp_in.trigger_r = 255;
+
+    CHECK_EQ(Switch::ENCODER.buttons(gp_in), Switch::B | Switch::PLUS | Switch::ZR);
+    CHECK_EQ(Switch::ENCODER.dpad(gp_in), Switch::DOWN_RIGHT);
+    CHECK_EQ(XInput::ENCODER.encode(gp_in), (XInput::START | XInput::DPAD_DOWN | XInput::DPAD_RIGHT) | (XInput::A << 8));
+    CHECK_EQ(ThreeByte::ENCODER.encode(gp_in), static_cast<uint32_t>((ThreeByte::START | ThreeByte::DOWN | ThreeByte::RIGHT) | ((ThreeByte::CROSS | ThreeByte::R2) << 8)));
+
+    //Up + down isn't a direction
+    gp_in.buttons = Gamepad::BUTTON_SYS | Gamepad::BUTTON_MISC;
+    gp_in.dpad = Gamepad::DPAD_UP | Gamepad::DPAD_DOWN;
+    gp_in.trigger_r = 0;
+
+    CHECK_EQ(Switch::ENCODER.buttons(gp_in), Switch::HOME | Switch::CAPTURE);
+    CHECK_EQ(Switch::ENCODER.dpad(gp_in), Switch::CENTER);
+    CHECK_EQ(XInput::ENCODER.encode(gp_in), XInput::HOME << 8);
+    CHECK_EQ(ThreeByte::ENCODER.encode(gp_in), static_cast<uint32_t>((ThreeByte::PS | ThreeByte::TP) << 16));
+}
+
+int main()
+{
+    test_exhaustive();
+    test_known_frames();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,111 @@
+#include <cstdint>
+
+#include "Test.h"
+#include "pico/time.h"
+#include "Board/board_api.h"
+#include "USBDevice/stats_snapshot.h"
+
+//board_api::reboot() is simulated, the test calls what the snapshot registered and starts again the way the next boot does
+
+static void (*reboot_cb_)() = nullptr;
+
+void board_api::set_reboot_cb(void (*reboot_cb)())
+{
+    reboot_cb_ = reboot_cb;
+}
+
+#if defined(CONFIG_OGXM_POLL_STATS)
+//What the running driver's host polled at, the real one counts IN transfers
+static poll_rate::Measurement measurement_;
+
+poll_rate::Measurement poll_rate::get_measurement()
+{
+    return measurement_;
+}
+#endif
+
+static void reboot(Gamepad(&gamepads)[MAX_GAMEPADS], DeviceDriverType next_driver)
+{
+    CHECK(reboot_cb_ != nullptr);
+    reboot_cb_();
+    reboot_cb_ = nullptr;
+    stats_snapshot::start(gamepads, next_driver);
+}
+
+static void send_report(Gamepad& gamepad, uint64_t latency_us)
+{
+    //Unchanged input isn't published, so every report moves the stick
+    Gamepad::PadIn pad_in = gamepad.peek_pad_in();
+    ++pad_in.joystick_lx;
+
+    host_stub::now_us += 1000;
+    gamepad.set_pad_in(pad_in);
+    (void)gamepad.get_pad_in();
+    host_stub::now_us += latency_us;
+    gamepad.record_latency();
+}
+
+static void test_snapshot()
+{
+    Gamepad gamepads[MAX_GAMEPADS];
+
+    //Cold boot
+    stats_snapshot::start(gamepads, DeviceDriverType::XINPUT);
+    CHECK(stats_snapshot::previous() == nullptr);
+
+    send_report(gamepads[0], 300);
+    send_report(gamepads[0], 5000);
+
+    //Combo switches to the WebApp, it reads what XInput recorded
+    reboot(gamepads, DeviceDriverType::WEBAPP);
+    stats_snapshot::Snapshot* snapshot = stats_snapshot::previous();
+    CHECK(snapshot != nullptr);
+    if (snapshot == nullptr)
+    {
+        return;
+    }
+    CHECK(snapshot->driver == DeviceDriverType::XINPUT);
+    CHECK_EQ(snapshot->latency[0].count, 2u);
+    CHECK_EQ(snapshot->latency[0].max_us, 5000u);
+    CHECK_EQ(snapshot->latency[0].total_us, 5300u);
+
+    //A reboot out of the WebApp back into it keeps the driver's stats, not the WebApp's
+    send_report(gamepads[0], 100);
+    reboot(gamepads, DeviceDriverType::WEBAPP);
+    snapshot = stats_snapshot::previous();
+    CHECK(snapshot != nullptr && snapshot->driver == DeviceDriverType::XINPUT);
+    CHECK(snapshot != nullptr && snapshot->latency[0].count == 2);
+
+    //A reset that didn't go through reboot() finds nothing
+    stats_snapshot::start(gamepads, DeviceDriverType::XINPUT);
+    CHECK(stats_snapshot::previous() == nullptr);
+}
+
+#if defined(CONFIG_OGXM_POLL_STATS)
+static void test_poll_measurement()
+{
+    Gamepad gamepads[MAX_GAMEPADS];
+
+    stats_snapshot::start(gamepads, DeviceDriverType::PSCLASSIC);
+    measurement_ = { 1000, 1000 };
+
+    //The WebApp's own endpoint doesn't replace what the driver measured
+    reboot(gamepads, DeviceDriverType::WEBAPP);
+    measurement_ = { 10, 100000 };
+    reboot(gamepads, DeviceDriverType::WEBAPP);
+
+    const stats_snapshot::Snapshot* snapshot = stats_snapshot::previous();
+    CHECK(snapshot != nullptr && snapshot->driver == DeviceDriverType::PSCLASSIC);
+    CHECK(snapshot != nullptr && snapshot->poll.transfers == 1000 && snapshot->poll.interval_us == 1000);
+}
+#endif
+
+int main()
+{
+    test_snapshot();
+#if defined(CONFIG_OGXM_POLL_STATS)
+    test_poll_measurement();
+#endif
+
+    return TEST_RESULT();
+}
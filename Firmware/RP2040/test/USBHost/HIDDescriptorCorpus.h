@@ -0,0 +1,215 @@
+#ifndef _HID_DESCRIPTOR_CORPUS_H_
+#define _HID_DESCRIPTOR_CORPUS_H_
+
+#include <cstdint>
+#include <vector>
+#include <initializer_list>
+
+//Report descriptors shared by the HID parser tests, benchmarks and fuzz seeds:
+//a few real generic gamepads and a seeded generator of random but mostly well formed descriptors.
+
+namespace hid_corpus
+{
+    using Descriptor = std::vector<uint8_t>;
+
+    inline std::vector<Descriptor> real_descriptors()
+    {
+        return
+        {
+            //Generic USB joystick, 5 byte axes, hat, 12 buttons, vendor byte, output report
+            {
+                0x05, 0x01, 0x09, 0x04, 0xA1, 0x01, 0xA1, 0x02, 0x75, 0x08, 0x95, 0x05,
+                0x15, 0x00, 0x26, 0xFF, 0x00, 0x35, 0x00, 0x46, 0xFF, 0x00, 0x09, 0x30,
+                0x09, 0x30, 0x09, 0x30, 0x09, 0x30, 0x09, 0x31, 0x81, 0x02, 0x75, 0x04,
+                0x95, 0x01, 0x25, 0x07, 0x46, 0x3B, 0x01, 0x65, 0x14, 0x09, 0x39, 0x81,
+                0x42, 0x65, 0x00, 0x75, 0x01, 0x95, 0x0C, 0x25, 0x01, 0x45, 0x01, 0x05,
+                0x09, 0x19, 0x01, 0x29, 0x0C, 0x81, 0x02, 0x06, 0x00, 0xFF, 0x75, 0x01,
+                0x95, 0x08, 0x25, 0x01, 0x45, 0x01, 0x09, 0x01, 0x81, 0x02, 0xC0, 0xA1,
+                0x02, 0x75, 0x08, 0x95, 0x07, 0x46, 0xFF, 0x00, 0x26, 0xFF, 0x00, 0x09,
+                0x02, 0x91, 0x02, 0xC0, 0xC0
+            },
+            //Generic USB joystick, X/Y/Z/Rz, hat, 12 buttons, 16 vendor bits, output report
+            {
+                0x05, 0x01, 0x09, 0x04, 0xA1, 0x01, 0xA1, 0x02, 0x15, 0x00, 0x26, 0xFF,
+                0x00, 0x35, 0x00, 0x46, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x04, 0x09, 0x30,
+                0x09, 0x31, 0x09, 0x32, 0x09, 0x35, 0x81, 0x02, 0x25, 0x07, 0x46, 0x3B,
+                0x01, 0x75, 0x04, 0x95, 0x01, 0x65, 0x14, 0x09, 0x39, 0x81, 0x42, 0x65,
+                0x00, 0x25, 0x01, 0x45, 0x01, 0x75, 0x01, 0x95, 0x0C, 0x05, 0x09, 0x19,
+                0x01, 0x29, 0x0C, 0x81, 0x02, 0x06, 0x00, 0xFF, 0x75, 0x01, 0x95, 0x10,
+                0x25, 0x01, 0x45, 0x01, 0x09, 0x01, 0x81, 0x02, 0xC0, 0xA1, 0x02, 0x26,
+                0xFF, 0x00, 0x46, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x07, 0x09, 0x02, 0x91,
+                0x02, 0xC0, 0xC0
+            },
+            //Gamepad with report ID 1, 14 buttons, 6 bit vendor field, analog triggers and a 54 byte vendor tail
+            {
+                0x05, 0x01, 0x09, 0x05, 0xA1, 0x01, 0x85, 0x01, 0x09, 0x30, 0x09, 0x31,
+                0x09, 0x32, 0x09, 0x35, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95,
+                0x04, 0x81, 0x02, 0x09, 0x39, 0x15, 0x00, 0x25, 0x07, 0x35, 0x00, 0x46,
+                0x3B, 0x01, 0x65, 0x14, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42, 0x65, 0x00,
+                0x05, 0x09, 0x19, 0x01, 0x29, 0x0E, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01,
+                0x95, 0x0E, 0x81, 0x02, 0x06, 0x00, 0xFF, 0x09, 0x20, 0x75, 0x06, 0x95,
+                0x01, 0x15, 0x00, 0x25, 0x7F, 0x81, 0x02, 0x05, 0x01, 0x09, 0x33, 0x09,
+                0x34, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x02, 0x81, 0x02,
+                0x06, 0x00, 0xFF, 0x09, 0x21, 0x95, 0x36, 0x81, 0x02, 0xC0
+            },
+            //Gamepad with report ID 3, 16 buttons, hat with padding, 16 bit axes
+            {
+                0x05, 0x01, 0x09, 0x05, 0xA1, 0x01, 0x85, 0x03, 0x05, 0x09, 0x19, 0x01,
+                0x29, 0x10, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x10, 0x81, 0x02,
+                0x05, 0x01, 0x09, 0x39, 0x15, 0x00, 0x25, 0x07, 0x35, 0x00, 0x46, 0x3B,
+                0x01, 0x65, 0x14, 0x75, 0x04, 0x95, 0x01, 0x81, 0x42, 0x75, 0x04, 0x95,
+                0x01, 0x81, 0x03, 0x15, 0x00, 0x27, 0xFF, 0xFF, 0x00, 0x00, 0x09, 0x30,
+                0x09, 0x31, 0x09, 0x32, 0x09, 0x35, 0x75, 0x10, 0x95, 0x04, 0x81, 0x02,
+                0xC0
+            },
+        };
+    }
+
+    //xorshift32, the corpus only has to be the same from run to run
+    class Random
+    {
+    public:
+        explicit Random(uint32_t seed) : state_(seed ? seed : 1) {}
+
+        uint32_t next()
+        {
+            state_ ^= state_ << 13;
+            state_ ^= state_ >> 17;
+            state_ ^= state_ << 5;
+            return state_;
+        }
+        //lo to hi inclusive
+        int32_t range(int32_t lo, int32_t hi)
+        {
+            return lo + static_cast<int32_t>(next() % static_cast<uint32_t>(hi - lo + 1));
+        }
+        //0 to 99
+        uint32_t percent()
+        {
+            return next() % 100;
+        }
+        template <typename T>
+        T pick(std::initializer_list<T> choices)
+        {
+            return *(choices.begin() + (next() % choices.size()));
+        }
+
+    private:
+        uint32_t state_;
+    };
+
+    //Short item, size 0 picks the smallest encoding that holds the value
+    inline void item(Descriptor& desc, uint8_t tag, int64_t value, uint8_t size = 0)
+    {
+        if (size == 0)
+        {
+            size = (value >= -128 && value <= 255) ? 1 : (value >= -32768 && value <= 65535) ? 2 : 4;
+        }
+        desc.push_back(tag | ((size == 4) ? 3 : size));
+        for (uint8_t i = 0; i < size; ++i)
+        {
+            desc.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i)));
+        }
+    }
+
+    //Application collections full of random global, local and main items, mostly gamepad like
+    //but with odd sizes, report IDs in the middle of reports, signed logical ranges and nesting
+    inline Descriptor generate(Random& random)
+    {
+        Descriptor desc;
+        const int32_t applications = random.range(1, 4);
+
+        for (int32_t a = 0; a < applications; ++a)
+        {
+            item(desc, 0x04, 1);
+            item(desc, 0x08, random.pick<int64_t>({ 4, 5, 2, 6, 8, 5, 5 }));
+            if (random.percent() < 10)
+            {
+                item(desc, 0x84, random.range(1, 9));
+            }
+            item(desc, 0xA0, 1);
+
+            int32_t depth = 1;
+            const int32_t items = random.range(3, 25);
+
+            for (int32_t i = 0; i < items; ++i)
+            {
+                const uint32_t c = random.percent();
+                if (c < 8)
+                {
+                    item(desc, 0x04, random.pick<int64_t>({ 1, 9, 0xFF00, 0x0C, 2 }));
+                }
+                else if (c < 25)
+                {
+                    item(desc, 0x08, random.pick<int64_t>({ 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x01, 0x20, 0x10030 }));
+                }
+                else if (c < 30)
+                {
+                    item(desc, 0x18, random.range(0, 4));
+                    item(desc, 0x28, random.range(4, 16));
+                }
+                else if (c < 35)
+                {
+                    item(desc, 0x84, random.range(1, 255));
+                }
+                else if (c < 42)
+                {
+                    item(desc, 0x14, random.pick<int64_t>({ 0, -1, -127, -32768, 0, 0 }));
+                }
+                else if (c < 50)
+                {
+                    item(desc, 0x24, random.pick<int64_t>({ 1, 7, 127, 255, 1023, 65535, -1 }), random.pick<uint8_t>({ 0, 1, 2 }));
+                }
+                else if (c < 53)
+                {
+                    item(desc, 0x34, random.pick<int64_t>({ 0, -90 }));
+                    item(desc, 0x44, random.pick<int64_t>({ 315, 255 }), random.pick<uint8_t>({ 0, 1 }));
+                }
+                else if (c < 55)
+                {
+                    item(desc, 0x64, random.pick<int64_t>({ 0, 0x14 }));
+                    item(desc, 0x54, random.pick<int64_t>({ 0, 0x0E }));
+                }
+                else if (c < 63)
+                {
+                    item(desc, 0x74, random.pick<int64_t>({ 1, 1, 4, 8, 8, 16, 0, 33 }));
+                }
+                else if (c < 71)
+                {
+                    item(desc, 0x94, random.pick<int64_t>({ 0, 1, 2, 3, 4, 8, 12, 16, 20 }));
+                }
+                else if (c < 90)
+                {
+                    item(desc, random.pick<uint8_t>({ 0x80, 0x80, 0x80, 0x90, 0xB0 }), random.pick<int64_t>({ 2, 3, 0x42, 1 }));
+                }
+                else if (c < 95 && depth < 6)
+                {
+                    item(desc, 0xA0, random.pick<int64_t>({ 0, 2, 3 }));
+                    ++depth;
+                }
+                else if (depth > 1)
+                {
+                    desc.push_back(0xC0);
+                    --depth;
+                }
+            }
+            desc.insert(desc.end(), depth, 0xC0);
+        }
+        return desc;
+    }
+
+    //The real descriptors followed by count generated ones
+    inline std::vector<Descriptor> make(uint32_t seed, size_t count)
+    {
+        std::vector<Descriptor> corpus = real_descriptors();
+        Random random(seed);
+        for (size_t i = 0; i < count; ++i)
+        {
+            corpus.push_back(generate(random));
+        }
+        return corpus;
+    }
+
+} // namespace hid_corpus
+
+#endif // _HID_DESCRIPTOR_CORPUS_H_
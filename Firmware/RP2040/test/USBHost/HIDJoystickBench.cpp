@@ -0,0 +1,116 @@
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <array>
+
+#include "Bench.h"
+#include "USBHost/HIDDescriptorCorpus.h"
+#include "USBHost/HIDParser/HIDJoystick.h"
+#include "USBHost/HIDParser/HIDRumble.h"
+#include "USBHost/HIDParserReference/HIDJoystick.h"
+
+//Per report cost of HIDJoystick::parseData against the descriptor walking version it replaced,
+//on each real descriptor of the corpus, and the mount cost (parse + compile) over the generated ones.
+//HIDHost::initialize's full mount work (parse, joystick and rumble compile) is timed per real descriptor.
+
+static constexpr uint32_t CORPUS_SEED = 0x4F47584D;
+static constexpr size_t MOUNT_CORPUS_SIZE = 1000;
+static constexpr uint8_t REPORT_IDS[] = { 0, 0, 1, 3 }; //Of each real descriptor, in corpus order
+static constexpr size_t REPORT_COUNT = 256;
+
+static HIDReportArena arena;
+
+using Report = std::array<uint8_t, 64>;
+
+static std::vector<Report> make_reports(uint8_t report_id)
+{
+    hid_corpus::Random random(report_id + 1);
+    std::vector<Report> reports(REPORT_COUNT);
+    for (auto& report : reports)
+    {
+        for (auto& byte : report)
+        {
+            byte = static_cast<uint8_t>(random.next());
+        }
+        if (report_id)
+        {
+            report[0] = report_id;
+        }
+    }
+    return reports;
+}
+
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    const auto real = hid_corpus::real_descriptors();
+    char name[64];
+
+    for (size_t d = 0; d < real.size(); ++d)
+    {
+        auto reports = make_reports(REPORT_IDS[d]);
+        const uint16_t desc_len = static_cast<uint16_t>(real[d].size());
+
+        HIDReportDescriptor descriptor(arena, real[d].data(), desc_len);
+        HIDJoystick joystick;
+        joystick.compile(descriptor);
+        HIDJoystickData data[4];
+
+        auto reference_descriptor = std::make_shared<hid_reference::HIDReportDescriptor>(real[d].data(), desc_len);
+        hid_reference::HIDJoystick reference(reference_descriptor);
+        hid_reference::HIDJoystickData reference_data;
+
+        std::snprintf(name, sizeof(name), "parseData real%zu reference", d);
+        bench::run(name, [&](uint64_t i) 
+        { 
+            Report& report = reports[i % REPORT_COUNT];
+            bench::do_not_optimize(reference.parseData(report.data(), sizeof(Report), &reference_data));
+        });
+        std::snprintf(name, sizeof(name), "parseData real%zu", d);
+        bench::run(name, [&](uint64_t i) 
+        { 
+            Report& report = reports[i % REPORT_COUNT];
+            bench::do_not_optimize(joystick.parseData(report.data(), sizeof(Report), data, 4));
+        });
+    }
+
+    //Mount runs once per device, fewer iterations
+    const uint64_t real_mount_iterations = std::max<uint64_t>(bench::iterations / 100, 1);
+    static HIDRumble rumble;
+
+    for (size_t d = 0; d < real.size(); ++d)
+    {
+        static HIDJoystick joystick;
+        std::snprintf(name, sizeof(name), "mount real%zu (parse + joystick + rumble)", d);
+        bench::run(name, [&](uint64_t) 
+        { 
+            HIDReportDescriptor descriptor(arena, real[d].data(), static_cast<uint16_t>(real[d].size()));
+            joystick.compile(descriptor);
+            rumble.compile(descriptor);
+            bench::do_not_optimize(joystick.isValid());
+        }, real_mount_iterations);
+    }
+
+    const auto corpus = hid_corpus::make(CORPUS_SEED, MOUNT_CORPUS_SIZE);
+    const uint64_t mount_iterations = std::max<uint64_t>(bench::iterations / 100, corpus.size());
+    static HIDJoystick joystick;
+
+    bench::run("mount (parse + compile) reference", [&](uint64_t i) 
+    { 
+        const auto& desc = corpus[i % corpus.size()];
+        auto descriptor = std::make_shared<hid_reference::HIDReportDescriptor>(desc.data(), static_cast<uint16_t>(desc.size()));
+        hid_reference::HIDJoystick reference(descriptor);
+        bench::do_not_optimize(reference.isValid());
+    }, mount_iterations);
+    bench::run("mount (parse + compile)", [&](uint64_t i) 
+    { 
+        const auto& desc = corpus[i % corpus.size()];
+        HIDReportDescriptor descriptor(arena, desc.data(), static_cast<uint16_t>(desc.size()));
+        joystick.compile(descriptor);
+        bench::do_not_optimize(joystick.isValid());
+    }, mount_iterations);
+
+    return 0;
+}
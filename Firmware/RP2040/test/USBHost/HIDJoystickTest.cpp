@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <vector>
+#include <initializer_list>
+
+#include "Test.h"
+#include "USBHost/HIDParser/HIDReportDescriptor.h"
+#include "USBHost/HIDParser/HIDJoystick.h"
+
+//Which joystick a report lands in: report ID lookup through the packed index,
+//the block without an ID as fallback, and one HIDJoystickData per collection
+
+static HIDReportArena arena;
+
+//Gamepad collection with a single 8 bit X axis, report_id 0 leaves the ID out
+static void add_gamepad(std::vector<uint8_t>& desc, uint8_t report_id)
+{
+    desc.insert(desc.end(), { 0x05, 0x01, 0x09, 0x05, 0xA1, 0x01 });
+    if (report_id)
+    {
+        desc.insert(desc.end(), { 0x85, report_id });
+    }
+    desc.insert(desc.end(), { 0x09, 0x30, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x01, 0x81, 0x02, 0xC0 });
+}
+
+static void compile(HIDJoystick& joystick, std::initializer_list<uint8_t> report_ids)
+{
+    std::vector<uint8_t> desc;
+    for (uint8_t report_id : report_ids)
+    {
+        add_gamepad(desc, report_id);
+    }
+    HIDReportDescriptor descriptor(arena, desc.data(), static_cast<uint16_t>(desc.size()));
+    CHECK(descriptor.GetResult() == HIDParseResult::Ok);
+    joystick.compile(descriptor);
+}
+
+static int8_t parse(HIDJoystick& joystick, std::vector<uint8_t> report, HIDJoystickData* data, uint8_t count = 4)
+{
+    return joystick.parseData(report.data(), static_cast<uint16_t>(report.size()), data, count);
+}
+
+static void test_report_ids()
+{
+    //Neighbouring IDs share an index byte, the second block with ID 2 is never picked
+    HIDJoystick joystick;
+    compile(joystick, { 2, 3, 2 });
+    CHECK_EQ(joystick.getCount(), 3u);
+
+    HIDJoystickData data[4];
+    CHECK_EQ(parse(joystick, { 2, 0xFF }, data), 0);
+    CHECK_EQ(data[0].X, 32767);
+    CHECK_EQ(parse(joystick, { 3, 0x00 }, data), 1);
+    CHECK_EQ(data[1].X, -32768);
+    CHECK_EQ(data[0].X, 32767);
+
+    //No block for the ID and none without one
+    CHECK_EQ(parse(joystick, { 4, 0x80 }, data), -1);
+    CHECK_EQ(parse(joystick, { 0, 0x80 }, data), -1);
+    //Too short for the block
+    CHECK_EQ(parse(joystick, { 2 }, data), -1);
+    //Collection past the caller's data
+    CHECK_EQ(parse(joystick, { 3, 0x00 }, data, 1), -1);
+}
+
+static void test_index_edges()
+{
+    HIDJoystick joystick;
+    compile(joystick, { 1, 254, 255, 128 });
+
+    HIDJoystickData data[4];
+    CHECK_EQ(parse(joystick, { 1, 0 }, data), 0);
+    CHECK_EQ(parse(joystick, { 254, 0 }, data), 1);
+    CHECK_EQ(parse(joystick, { 255, 0 }, data), 2);
+    CHECK_EQ(parse(joystick, { 128, 0 }, data), 3);
+    CHECK_EQ(parse(joystick, { 129, 0 }, data), -1);
+    CHECK_EQ(parse(joystick, { 253, 0 }, data), -1);
+}
+
+static void test_no_report_ids()
+{
+    //The first byte is data, any value has to reach the block
+    HIDJoystick joystick;
+    compile(joystick, { 0 });
+
+    HIDJoystickData data[4];
+    CHECK_EQ(parse(joystick, { 0xFF }, data), 0);
+    CHECK_EQ(data[0].X, 32767);
+    CHECK_EQ(parse(joystick, { 0x02 }, data), 0);
+    CHECK_EQ(parse(joystick, {}, data), -1);
+}
+
+static void test_mixed()
+{
+    //An ID without a block of its own falls back to the block without an ID
+    HIDJoystick joystick;
+    compile(joystick, { 0, 5 });
+
+    HIDJoystickData data[4];
+    CHECK_EQ(parse(joystick, { 5, 0 }, data), 1);
+    CHECK_EQ(parse(joystick, { 6, 0 }, data), 0);
+
+    //Compiling again starts from an empty index
+    compile(joystick, { 0 });
+    CHECK_EQ(parse(joystick, { 5, 0 }, data), 0);
+}
+
+int main()
+{
+    test_report_ids();
+    test_index_edges();
+    test_no_report_ids();
+    test_mixed();
+    return TEST_RESULT();
+}
@@ -0,0 +1,132 @@
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Test.h"
+#include "USBHost/HIDDescriptorCorpus.h"
+#include "USBHost/HIDParser/HIDReportDescriptor.h"
+#include "USBHost/HIDParserReference/HIDReportDescriptor.h"
+
+//The arena parser has to expand every descriptor to the same items as the vector based parser it replaced.
+//Both are flattened to text, one line per report, block and item, and compared.
+//The arena parser is allowed to refuse a descriptor that doesn't fit its capacity, nothing else.
+
+static constexpr uint32_t CORPUS_SEED = 0x4F47584D;
+static constexpr size_t CORPUS_SIZE = 5000;
+
+template <typename IO>
+static void append_item(std::string& out, const IO& io)
+{
+    char line[128];
+    std::snprintf(line, sizeof(line), "  %d %u %u %u %d %d %d %d %u %u\n", 
+        static_cast<int>(io.type), io.sub_type, io.size, io.id, 
+        io.logical_min, io.logical_max, io.physical_min, io.physical_max, io.unit, io.unit_exponent);
+    out += line;
+}
+
+static std::string flatten(const HIDReportDescriptor& desc)
+{
+    std::string out;
+    for (uint8_t r = 0; r < desc.GetReportCount(); ++r)
+    {
+        const HIDIOReport& report = desc.GetReport(r);
+        out += "report " + std::to_string(static_cast<int>(report.report_type)) + "\n";
+
+        const HIDIOBlockList* lists[] = { &report.inputs, &report.outputs, &report.features };
+        for (int type = 0; type < 3; ++type)
+        {
+            for (uint8_t b = 0; b < lists[type]->count; ++b)
+            {
+                out += " block " + std::to_string(type) + "\n";
+                const HIDIOBlock& block = desc.GetBlock(lists[type]->first + b);
+                for (uint16_t u = 0; u < block.usage_count; ++u)
+                {
+                    const HIDUsage& usage = desc.GetUsage(block, u);
+                    for (uint32_t i = 0; i < usage.property.count; ++i)
+                    {
+                        append_item(out, HIDInputOutput(usage, i));
+                    }
+                }
+            }
+        }
+    }
+    return out;
+}
+
+static std::string flatten(const hid_reference::HIDReportDescriptor& desc)
+{
+    std::string out;
+    for (const auto& report : desc.GetReports())
+    {
+        out += "report " + std::to_string(static_cast<int>(report.report_type)) + "\n";
+
+        const std::vector<hid_reference::HIDIOBlock>* lists[] = { &report.inputs, &report.outputs, &report.features };
+        for (int type = 0; type < 3; ++type)
+        {
+            for (const auto& block : *lists[type])
+            {
+                out += " block " + std::to_string(type) + "\n";
+                for (const auto& io : block.data)
+                {
+                    append_item(out, io);
+                }
+            }
+        }
+    }
+    return out;
+}
+
+static HIDReportArena arena;
+
+int main()
+{
+    const auto corpus = hid_corpus::make(CORPUS_SEED, CORPUS_SIZE);
+
+    uint32_t results[8]{};
+    for (size_t i = 0; i < corpus.size(); ++i)
+    {
+        const auto& data = corpus[i];
+        const uint16_t len = static_cast<uint16_t>(data.size());
+
+        HIDReportDescriptor desc(arena, data.data(), len);
+        hid_reference::HIDReportDescriptor reference(data.data(), len);
+
+        const HIDParseResult result = desc.GetResult();
+        ++results[static_cast<uint8_t>(result)];
+
+        switch (result)
+        {
+            case HIDParseResult::Ok:
+                if (!CHECK(flatten(desc) == flatten(reference)))
+                {
+                    std::printf("  descriptor %zu differs\n", i);
+                }
+                break;
+
+            //The reference makes an empty report list out of these
+            case HIDParseResult::NoReports:
+                if (!CHECK(reference.GetReports().empty()))
+                {
+                    std::printf("  descriptor %zu has reports in the reference\n", i);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    std::printf("Ok %u, NoReports %u, TooManyReports %u, TooManyUsages %u, TooManyBlocks %u, CollectionTooDeep %u, OutsideCollection %u\n",
+        results[0], results[1], results[2], results[3], results[4], results[5], results[6]);
+
+    //Every real descriptor parses, and the generated ones mostly fit
+    for (size_t i = 0; i < hid_corpus::real_descriptors().size(); ++i)
+    {
+        HIDReportDescriptor desc(arena, corpus[i].data(), static_cast<uint16_t>(corpus[i].size()));
+        CHECK(desc.GetResult() == HIDParseResult::Ok);
+    }
+    CHECK(results[static_cast<uint8_t>(HIDParseResult::Ok)] > CORPUS_SIZE * 9 / 10);
+
+    return TEST_RESULT();
+}
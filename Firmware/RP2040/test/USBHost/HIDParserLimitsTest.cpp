@@ -0,0 +1,61 @@
+#include <cstdint>
+
+#include "Test.h"
+#include "USBHost/HIDParser/HIDReportDescriptor.h"
+
+//Built with HID_MAX_USAGES=4 so the arena fills up on small descriptors, 
+//every case has to fail cleanly instead of writing past the arena (_GLIBCXX_ASSERTIONS aborts on that)
+static_assert(HID_MAX_USAGES == 4, "HIDParserLimitsTest needs HID_MAX_USAGES=4");
+
+static HIDReportArena arena;
+
+template <size_t N>
+static HIDParseResult parse(const uint8_t (&desc)[N])
+{
+    HIDReportDescriptor descriptor(arena, desc, N);
+    return descriptor.GetResult();
+}
+
+int main()
+{
+    //Collection usage, X and Y, then a padding item: exactly 4 usages
+    static constexpr uint8_t FITS[] = 
+    {
+        0x05, 0x01, 0x09, 0x05, 0xA1, 0x01,
+        0x09, 0x30, 0x09, 0x31, 0x75, 0x08, 0x95, 0x02, 0x81, 0x02,
+        0x81, 0x01,
+        0xC0
+    };
+    CHECK(parse(FITS) == HIDParseResult::Ok);
+
+    //Same with a report ID before the padding item, that main item needs both a padding usage
+    //and a report ID usage, 5 in total
+    static constexpr uint8_t PADDING_AND_REPORT_ID[] = 
+    {
+        0x05, 0x01, 0x09, 0x05, 0xA1, 0x01,
+        0x09, 0x30, 0x09, 0x31, 0x75, 0x08, 0x95, 0x02, 0x81, 0x02,
+        0x85, 0x01, 0x81, 0x01,
+        0xC0
+    };
+    CHECK(parse(PADDING_AND_REPORT_ID) == HIDParseResult::TooManyUsages);
+
+    //A report ID in front of a regular usage is one extra
+    static constexpr uint8_t USAGE_AND_REPORT_ID[] = 
+    {
+        0x05, 0x01, 0x09, 0x05, 0xA1, 0x01,
+        0x09, 0x30, 0x09, 0x31, 0x75, 0x08, 0x95, 0x02, 0x81, 0x02,
+        0x85, 0x01, 0x09, 0x32, 0x81, 0x02,
+        0xC0
+    };
+    CHECK(parse(USAGE_AND_REPORT_ID) == HIDParseResult::TooManyUsages);
+
+    static constexpr uint8_t REPORT_ID_FITS[] = 
+    {
+        0x05, 0x01, 0x09, 0x05, 0xA1, 0x01,
+        0x85, 0x01, 0x09, 0x30, 0x75, 0x08, 0x95, 0x01, 0x81, 0x02,
+        0xC0
+    };
+    CHECK(parse(REPORT_ID_FITS) == HIDParseResult::Ok);
+
+    return TEST_RESULT();
+}
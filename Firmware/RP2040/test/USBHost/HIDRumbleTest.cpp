@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Test.h"
+#include "USBHost/HIDDescriptorCorpus.h"
+#include "USBHost/HIDParser/HIDRumble.h"
+#include "USBHost/HIDParser/HIDUtils.h"
+
+//Built twice, hid_rumble_test as shipped and hid_rumble_vendor_test with HID_RUMBLE_VENDOR_FIELDS=1
+
+static HIDReportArena arena;
+
+static HIDRumble compile(const std::vector<uint8_t>& desc)
+{
+    HIDReportDescriptor descriptor(arena, desc.data(), static_cast<uint16_t>(desc.size()));
+    HIDRumble rumble;
+    rumble.compile(descriptor);
+    return rumble;
+}
+
+static bool report_is(const HIDRumble& rumble, const std::vector<uint8_t>& expected)
+{
+    return rumble.getReportLength() == expected.size() &&
+           std::memcmp(rumble.getReport(), expected.data(), expected.size()) == 0;
+}
+
+//writeBitsLE against readBitsLE, bits outside the field have to stay as they were
+static void test_bit_writer()
+{
+    hid_corpus::Random random(1);
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < 200000; ++i)
+    {
+        uint8_t data[12];
+        uint8_t before[12];
+        for (auto& byte : data)
+        {
+            byte = static_cast<uint8_t>(random.next());
+        }
+        std::memcpy(before, data, sizeof(data));
+
+        const uint32_t offset = random.range(0, 63);
+        const uint32_t length = random.range(1, 32);
+        const uint32_t value = random.next();
+        const uint32_t mask = (length == 32) ? 0xFFFFFFFF : ((1u << length) - 1);
+
+        HIDUtils::writeBitsLE(data, offset, length, value);
+        if (HIDUtils::readBitsLE(data, offset, length) != (value & mask))
+        {
+            ++errors;
+        }
+        for (uint32_t bit = 0; bit < sizeof(data) * 8; ++bit)
+        {
+            if ((bit < offset || bit >= offset + length) && (((data[bit / 8] ^ before[bit / 8]) >> (bit % 8)) & 1))
+            {
+                ++errors;
+                break;
+            }
+        }
+    }
+    CHECK_EQ(errors, 0u);
+}
+
+//Gamepad with 2 haptic intensities 0..100 in 7 bits each and 2 bits of constant padding, no report ID
+static void test_haptics()
+{
+    const std::vector<uint8_t> desc = 
+    {
+        0x05, 0x01, 0x09, 0x05, 0xA1, 0x01, 
+        0x09, 0x30, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x01, 0x81, 0x02,
+        0x05, 0x0E, 0x09, 0x23, 0x15, 0x00, 0x25, 0x64, 0x75, 0x07, 0x95, 0x02, 0x91, 0x02, 
+        0x75, 0x02, 0x95, 0x01, 0x91, 0x03, 
+        0xC0
+    };
+    HIDRumble rumble = compile(desc);
+
+    CHECK(rumble.isValid());
+    CHECK_EQ(rumble.getReportId(), 0);
+    CHECK(report_is(rumble, { 0x00, 0x00 }));
+
+    //Strong in bits 0-6, weak in bits 7-13
+    CHECK(rumble.encode(255, 0));
+    CHECK(report_is(rumble, { 0x64, 0x00 }));
+    CHECK(rumble.encode(0, 255));
+    CHECK(report_is(rumble, { 0x00, 0x32 }));
+    CHECK(rumble.encode(128, 64));
+    CHECK(report_is(rumble, { 0xB2, 0x0C }));
+    CHECK(!rumble.encode(128, 64));
+    CHECK(rumble.encode(0, 0));
+    CHECK(report_is(rumble, { 0x00, 0x00 }));
+}
+
+//Joystick with a PID Set Constant Force report (ID 5), effect block index and a 16 bit magnitude.
+//The magnitude does nothing without the effect having been created and started, so it's not a motor
+static void test_pid_ignored()
+{
+    const std::vector<uint8_t> desc = 
+    {
+        0x05, 0x01, 0x09, 0x04, 0xA1, 0x01, 0x85, 0x01, 
+        0x09, 0x30, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08, 0x95, 0x01, 0x81, 0x02,
+        0x05, 0x0F, 0x09, 0x73, 0xA1, 0x02, 0x85, 0x05, 
+        0x09, 0x22, 0x15, 0x01, 0x25, 0x28, 0x75, 0x08, 0x95, 0x01, 0x91, 0x02,
+        0x09, 0x70, 0x16, 0xF0, 0xD8, 0x26, 0x10, 0x27, 0x75, 0x10, 0x95, 0x01, 0x91, 0x02, 
+        0xC0, 0xC0
+    };
+    HIDRumble rumble = compile(desc);
+
+    CHECK(!rumble.isValid());
+    CHECK(!rumble.encode(255, 255));
+}
+
+//DragonRise 0079:0006, a vendor output report of 7 bytes and nothing else
+static void test_vendor()
+{
+    const std::vector<uint8_t> desc = 
+    {
+        0x05, 0x01, 0x09, 0x04, 0xA1, 0x01, 0xA1, 0x02, 0x75, 0x08, 0x95, 0x05, 0x15, 0x00, 0x26, 0xFF, 
+        0x00, 0x35, 0x00, 0x46, 0xFF, 0x00, 0x09, 0x30, 0x09, 0x30, 0x09, 0x30, 0x09, 0x30, 0x09, 0x31, 
+        0x81, 0x02, 0x75, 0x04, 0x95, 0x01, 0x25, 0x07, 0x46, 0x3B, 0x01, 0x65, 0x14, 0x09, 0x39, 0x81, 
+        0x42, 0x65, 0x00, 0x75, 0x01, 0x95, 0x0C, 0x25, 0x01, 0x45, 0x01, 0x05, 0x09, 0x19, 0x01, 0x29, 
+        0x0C, 0x81, 0x02, 0x06, 0x00, 0xFF, 0x75, 0x01, 0x95, 0x08, 0x25, 0x01, 0x45, 0x01, 0x09, 0x01, 
+        0x81, 0x02, 0xC0, 0xA1, 0x02, 0x75, 0x08, 0x95, 0x07, 0x46, 0xFF, 0x00, 0x26, 0xFF, 0x00, 0x09, 
+        0x02, 0x91, 0x02, 0xC0, 0xC0
+    };
+    HIDRumble rumble = compile(desc);
+
+#if HID_RUMBLE_VENDOR_FIELDS
+    //First two bytes are the motors
+    CHECK(rumble.isValid());
+    CHECK_EQ(rumble.getReportLength(), 7);
+    CHECK(rumble.encode(255, 128));
+    CHECK(report_is(rumble, { 0xFF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00 }));
+#else
+    CHECK(!rumble.isValid());
+#endif
+}
+
+int main()
+{
+    test_bit_writer();
+    test_haptics();
+    test_pid_ignored();
+    test_vendor();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,59 @@
+#include <cstdint>
+#include <vector>
+
+#include "Bench.h"
+#include "USBHost/HardwareIDTables.h"
+
+//Mount time VID/PID lookup, half the queries are listed IDs and half are misses one PID off
+
+using namespace hardware_id_tables;
+
+template <size_t NumMaps>
+static std::vector<HardwareID> make_queries(const HostTypeMap (&maps)[NumMaps])
+{
+    std::vector<HardwareID> queries;
+    for (const auto& map : maps)
+    {
+        for (size_t i = 0; i < map.num_ids; ++i)
+        {
+            queries.push_back(map.ids[i]);
+            queries.push_back({ map.ids[i].vid, static_cast<uint16_t>(map.ids[i].pid ^ 1) });
+        }
+    }
+    //Spread hits and misses of every list through the run
+    uint32_t state = 0xC0FFEE;
+    for (size_t i = queries.size(); i > 1; --i)
+    {
+        state = state * 1664525u + 1013904223u;
+        std::swap(queries[i - 1], queries[(state >> 8) % i]);
+    }
+    return queries;
+}
+
+int main(int argc, char** argv)
+{
+    bench::init(argc, argv);
+
+    const auto real_queries = make_queries(HOST_TYPE_MAP);
+    bench::run("real lists, linear walk", [&](uint64_t i) 
+    {
+        bench::do_not_optimize(find_linear(HOST_TYPE_MAP, real_queries[i % real_queries.size()]));
+    });
+    bench::run("real lists, HardwareIDTable::find", [&](uint64_t i) 
+    {
+        bench::do_not_optimize(HardwareIDTable::find(HARDWARE_ID_TABLE, real_queries[i % real_queries.size()]));
+    });
+
+    static Synthetic synthetic;
+    const auto synthetic_queries = make_queries(synthetic.maps);
+    bench::run("2000 IDs, linear walk", [&](uint64_t i) 
+    {
+        bench::do_not_optimize(find_linear(synthetic.maps, synthetic_queries[i % synthetic_queries.size()]));
+    });
+    bench::run("2000 IDs, HardwareIDTable::find", [&](uint64_t i) 
+    {
+        bench::do_not_optimize(HardwareIDTable::find(synthetic.table, synthetic_queries[i % synthetic_queries.size()]));
+    });
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+#ifndef _OGXM_HARDWARE_ID_TABLES_H_
+#define _OGXM_HARDWARE_ID_TABLES_H_
+
+#include <cstdint>
+#include <array>
+
+#include "USBHost/HardwareIDs.h"
+
+//The per-type list walk HostManager::get_type() did before HARDWARE_ID_TABLE, and a synthetic
+//list set much larger than the real one for timing the two against each other
+namespace hardware_id_tables
+{
+    static constexpr size_t SYNTHETIC_IDS = 2000;
+
+    template <size_t NumMaps>
+    inline HostDriverType find_linear(const HostTypeMap (&maps)[NumMaps], const HardwareID& ids)
+    {
+        for (const auto& map : maps)
+        {
+            for (size_t i = 0; i < map.num_ids; i++)
+            {
+                if (ids.pid == map.ids[i].pid && ids.vid == map.ids[i].vid)
+                {
+                    return map.type;
+                }
+            }
+        }
+        return HostDriverType::UNKNOWN;
+    }
+
+    //Unique pseudo random IDs split over 8 types, PIDs are all even so the odd ones next to them are near misses
+    struct Synthetic
+    {
+        static constexpr size_t NUM_MAPS = 8;
+
+        std::array<HardwareID, SYNTHETIC_IDS> ids;
+        HostTypeMap maps[NUM_MAPS];
+        std::array<HardwareIDTable::Entry, SYNTHETIC_IDS> table;
+
+        Synthetic()
+        {
+            uint32_t state = 0x9E3779B9;
+            for (size_t i = 0; i < ids.size(); ++i)
+            {
+                bool unique = false;
+                while (!unique)
+                {
+                    state = state * 1664525u + 1013904223u;
+                    ids[i] = { static_cast<uint16_t>(state >> 16), static_cast<uint16_t>(state & 0xFFFE) };
+                    unique = true;
+                    for (size_t j = 0; j < i; ++j)
+                    {
+                        unique &= ids[j].key() != ids[i].key();
+                    }
+                }
+            }
+            constexpr size_t PER_MAP = SYNTHETIC_IDS / NUM_MAPS;
+            for (size_t m = 0; m < NUM_MAPS; ++m)
+            {
+                maps[m] = { &ids[m * PER_MAP], PER_MAP, static_cast<HostDriverType>(m + 1) };
+            }
+            table = HardwareIDTable::build<SYNTHETIC_IDS>(maps);
+        }
+    };
+
+} // namespace hardware_id_tables
+
+#endif // _OGXM_HARDWARE_ID_TABLES_H_
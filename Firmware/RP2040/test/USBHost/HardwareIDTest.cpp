@@ -0,0 +1,66 @@
+#include <cstdint>
+
+#include "Test.h"
+#include "USBHost/HardwareIDTables.h"
+
+//HardwareIDTable::find against the list walk it replaced, every real ID and its neighbours,
+//then the same for a synthetic 2000 ID list
+
+using namespace hardware_id_tables;
+
+template <size_t NumIDs, size_t NumMaps>
+static void check_table(const std::array<HardwareIDTable::Entry, NumIDs>& table, const HostTypeMap (&maps)[NumMaps])
+{
+    uint32_t unsorted = 0;
+    for (size_t i = 1; i < NumIDs; ++i)
+    {
+        unsorted += !(table[i - 1].key < table[i].key);
+    }
+    CHECK_EQ(unsorted, 0u);
+
+    uint32_t wrong = 0;
+    uint32_t mismatches = 0;
+    for (const auto& map : maps)
+    {
+        for (size_t i = 0; i < map.num_ids; ++i)
+        {
+            const HardwareID& ids = map.ids[i];
+            wrong += HardwareIDTable::find(table, ids) != map.type;
+
+            //Keys either side, hits when they're listed too, UNKNOWN otherwise
+            const HardwareID below{ ids.vid, static_cast<uint16_t>(ids.pid - 1) };
+            const HardwareID above{ ids.vid, static_cast<uint16_t>(ids.pid + 1) };
+            mismatches += HardwareIDTable::find(table, below) != find_linear(maps, below);
+            mismatches += HardwareIDTable::find(table, above) != find_linear(maps, above);
+        }
+    }
+    CHECK_EQ(wrong, 0u);
+    CHECK_EQ(mismatches, 0u);
+
+    //Past both ends of the key range
+    CHECK(HardwareIDTable::find(table, { 0x0000, 0x0000 }) == find_linear(maps, { 0x0000, 0x0000 }));
+    CHECK(HardwareIDTable::find(table, { 0xFFFF, 0xFFFF }) == find_linear(maps, { 0xFFFF, 0xFFFF }));
+}
+
+static void test_hardware_id_table()
+{
+    CHECK_EQ(HARDWARE_ID_TABLE.size(), HardwareIDTable::count(HOST_TYPE_MAP));
+    check_table(HARDWARE_ID_TABLE, HOST_TYPE_MAP);
+
+    //Xbox and generic HID devices aren't resolved by VID/PID
+    CHECK(HardwareIDTable::find(HARDWARE_ID_TABLE, { 0x045E, 0x028E }) == HostDriverType::UNKNOWN);
+}
+
+static void test_synthetic_table()
+{
+    static Synthetic synthetic;
+    check_table(synthetic.table, synthetic.maps);
+}
+
+int main()
+{
+    test_hardware_id_table();
+    test_synthetic_table();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,87 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "Test.h"
+#include "UserSettings/NVSTool.h"
+
+//NVSTool against the flash stub, entries fill the NVS sectors in order so keys past the first
+//16 live in the second sector and later
+
+static constexpr uint32_t NVS_START = PICO_FLASH_SIZE_BYTES - NVS_SECTORS * FLASH_SECTOR_SIZE;
+static constexpr uint32_t ENTRIES_PER_SECTOR = FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE;
+
+static std::string key_name(uint32_t i)
+{
+    char key[NVSTool::KEY_LEN_MAX];
+    std::snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i));
+    return key;
+}
+
+static bool read_value(const std::string& key, uint32_t& value)
+{
+    return NVSTool::get_instance().read(key, &value, sizeof(value));
+}
+
+static void test_entries_across_sectors()
+{
+    NVSTool& nvs = NVSTool::get_instance();
+
+    //Entry 0 is the INVALID marker, so this reaches index ENTRIES_PER_SECTOR * 2
+    const uint32_t count = ENTRIES_PER_SECTOR * 2;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t value = 0xA5000000u | i;
+        CHECK(nvs.write(key_name(i), &value, sizeof(value)));
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t value = 0;
+        CHECK(read_value(key_name(i), value));
+        CHECK_EQ(value, 0xA5000000u | i);
+    }
+
+    //Rewriting a key in the second sector keeps its neighbours
+    const uint32_t updated = 0x12345678u;
+    CHECK(nvs.write(key_name(ENTRIES_PER_SECTOR + 3), &updated, sizeof(updated)));
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t value = 0;
+        CHECK(read_value(key_name(i), value));
+        CHECK_EQ(value, (i == ENTRIES_PER_SECTOR + 3) ? updated : (0xA5000000u | i));
+    }
+}
+
+static void test_flash_outside_nvs()
+{
+    //Nothing before the NVS sectors is touched
+    bool untouched = true;
+    for (uint32_t i = NVS_START - FLASH_SECTOR_SIZE; i < NVS_START; ++i)
+    {
+        untouched &= (host_stub::flash[i] == 0xFF);
+    }
+    CHECK(untouched);
+}
+
+static void test_invalid_args()
+{
+    NVSTool& nvs = NVSTool::get_instance();
+    uint32_t value = 0;
+
+    CHECK(!read_value("missing", value));
+    CHECK(!nvs.write("INVALID", &value, sizeof(value)));
+    CHECK(!nvs.write(std::string(NVSTool::KEY_LEN_MAX, 'k'), &value, sizeof(value)));
+
+    uint8_t too_long[NVSTool::VALUE_LEN_MAX + 1]{};
+    CHECK(!nvs.write("key", too_long, sizeof(too_long)));
+}
+
+int main()
+{
+    test_entries_across_sectors();
+    test_flash_outside_nvs();
+    test_invalid_args();
+    return TEST_RESULT();
+}
@@ -0,0 +1,173 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+
+//Stand-in for libFuzzer's driver when the harness is built with g++ (or for AFL, one file per run):
+//  hid_parser_fuzz_replay <file or dir>...                  run every input once
+//  hid_parser_fuzz_replay --mutate N [--seed S] <dir>...    N randomly mutated inputs from the corpus,
+//                                                           a crashing or slow input is saved to crash.bin
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static constexpr double SLOW_INPUT_MS = 50.0;
+
+static std::vector<uint8_t> read_file(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static const std::vector<uint8_t>* current_input = nullptr;
+
+static void save_input(const std::vector<uint8_t>& input)
+{
+    const int fd = open("crash.bin", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0)
+    {
+        ssize_t written = write(fd, input.data(), input.size());
+        (void)written;
+        close(fd);
+    }
+}
+
+static void on_crash(int signal)
+{
+    if (current_input)
+    {
+        save_input(*current_input);
+        static constexpr char MESSAGE[] = "Crashing input saved to crash.bin\n";
+        ssize_t written = write(STDERR_FILENO, MESSAGE, sizeof(MESSAGE) - 1);
+        (void)written;
+    }
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+//Sanitizer reports end the process without a signal, UBSan only does with UBSAN_OPTIONS=halt_on_error=1
+extern "C" void __sanitizer_set_death_callback(void (*callback)(void)) __attribute__((weak));
+
+static void on_sanitizer_death()
+{
+    if (current_input)
+    {
+        save_input(*current_input);
+        std::fprintf(stderr, "Crashing input saved to crash.bin\n");
+    }
+}
+
+//Byte flips, bit flips, inserts, erases, truncation and descriptor-ish magic values
+static void mutate(std::vector<uint8_t>& input, std::mt19937& rng)
+{
+    static constexpr uint8_t MAGIC[] = { 0x00, 0xFF, 0x7F, 0x80, 0xFE, 0xA1, 0xC0, 0x95, 0x75, 0x81, 0x85, 0x27 };
+
+    const uint32_t mutations = 1 + rng() % 8;
+    for (uint32_t m = 0; m < mutations; ++m)
+    {
+        if (input.empty())
+        {
+            input.push_back(static_cast<uint8_t>(rng()));
+            continue;
+        }
+        const size_t pos = rng() % input.size();
+        switch (rng() % 6)
+        {
+            case 0: input[pos] = static_cast<uint8_t>(rng()); break;
+            case 1: input[pos] ^= static_cast<uint8_t>(1 << (rng() % 8)); break;
+            case 2: input.erase(input.begin() + pos); break;
+            case 3: input.insert(input.begin() + pos, static_cast<uint8_t>(rng())); break;
+            case 4: input.resize(pos); break;
+            default: input[pos] = MAGIC[rng() % sizeof(MAGIC)]; break;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t mutate_count = 0;
+    uint32_t seed = 1;
+    std::vector<std::vector<uint8_t>> corpus;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--mutate") == 0 && i + 1 < argc)
+        {
+            mutate_count = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::filesystem::is_directory(argv[i]))
+        {
+            for (const auto& entry : std::filesystem::directory_iterator(argv[i]))
+            {
+                if (entry.is_regular_file())
+                {
+                    corpus.push_back(read_file(entry.path()));
+                }
+            }
+        }
+        else
+        {
+            corpus.push_back(read_file(argv[i]));
+        }
+    }
+
+    if (corpus.empty())
+    {
+        std::printf("No inputs\n");
+        return 1;
+    }
+
+    std::signal(SIGABRT, on_crash);
+    std::signal(SIGSEGV, on_crash);
+    std::signal(SIGFPE, on_crash);
+    std::signal(SIGILL, on_crash);
+    if (__sanitizer_set_death_callback)
+    {
+        __sanitizer_set_death_callback(on_sanitizer_death);
+    }
+
+    for (const auto& input : corpus)
+    {
+        current_input = &input;
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    std::printf("Replayed %zu inputs\n", corpus.size());
+
+    std::mt19937 rng(seed);
+    for (uint64_t i = 0; i < mutate_count; ++i)
+    {
+        std::vector<uint8_t> input = corpus[rng() % corpus.size()];
+        mutate(input, rng);
+        current_input = &input;
+
+        const auto start = std::chrono::steady_clock::now();
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (ms > SLOW_INPUT_MS)
+        {
+            save_input(input);
+            std::printf("Input %llu took %.1f ms, saved to crash.bin\n", static_cast<unsigned long long>(i), ms);
+            return 1;
+        }
+    }
+    current_input = nullptr;
+    if (mutate_count > 0)
+    {
+        std::printf("Ran %llu mutated inputs\n", static_cast<unsigned long long>(mutate_count));
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "USBHost/HIDParser/HIDReportDescriptor.h"
+#include "USBHost/HIDParser/HIDJoystick.h"
+#include "USBHost/HIDParser/HIDRumble.h"
+
+//Everything a plugged in HID device controls: its report descriptor, then the reports it sends.
+//Input layout:
+//  [descriptor length, 16 bit LE][descriptor][report length][report][report length][report]...
+//Lengths are clamped to what's left of the input. Descriptor and reports are copied into buffers
+//of their exact size so the sanitizers see any read past them.
+
+static HIDReportArena arena;
+static HIDJoystick joystick;
+static HIDRumble rumble;
+static HIDJoystickData joystick_data[4];
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    if (size < 2)
+    {
+        return 0;
+    }
+
+    const size_t desc_len = std::min<size_t>(data[0] | (data[1] << 8), std::min<size_t>(size - 2, UINT16_MAX));
+    const std::vector<uint8_t> desc(data + 2, data + 2 + desc_len);
+
+    HIDReportDescriptor descriptor(arena, desc.data(), static_cast<uint16_t>(desc.size()));
+    joystick.compile(descriptor);
+    rumble.compile(descriptor);
+
+    if (rumble.isValid())
+    {
+        if (rumble.getReportLength() + (rumble.getReportId() ? 1 : 0) > MAX_RUMBLE_REPORT_SIZE)
+        {
+            std::abort();
+        }
+        rumble.encode(data[0], data[1]);
+    }
+
+    size_t offset = 2 + desc_len;
+    while (offset < size)
+    {
+        const size_t report_len = std::min<size_t>(data[offset], size - offset - 1);
+        ++offset;
+        std::vector<uint8_t> report(data + offset, data + offset + report_len);
+        offset += report_len;
+
+        const int8_t index = joystick.parseData(report.data(), static_cast<uint16_t>(report.size()), joystick_data, 4);
+        if (index >= 4 || (index >= 0 && joystick_data[index].button_count > MAX_BUTTONS))
+        {
+            std::abort();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#ifndef _LIBFIXMATH_FALLBACK_FIX16_H_
+#define _LIBFIXMATH_FALLBACK_FIX16_H_
+
+//Stand-in for libfixmath when the submodule isn't checked out. Same Q16.16 representation,
+//add/sub/mul/div and conversions round like the library does, the transcendental functions
+//go through double so they're more accurate than FIXMATH_FAST_SIN. Tests that depend on
+//those have to compare against the same backend, not against values from the real library.
+
+#include <cstdint>
+#include <cmath>
+
+typedef int32_t fix16_t;
+
+static const fix16_t fix16_maximum = 0x7FFFFFFF;
+static const fix16_t fix16_minimum = 0x80000000;
+static const fix16_t fix16_overflow = 0x80000000;
+static const fix16_t fix16_pi = 205887;
+static const fix16_t fix16_e = 178145;
+static const fix16_t fix16_one = 0x00010000;
+
+#define F16(x) ((fix16_t)(((x) >= 0) ? ((x) * 65536.0 + 0.5) : ((x) * 65536.0 - 0.5)))
+
+static inline fix16_t fix16_from_int(int a) { return a * fix16_one; }
+static inline float fix16_to_float(fix16_t a) { return static_cast<float>(a) / fix16_one; }
+static inline double fix16_to_dbl(fix16_t a) { return static_cast<double>(a) / fix16_one; }
+
+static inline int fix16_to_int(fix16_t a)
+{
+    return (a >= 0) ? (a + (fix16_one >> 1)) / fix16_one : (a - (fix16_one >> 1)) / fix16_one;
+}
+
+static inline fix16_t fix16_from_float(float a)
+{
+    float temp = a * fix16_one;
+    temp += (temp >= 0) ? 0.5f : -0.5f;
+    return static_cast<fix16_t>(temp);
+}
+
+static inline fix16_t fix16_from_dbl(double a)
+{
+    double temp = a * fix16_one;
+    temp += (temp >= 0) ? 0.5 : -0.5;
+    return static_cast<fix16_t>(temp);
+}
+
+static inline fix16_t fix16_abs(fix16_t x) { return (x < 0) ? -x : x; }
+static inline fix16_t fix16_floor(fix16_t x) { return x & 0xFFFF0000; }
+static inline fix16_t fix16_ceil(fix16_t x) { return (x & 0xFFFF0000) + ((x & 0x0000FFFF) ? fix16_one : 0); }
+static inline fix16_t fix16_min(fix16_t x, fix16_t y) { return (x < y) ? x : y; }
+static inline fix16_t fix16_max(fix16_t x, fix16_t y) { return (x > y) ? x : y; }
+static inline fix16_t fix16_clamp(fix16_t x, fix16_t lo, fix16_t hi) { return fix16_min(fix16_max(x, lo), hi); }
+
+static inline fix16_t fix16_add(fix16_t a, fix16_t b) { return static_cast<fix16_t>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b)); }
+static inline fix16_t fix16_sub(fix16_t a, fix16_t b) { return static_cast<fix16_t>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b)); }
+
+static inline fix16_t fix16_mul(fix16_t a, fix16_t b)
+{
+    const int64_t product = static_cast<int64_t>(a) * b;
+    return static_cast<fix16_t>((product >> 16) + ((product & 0x8000) >> 15));
+}
+
+static inline fix16_t fix16_div(fix16_t a, fix16_t b)
+{
+    if (b == 0)
+    {
+        return fix16_minimum;
+    }
+    return static_cast<fix16_t>(std::llround(static_cast<double>(a) * fix16_one / b));
+}
+
+static inline fix16_t fix16_sq(fix16_t x) { return fix16_mul(x, x); }
+
+static inline fix16_t fix16_sin(fix16_t x) { return fix16_from_dbl(std::sin(fix16_to_dbl(x))); }
+static inline fix16_t fix16_cos(fix16_t x) { return fix16_from_dbl(std::cos(fix16_to_dbl(x))); }
+static inline fix16_t fix16_tan(fix16_t x) { return fix16_from_dbl(std::tan(fix16_to_dbl(x))); }
+static inline fix16_t fix16_atan(fix16_t x) { return fix16_from_dbl(std::atan(fix16_to_dbl(x))); }
+static inline fix16_t fix16_sqrt(fix16_t x) { return fix16_from_dbl(std::sqrt(fix16_to_dbl(x))); }
+static inline fix16_t fix16_exp(fix16_t x) { return fix16_from_dbl(std::exp(fix16_to_dbl(x))); }
+static inline fix16_t fix16_log(fix16_t x) { return fix16_from_dbl(std::log(fix16_to_dbl(x))); }
+
+static inline fix16_t fix16_atan2(fix16_t y, fix16_t x)
+{
+    return fix16_from_dbl(std::atan2(fix16_to_dbl(y), fix16_to_dbl(x)));
+}
+
+static inline fix16_t fix16_rad_to_deg(fix16_t radians) { return fix16_from_dbl(fix16_to_dbl(radians) * 180.0 / M_PI); }
+static inline fix16_t fix16_deg_to_rad(fix16_t degrees) { return fix16_from_dbl(fix16_to_dbl(degrees) * M_PI / 180.0); }
+
+#endif // _LIBFIXMATH_FALLBACK_FIX16_H_
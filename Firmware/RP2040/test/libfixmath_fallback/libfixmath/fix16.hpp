@@ -0,0 +1,73 @@
+#ifndef _LIBFIXMATH_FALLBACK_FIX16_HPP_
+#define _LIBFIXMATH_FALLBACK_FIX16_HPP_
+
+//Same interface as libfixmath's Fix16 class
+
+#include "fix16.h"
+
+class Fix16 
+{
+public:
+    fix16_t value;
+
+    Fix16() { value = 0; }
+    Fix16(const Fix16& inValue) { value = inValue.value; }
+    Fix16(const fix16_t inValue) { value = inValue; }
+    Fix16(const float inValue) { value = fix16_from_float(inValue); }
+    Fix16(const double inValue) { value = fix16_from_dbl(inValue); }
+    Fix16(const int16_t inValue) { value = fix16_from_int(inValue); }
+
+    operator fix16_t() const { return value; }
+    operator double() const { return fix16_to_dbl(value); }
+    operator float() const { return fix16_to_float(value); }
+    operator int16_t() const { return static_cast<int16_t>(fix16_to_int(value)); }
+
+    Fix16& operator=(const Fix16& rhs) { value = rhs.value; return *this; }
+    Fix16& operator=(const fix16_t rhs) { value = rhs; return *this; }
+    Fix16& operator=(const double rhs) { value = fix16_from_dbl(rhs); return *this; }
+    Fix16& operator=(const float rhs) { value = fix16_from_float(rhs); return *this; }
+    Fix16& operator=(const int16_t rhs) { value = fix16_from_int(rhs); return *this; }
+
+#define FIX16_FALLBACK_OPERATOR(op, fn) \
+    Fix16& operator op##=(const Fix16& rhs) { value = fn(value, rhs.value); return *this; } \
+    Fix16& operator op##=(const fix16_t rhs) { value = fn(value, rhs); return *this; } \
+    Fix16& operator op##=(const double rhs) { value = fn(value, fix16_from_dbl(rhs)); return *this; } \
+    Fix16& operator op##=(const float rhs) { value = fn(value, fix16_from_float(rhs)); return *this; } \
+    Fix16& operator op##=(const int16_t rhs) { value = fn(value, fix16_from_int(rhs)); return *this; } \
+    const Fix16 operator op(const Fix16& other) const { Fix16 ret = *this; ret op##= other; return ret; } \
+    const Fix16 operator op(const fix16_t other) const { Fix16 ret = *this; ret op##= other; return ret; } \
+    const Fix16 operator op(const double other) const { Fix16 ret = *this; ret op##= other; return ret; } \
+    const Fix16 operator op(const float other) const { Fix16 ret = *this; ret op##= other; return ret; } \
+    const Fix16 operator op(const int16_t other) const { Fix16 ret = *this; ret op##= other; return ret; }
+
+    FIX16_FALLBACK_OPERATOR(+, fix16_add)
+    FIX16_FALLBACK_OPERATOR(-, fix16_sub)
+    FIX16_FALLBACK_OPERATOR(*, fix16_mul)
+    FIX16_FALLBACK_OPERATOR(/, fix16_div)
+#undef FIX16_FALLBACK_OPERATOR
+
+    const Fix16 operator-() const { return Fix16(-value); }
+
+#define FIX16_FALLBACK_COMPARE(op) \
+    int operator op(const Fix16& other) const { return (value op other.value); } \
+    int operator op(const fix16_t other) const { return (value op other); } \
+    int operator op(const double other) const { return (value op fix16_from_dbl(other)); } \
+    int operator op(const float other) const { return (value op fix16_from_float(other)); } \
+    int operator op(const int16_t other) const { return (value op fix16_from_int(other)); }
+
+    FIX16_FALLBACK_COMPARE(==)
+    FIX16_FALLBACK_COMPARE(!=)
+    FIX16_FALLBACK_COMPARE(<=)
+    FIX16_FALLBACK_COMPARE(>=)
+    FIX16_FALLBACK_COMPARE(<)
+    FIX16_FALLBACK_COMPARE(>)
+#undef FIX16_FALLBACK_COMPARE
+
+    Fix16 sin() const { return Fix16(fix16_sin(value)); }
+    Fix16 cos() const { return Fix16(fix16_cos(value)); }
+    Fix16 tan() const { return Fix16(fix16_tan(value)); }
+    Fix16 atan() const { return Fix16(fix16_atan(value)); }
+    Fix16 sqrt() const { return Fix16(fix16_sqrt(value)); }
+};
+
+#endif // _LIBFIXMATH_FALLBACK_FIX16_HPP_
@@ -0,0 +1,48 @@
+#ifndef _HOST_STUB_HARDWARE_FLASH_H_
+#define _HOST_STUB_HARDWARE_FLASH_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+
+#ifndef PICO_FLASH_SIZE_BYTES
+    #define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+#endif
+
+//Flash is a plain buffer read through XIP_BASE like the real one, erase sets bytes to 0xFF and
+//programming can only clear bits. Offsets outside the flash or off a sector/page boundary abort
+namespace host_stub
+{
+    inline std::vector<uint8_t> flash = std::vector<uint8_t>(PICO_FLASH_SIZE_BYTES, 0xFF);
+}
+
+#define XIP_BASE (reinterpret_cast<uintptr_t>(host_stub::flash.data()))
+
+inline void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flash_offs + count > host_stub::flash.size())
+    {
+        std::abort();
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        host_stub::flash[flash_offs + i] = 0xFF;
+    }
+}
+
+inline void flash_range_program(uint32_t flash_offs, const uint8_t* data, size_t count)
+{
+    if (flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flash_offs + count > host_stub::flash.size())
+    {
+        std::abort();
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        host_stub::flash[flash_offs + i] &= data[i];
+    }
+}
+
+#endif // _HOST_STUB_HARDWARE_FLASH_H_
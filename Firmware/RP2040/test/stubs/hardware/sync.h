@@ -0,0 +1,37 @@
+#ifndef _HOST_STUB_HARDWARE_SYNC_H_
+#define _HOST_STUB_HARDWARE_SYNC_H_
+
+#include <cstdint>
+#include <atomic>
+
+//Spinlocks are real test-and-set locks so the seqlock and queue tests can run across std::threads,
+//there are no interrupts to disable
+typedef unsigned int uint;
+typedef std::atomic<uint32_t> spin_lock_t;
+
+namespace host_stub
+{
+    inline spin_lock_t spin_locks[32];
+    inline std::atomic<uint> next_claimed_spin_lock{0};
+}
+
+inline uint next_striped_spin_lock_num() { return 16; }
+inline int spin_lock_claim_unused(bool) { return static_cast<int>(host_stub::next_claimed_spin_lock++ % 16); }
+inline spin_lock_t* spin_lock_instance(uint lock_num) { return &host_stub::spin_locks[lock_num]; }
+
+inline uint32_t spin_lock_blocking(spin_lock_t* lock) 
+{ 
+    while (lock->exchange(1, std::memory_order_acquire)) {}
+    return 0; 
+}
+
+inline void spin_unlock(spin_lock_t* lock, uint32_t) 
+{ 
+    lock->store(0, std::memory_order_release); 
+}
+
+inline uint32_t save_and_disable_interrupts() { return 0; }
+inline void restore_interrupts(uint32_t) {}
+inline void __dmb() { std::atomic_thread_fence(std::memory_order_seq_cst); }
+
+#endif // _HOST_STUB_HARDWARE_SYNC_H_
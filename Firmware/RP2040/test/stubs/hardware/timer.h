@@ -0,0 +1,7 @@
+#ifndef _HOST_STUB_HARDWARE_TIMER_H_
+#define _HOST_STUB_HARDWARE_TIMER_H_
+
+#include <cstdint>
+#include <pico/time.h>
+
+#endif // _HOST_STUB_HARDWARE_TIMER_H_
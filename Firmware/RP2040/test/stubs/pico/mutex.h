@@ -0,0 +1,15 @@
+#ifndef _HOST_STUB_PICO_MUTEX_H_
+#define _HOST_STUB_PICO_MUTEX_H_
+
+#include <mutex>
+
+struct mutex_t
+{
+    std::recursive_mutex mutex;
+};
+
+inline void mutex_init(mutex_t*) {}
+inline void mutex_enter_blocking(mutex_t* mtx) { mtx->mutex.lock(); }
+inline void mutex_exit(mutex_t* mtx) { mtx->mutex.unlock(); }
+
+#endif // _HOST_STUB_PICO_MUTEX_H_
@@ -0,0 +1,7 @@
+#ifndef _HOST_STUB_PICO_PLATFORM_H_
+#define _HOST_STUB_PICO_PLATFORM_H_
+
+//Plain statics on the host, a test's simulated reboot keeps them like the RP2040 keeps .uninitialized_data
+#define __uninitialized_ram(name) name
+
+#endif // _HOST_STUB_PICO_PLATFORM_H_
@@ -0,0 +1,7 @@
+#ifndef _HOST_STUB_PICO_STDLIB_H_
+#define _HOST_STUB_PICO_STDLIB_H_
+
+#include <pico/time.h>
+#include <hardware/sync.h>
+
+#endif // _HOST_STUB_PICO_STDLIB_H_
@@ -0,0 +1,17 @@
+#ifndef _HOST_STUB_PICO_TIME_H_
+#define _HOST_STUB_PICO_TIME_H_
+
+#include <cstdint>
+
+//Simulated microsecond clock, tests move it by hand
+namespace host_stub
+{
+    inline uint64_t now_us = 0;
+}
+
+inline uint64_t time_us_64() { return host_stub::now_us; }
+inline uint32_t time_us_32() { return static_cast<uint32_t>(host_stub::now_us); }
+inline void sleep_us(uint64_t us) { host_stub::now_us += us; }
+inline void sleep_ms(uint32_t ms) { host_stub::now_us += static_cast<uint64_t>(ms) * 1000; }
+
+#endif // _HOST_STUB_PICO_TIME_H_
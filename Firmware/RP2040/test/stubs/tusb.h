@@ -0,0 +1,35 @@
+#ifndef _HOST_STUB_TUSB_H_
+#define _HOST_STUB_TUSB_H_
+
+#include <cstdint>
+
+//The descriptor constants and transfer result poll_rate uses, values as in TinyUSB's tusb_types.h
+#define TUSB_DIR_IN_MASK 0x80
+
+enum
+{
+    TUSB_DESC_DEVICE = 0x01,
+    TUSB_DESC_CONFIGURATION = 0x02,
+    TUSB_DESC_STRING = 0x03,
+    TUSB_DESC_INTERFACE = 0x04,
+    TUSB_DESC_ENDPOINT = 0x05,
+};
+
+enum
+{
+    TUSB_XFER_CONTROL = 0,
+    TUSB_XFER_ISOCHRONOUS,
+    TUSB_XFER_BULK,
+    TUSB_XFER_INTERRUPT
+};
+
+typedef enum
+{
+    XFER_RESULT_SUCCESS = 0,
+    XFER_RESULT_FAILED,
+    XFER_RESULT_STALLED,
+    XFER_RESULT_TIMEOUT,
+    XFER_RESULT_INVALID
+} xfer_result_t;
+
+#endif // _HOST_STUB_TUSB_H_